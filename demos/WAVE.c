@@ -107,7 +107,7 @@ int main(void)
 
 		// WAVE PCM
 		case MU_WAVE_FORMAT_PCM: {
-			printf("Bits per sample \t- %" PRIu16 "\n", profile.specific_fields.wave_pcm->bits_per_sample);
+			printf("Bits per sample \t- %" PRIu16 "\n", MU_WAVE_PCM_FIELDS(&profile)->bits_per_sample);
 		} break;
 	}
 
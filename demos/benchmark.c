@@ -0,0 +1,352 @@
+/*
+============================================================
+                        DEMO INFO
+
+DEMO NAME:          benchmark.c
+DEMO WRITTEN BY:    muaf contributors
+CREATION DATE:      2026-10-18
+LAST UPDATED:       2026-10-18
+
+============================================================
+                        DEMO PURPOSE
+
+This demo measures how fast muaf is at profiling, reading,
+and writing WAVE files. This is tested by synthesizing WAVE
+files of every supported PCM format across several channel
+counts and sizes, and timing the following for each one:
+
+* Writing the file in blocks with 'mu_write_WAVE_PCM'.
+* Retrieving the file's profile.
+* Reading the whole file sequentially in blocks with a
+  WAVE reader.
+* Reading blocks at random positions with a WAVE reader.
+
+The results are printed as CSV (one line per file) so that
+they can be compared across runs. The first argument, if
+given, is the largest file size to test in bytes (4 MiB by
+default, and up to 3 GiB); the second argument, if given,
+is a filename that the CSV is written to instead.
+
+This demo is dependent on the folder 'output' existing
+within the executing directory of the program, in which
+each synthesized file is temporarily stored.
+
+============================================================
+                        LICENSE INFO
+
+All code is licensed under MIT License or public domain,
+whichever you prefer.
+More explicit license information at the end of file.
+
+============================================================
+*/
+
+/* Including */
+
+	// For a monotonic clock and positional reads on POSIX systems:
+	#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+		#define _POSIX_C_SOURCE 200809L
+	#endif
+
+	// Include muAudioFile
+	#define MUAF_NAMES
+	#define MUAF_IMPLEMENTATION
+	#include "muAudioFile.h"
+
+	// For printing:
+	#include <stdio.h>
+	// For allocation and parsing arguments:
+	#include <stdlib.h>
+	// For timing:
+	#ifdef _WIN32
+		#include <windows.h>
+	#else
+		#include <time.h>
+	#endif
+
+/* Settings */
+
+	// Temporary file each benchmark is run on
+	#define BENCH_FILENAME "output/benchmark.wav"
+
+	// Amount of frames per read/write block
+	#define BENCH_BLOCK_FRAMES 65536
+	// Amount of frames per random read
+	#define BENCH_RANDOM_FRAMES 1024
+	// Amount of random reads per file
+	#define BENCH_RANDOM_READS 256
+	// Amount of times the profile is retrieved per file
+	#define BENCH_PROFILE_RUNS 64
+
+	// Formats tested
+	muafAudioFormat formats[] = {
+		MUAF_FORMAT_PCM_U8, MUAF_FORMAT_PCM_S16, MUAF_FORMAT_PCM_S24, MUAF_FORMAT_PCM_S32, MUAF_FORMAT_PCM_S64
+	};
+	// Channel counts tested
+	uint16_m channel_counts[] = { 1, 2, 8, 64 };
+	// File sizes tested (in bytes of audio data)
+	uint64_m sizes[] = {
+		4096,                 // 4 KiB
+		65536,                // 64 KiB
+		1048576,              // 1 MiB
+		4194304,              // 4 MiB
+		67108864,             // 64 MiB
+		1073741824,           // 1 GiB
+		3221225472            // 3 GiB
+	};
+
+/* Timing */
+
+	// Returns the current time in seconds
+	double bench_time(void) {
+		#ifdef _WIN32
+			LARGE_INTEGER freq, count;
+			QueryPerformanceFrequency(&freq);
+			QueryPerformanceCounter(&count);
+			return ((double)count.QuadPart) / ((double)freq.QuadPart);
+		#else
+			struct timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return ((double)ts.tv_sec) + (((double)ts.tv_nsec) / 1000000000.0);
+		#endif
+	}
+
+	// Returns megabytes per second
+	double bench_mbps(uint64_m bytes, double seconds) {
+		if (seconds <= 0.0) {
+			return 0.0;
+		}
+		return (((double)bytes) / 1048576.0) / seconds;
+	}
+
+/* Synthesizing */
+
+	// Simple deterministic random number generator
+	uint32_m rng_state = 0x12345678;
+	uint32_m bench_rand(void) {
+		rng_state = rng_state * 1664525 + 1013904223;
+		return rng_state;
+	}
+
+	// Fills a block with noise
+	void bench_fill(muByte* data, size_m len) {
+		for (size_m i = 0; i < len; ++i) {
+			data[i] = (muByte)(bench_rand() >> 24);
+		}
+	}
+
+/* Benchmark */
+
+	// Result of a single benchmark
+	typedef struct {
+		uint64_m bytes;
+		double write_mbps;
+		double profile_us;
+		double seq_read_mbps;
+		double random_read_mbps;
+	} bench_result;
+
+	// Benchmarks one file; returns the result of the first failing call
+	muafResult bench_file(muafAudioFormat format, uint16_m channels, uint32_m num_frames, muByte* block, bench_result* result) {
+		// (Frames are held in memory at 'frame_size' bytes each, but rates are measured in the
+		// bytes that the file actually stores, which is smaller for formats like 24-bit PCM)
+		size_m frame_size = muaf_audio_format_sample_size(format) * ((size_m)channels);
+
+		// Create the file
+		muWAVEWrapper wrapper;
+		wrapper.audio_format = format;
+		wrapper.num_frames = num_frames;
+		wrapper.num_channels = channels;
+		wrapper.sample_rate = 48000;
+		muafResult res = mu_create_WAVE_wrapper(BENCH_FILENAME, &wrapper);
+		if (muaf_result_is_fatal(res)) {
+			return res;
+		}
+
+		// Write it in blocks
+		// (Writing converts the block in place, so it's refilled each time outside of the timing)
+		double write_time = 0.0;
+		for (uint32_m f = 0; f < num_frames; f += BENCH_BLOCK_FRAMES) {
+			uint32_m len = (num_frames - f < BENCH_BLOCK_FRAMES) ? (num_frames - f) : BENCH_BLOCK_FRAMES;
+			bench_fill(block, len * frame_size);
+
+			double beg = bench_time();
+			res = mu_write_WAVE_PCM(BENCH_FILENAME, &wrapper, f, len, block);
+			write_time += bench_time() - beg;
+			if (muaf_result_is_fatal(res)) {
+				mu_free_WAVE_wrapper(&wrapper);
+				return res;
+			}
+		}
+		mu_free_WAVE_wrapper(&wrapper);
+
+		// Profile it
+		muWAVEProfile profile;
+		double beg = bench_time();
+		for (int i = 0; i < BENCH_PROFILE_RUNS; ++i) {
+			res = mu_get_WAVE_profile(BENCH_FILENAME, &profile);
+			if (muaf_result_is_fatal(res)) {
+				return res;
+			}
+			if (i != BENCH_PROFILE_RUNS-1) {
+				mu_free_WAVE_profile(&profile);
+			}
+		}
+		result->profile_us = ((bench_time() - beg) / BENCH_PROFILE_RUNS) * 1000000.0;
+
+		uint64_m file_bytes = profile.chunks.wave_len;
+		size_m stored_frame_size = profile.block_align;
+		result->bytes = file_bytes;
+		result->write_mbps = bench_mbps(file_bytes, write_time);
+
+		// Open a reader for it
+		muWAVEReader* reader;
+		res = mu_open_WAVE_reader(BENCH_FILENAME, &profile, &reader);
+		mu_free_WAVE_profile(&profile);
+		if (muaf_result_is_fatal(res)) {
+			return res;
+		}
+
+		// Read it sequentially
+		beg = bench_time();
+		for (uint32_m f = 0; f < num_frames; f += BENCH_BLOCK_FRAMES) {
+			uint32_m len = (num_frames - f < BENCH_BLOCK_FRAMES) ? (num_frames - f) : BENCH_BLOCK_FRAMES;
+			res = mu_read_WAVE_reader(reader, f, len, block);
+			if (muaf_result_is_fatal(res)) {
+				mu_close_WAVE_reader(reader);
+				return res;
+			}
+		}
+		result->seq_read_mbps = bench_mbps(file_bytes, bench_time() - beg);
+
+		// Read it at random positions
+		uint32_m random_len = (num_frames < BENCH_RANDOM_FRAMES) ? num_frames : BENCH_RANDOM_FRAMES;
+		beg = bench_time();
+		for (int i = 0; i < BENCH_RANDOM_READS; ++i) {
+			uint32_m f = bench_rand() % (num_frames - random_len + 1);
+			res = mu_read_WAVE_reader(reader, f, random_len, block);
+			if (muaf_result_is_fatal(res)) {
+				mu_close_WAVE_reader(reader);
+				return res;
+			}
+		}
+		result->random_read_mbps = bench_mbps(((uint64_m)random_len) * stored_frame_size * BENCH_RANDOM_READS, bench_time() - beg);
+
+		mu_close_WAVE_reader(reader);
+		return MUAF_SUCCESS;
+	}
+
+int main(int argc, char** argv)
+{
+	// Parse arguments
+	uint64_m max_size = 4194304;
+	if (argc > 1) {
+		max_size = (uint64_m)strtoull(argv[1], 0, 10);
+	}
+	FILE* out = stdout;
+	if (argc > 2) {
+		out = fopen(argv[2], "w");
+		if (!out) {
+			printf("Failed to open '%s'; exiting\n", argv[2]);
+			return -1;
+		}
+	}
+
+	// Allocate block for largest frame size
+	muByte* block = (muByte*)malloc(((size_m)BENCH_BLOCK_FRAMES) * 8 * 64);
+	if (!block) {
+		printf("Failed to allocate block; exiting\n");
+		if (out != stdout) fclose(out);
+		return -1;
+	}
+
+	// Run every combination
+	int failed = 0;
+	fprintf(out, "format,channels,frames,bytes,write_mbps,profile_us,seq_read_mbps,random_read_mbps\n");
+	for (size_m s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		if (sizes[s] > max_size) {
+			break;
+		}
+		for (size_m fi = 0; fi < sizeof(formats) / sizeof(formats[0]); ++fi) {
+			for (size_m c = 0; c < sizeof(channel_counts) / sizeof(channel_counts[0]); ++c) {
+				// Skip if not even one frame fits
+				size_m frame_size = muaf_audio_format_sample_size(formats[fi]) * ((size_m)channel_counts[c]);
+				uint32_m num_frames = (uint32_m)(sizes[s] / frame_size);
+				if (num_frames == 0) {
+					continue;
+				}
+
+				bench_result result;
+				muafResult res = bench_file(formats[fi], channel_counts[c], num_frames, block, &result);
+				if (muaf_result_is_fatal(res)) {
+					printf("%s, %u channels, %u frames failed - %s\n", muaf_audio_format_get_name(formats[fi]), (unsigned)channel_counts[c], (unsigned)num_frames, muaf_result_get_name(res));
+					failed = 1;
+					continue;
+				}
+
+				fprintf(out, "%s,%u,%u,%llu,%.2f,%.2f,%.2f,%.2f\n",
+					muaf_audio_format_get_name(formats[fi]), (unsigned)channel_counts[c], (unsigned)num_frames,
+					(unsigned long long)result.bytes,
+					result.write_mbps, result.profile_us, result.seq_read_mbps, result.random_read_mbps
+				);
+				fflush(out);
+			}
+		}
+	}
+
+	// Clean up
+	remove(BENCH_FILENAME);
+	free(block);
+	if (out != stdout) {
+		fclose(out);
+	}
+
+	if (failed) {
+		printf("\nSome benchmarks failed\n");
+		return -1;
+	}
+	printf("\nSuccessful\n");
+	return 0;
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2026 muaf contributors
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
@@ -982,6 +982,293 @@ Overall, muaf is okay with files not strictly complying with the specification w
 			// @DOCLINE The macro function `MUAF_FORMAT_IS_PCM` takes in a format, and forms an expression that represents whether or not the given format is a PCM format, defined below: @NLNT
 			#define MUAF_FORMAT_IS_PCM(format) (format >= MUAF_FORMAT_PCM_U8 && format <= MUAF_FORMAT_PCM_S64)
 
+	// @DOCLINE # Multithreading
+
+		// @DOCLINE muaf does not create or manage any threads itself, and has no global state. Any function can be called from multiple threads at once, as long as no object (such as a profile, wrapper, or stream) is being modified by one thread while it is being used by another. Already-loaded profiles can be used by multiple threads at once for reading audio data, since reading does not modify them. Objects that are meant to be shared between threads state how they can be used across threads in their own documentation.
+
+		// @DOCLINE ## Atomic operations
+
+			// @DOCLINE Objects in muaf that are shared between threads synchronize using the following macros, all of which operate on `size_m` values:
+
+			// @DOCLINE * `MUAF_ATOMIC_LOAD(ptr)` - atomically loads the value at `ptr` with acquire semantics.
+			// @DOCLINE * `MUAF_ATOMIC_STORE(ptr, val)` - atomically stores `val` at `ptr` with release semantics.
+			// @DOCLINE * `MUAF_ATOMIC_ADD(ptr, val)` - atomically adds `val` to the value at `ptr`, returning the value from before the addition, with acquire and release semantics.
+
+			// @DOCLINE By default, they use the `__atomic` builtins on GCC and Clang, and the MSVC intrinsics (along with volatile access with compiler barriers, which is only guaranteed to behave correctly on x86 and x64) on MSVC. All three macros are overridable, and must be overridden for compilers that don't fit these categories if multithreading is used.
+			#if !defined(MUAF_ATOMIC_LOAD) || !defined(MUAF_ATOMIC_STORE) || !defined(MUAF_ATOMIC_ADD)
+				#if defined(__GNUC__) || defined(__clang__)
+					#define MUAF_ATOMIC_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+					#define MUAF_ATOMIC_STORE(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+					#define MUAF_ATOMIC_ADD(ptr, val) __atomic_fetch_add(ptr, val, __ATOMIC_ACQ_REL)
+				#elif defined(_MSC_VER)
+					#include <intrin.h>
+					MUDEF inline size_m muaf_atomic_load(volatile size_m* ptr) {
+						size_m val = *ptr;
+						_ReadWriteBarrier();
+						return val;
+					}
+					MUDEF inline void muaf_atomic_store(volatile size_m* ptr, size_m val) {
+						_ReadWriteBarrier();
+						*ptr = val;
+					}
+					MUDEF inline size_m muaf_atomic_add(volatile size_m* ptr, size_m val) {
+						#ifdef _WIN64
+							return (size_m)_InterlockedExchangeAdd64((volatile __int64*)ptr, (__int64)val);
+						#else
+							return (size_m)_InterlockedExchangeAdd((volatile long*)ptr, (long)val);
+						#endif
+					}
+					#define MUAF_ATOMIC_LOAD(ptr) muaf_atomic_load(ptr)
+					#define MUAF_ATOMIC_STORE(ptr, val) muaf_atomic_store(ptr, val)
+					#define MUAF_ATOMIC_ADD(ptr, val) muaf_atomic_add(ptr, val)
+				#else
+					#define MUAF_ATOMIC_LOAD(ptr) (*(volatile size_m*)(ptr))
+					#define MUAF_ATOMIC_STORE(ptr, val) (*(volatile size_m*)(ptr) = (val))
+					#define MUAF_ATOMIC_ADD(ptr, val) ((*(volatile size_m*)(ptr) += (val)) - (val))
+				#endif
+			#endif
+
+			// @DOCLINE Values that can outgrow a 32-bit `size_m` (such as [instrumentation](#instrumentation) times) are instead added to with `MUAF_ATOMIC_ADD64(ptr, val)`, which atomically adds `val` to the `uint64_m` value at `ptr`, and doesn't return anything. It's overridable separately from the other three, and by default uses the `__atomic` builtins on GCC and Clang (which may require linking with `libatomic` on some 32-bit platforms), `_InterlockedExchangeAdd64` on MSVC, and a plain, non-atomic addition otherwise.
+			#ifndef MUAF_ATOMIC_ADD64
+				#if defined(__GNUC__) || defined(__clang__)
+					#define MUAF_ATOMIC_ADD64(ptr, val) ((void)__atomic_fetch_add(ptr, (uint64_m)(val), __ATOMIC_ACQ_REL))
+				#elif defined(_MSC_VER)
+					#define MUAF_ATOMIC_ADD64(ptr, val) ((void)_InterlockedExchangeAdd64((volatile __int64*)(ptr), (__int64)(val)))
+				#else
+					#define MUAF_ATOMIC_ADD64(ptr, val) ((void)(*(volatile uint64_m*)(ptr) += (uint64_m)(val)))
+				#endif
+			#endif
+
+			// @DOCLINE Such values are loaded with `MUAF_ATOMIC_LOAD64(ptr)`, which atomically loads the `uint64_m` value at `ptr` with acquire semantics, and is overridable and defined in the same way.
+			#ifndef MUAF_ATOMIC_LOAD64
+				#if defined(__GNUC__) || defined(__clang__)
+					#define MUAF_ATOMIC_LOAD64(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+				#elif defined(_MSC_VER)
+					#define MUAF_ATOMIC_LOAD64(ptr) ((uint64_m)_InterlockedCompareExchange64((volatile __int64*)(ptr), 0, 0))
+				#else
+					#define MUAF_ATOMIC_LOAD64(ptr) (*(volatile uint64_m*)(ptr))
+				#endif
+			#endif
+
+	// @DOCLINE # Allocators
+
+		// @DOCLINE By default, muaf allocates memory using the [`stdlib.h` dependencies](#stdlibh-dependencies), which are fixed at compile time. Functions that allocate memory which outlives the call (such as retrieving a profile or opening a reader) have a variant that takes an allocator instead, which is used for all of the memory belonging to the returned object.
+
+		// @DOCLINE ## Allocator
+
+			typedef struct muafAllocator muafAllocator;
+
+			// @DOCLINE The struct `muafAllocator` represents an allocator, and has the following members:
+			struct muafAllocator {
+				// @DOCLINE * `void* (*alloc)(void* user, size_m size)` - allocates `size` bytes, returning 0 on failure; equivalent to `malloc`.
+				void* (*alloc)(void* user, size_m size);
+				// @DOCLINE * `void* (*realloc)(void* user, void* ptr, size_m size)` - reallocates the memory at `ptr` to be `size` bytes, returning 0 on failure (in which case `ptr` is left as-is); equivalent to `realloc`.
+				void* (*realloc)(void* user, void* ptr, size_m size);
+				// @DOCLINE * `void (*free)(void* user, void* ptr)` - frees the memory at `ptr`; equivalent to `free`.
+				void (*free)(void* user, void* ptr);
+				// @DOCLINE * `@NLFT* user` - the pointer passed to each of the functions above.
+				void* user;
+			};
+
+			// @DOCLINE Functions that take a `const muafAllocator*` use the [`stdlib.h` dependencies](#stdlibh-dependencies) if it is 0. The same allocator (by value) must be given when freeing an object as when it was created. An allocator used by multiple threads at once must be thread-safe.
+
+		// @DOCLINE ## Arenas
+
+			typedef struct muafArena muafArena;
+
+			// @DOCLINE An arena is an allocator that hands out memory from large blocks, so that many small allocations (such as the memory of many profiles) are cheap, and can all be freed at once. The type `muafArena` is an opaque struct representing an arena. An arena can be created with the function `mu_create_arena`, defined below: @NLNT
+			MUDEF muafResult mu_create_arena(size_m block_size, muafArena** arena);
+
+			// @DOCLINE `block_size` is the size of each block allocated by the arena, with 0 meaning `MUAF_ARENA_BLOCK_SIZE`, an overridable macro defined as 65536 by default. Allocations larger than a block are given a block of their own. Once created successfully, the arena must be destroyed at some point using the function `mu_destroy_arena`, defined below: @NLNT
+			MUDEF void mu_destroy_arena(muafArena* arena);
+			#ifndef MUAF_ARENA_BLOCK_SIZE
+				#define MUAF_ARENA_BLOCK_SIZE 65536
+			#endif
+
+			// @DOCLINE The function `mu_get_arena_allocator` returns an allocator that allocates from an arena, defined below: @NLNT
+			MUDEF muafAllocator mu_get_arena_allocator(muafArena* arena);
+
+			// @DOCLINE Freeing memory from an arena does nothing unless it is the most recent allocation. Instead, everything allocated from an arena is freed at once with the function `mu_reset_arena`, defined below: @NLNT
+			MUDEF void mu_reset_arena(muafArena* arena);
+
+			// @DOCLINE The arena's blocks are kept after a reset and reused for the allocations that follow, so an arena reset between batches of work stops allocating blocks after the first batch. Any object allocated from the arena must not be used once it's reset, and doesn't need to be freed. Every allocation is aligned to `MUAF_ARENA_ALIGNMENT` bytes, an overridable macro defined as 16 by default, which must be a power of 2 of at least `sizeof(size_m)`.
+			#ifndef MUAF_ARENA_ALIGNMENT
+				#define MUAF_ARENA_ALIGNMENT 16
+			#endif
+
+			// @DOCLINE An arena is not thread-safe, and must not be allocated from by multiple threads at once.
+
+	// @DOCLINE # Instrumentation
+
+		// @DOCLINE muaf can count the file operations it performs and time each phase of its work, which is only compiled in if `MUAF_INSTRUMENTATION` is defined. If it isn't, nothing in this section is defined, and muaf has no overhead from it.
+
+		#ifdef MUAF_INSTRUMENTATION
+
+		// @DOCLINE ## Phases
+
+			typedef uint8_m muafPhase;
+
+			// @DOCLINE The type `muafPhase` (typedef for `uint8_m`) represents a phase of muaf's work that's timed. Phases can occur within other phases; for example, `MUAF_PHASE_READ` occurs within `MUAF_PHASE_WAVE_READ_PCM`, and the difference between their times is the time spent converting the audio data. It has the following defined values:
+
+			// @DOCLINE * `MUAF_PHASE_OPEN` - opening a file.
+			#define MUAF_PHASE_OPEN 0
+			// @DOCLINE * `MUAF_PHASE_READ` - reading data from a file.
+			#define MUAF_PHASE_READ 1
+			// @DOCLINE * `MUAF_PHASE_WRITE` - writing data to a file.
+			#define MUAF_PHASE_WRITE 2
+			// @DOCLINE * `MUAF_PHASE_WAVE_CHUNKS` - finding the chunks of a WAVE file when retrieving its profile.
+			#define MUAF_PHASE_WAVE_CHUNKS 3
+			// @DOCLINE * `MUAF_PHASE_WAVE_FMT` - parsing the fmt chunk of a WAVE file when retrieving its profile.
+			#define MUAF_PHASE_WAVE_FMT 4
+			// @DOCLINE * `MUAF_PHASE_WAVE_READ_PCM` - reading and converting audio data in [`mu_read_WAVE_PCM`](#read-pcm-wave-data).
+			#define MUAF_PHASE_WAVE_READ_PCM 5
+			// @DOCLINE * `MUAF_PHASE_WAVE_WRITE_PCM` - converting and writing audio data in [`mu_write_WAVE_PCM`](#write-pcm-wave-data).
+			#define MUAF_PHASE_WAVE_WRITE_PCM 6
+			// @DOCLINE * `MUAF_PHASE_FLAC_STREAMINFO` - parsing the streaminfo metadata block of a FLAC file when retrieving its profile.
+			#define MUAF_PHASE_FLAC_STREAMINFO 7
+			// @DOCLINE * `MUAF_PHASE_FLAC_METADATA` - parsing the rest of the metadata blocks of a FLAC file when retrieving its profile.
+			#define MUAF_PHASE_FLAC_METADATA 8
+
+			// @DOCLINE The macro `MUAF_PHASE_COUNT` is defined as the amount of phases.
+			#define MUAF_PHASE_COUNT 9
+
+		// @DOCLINE ## Instrumentation statistics
+
+			typedef struct muafStats muafStats;
+
+			// @DOCLINE The struct `muafStats` represents the statistics collected by instrumentation, and has the following members:
+			struct muafStats {
+				// @DOCLINE * `@NLFT open_count` - the amount of files opened.
+				size_m open_count;
+				// @DOCLINE * `@NLFT seek_count` - the amount of seeks performed on files.
+				size_m seek_count;
+				// @DOCLINE * `@NLFT read_count` - the amount of reads performed on files.
+				size_m read_count;
+				// @DOCLINE * `@NLFT read_bytes` - the amount of bytes read from files.
+				uint64_m read_bytes;
+				// @DOCLINE * `@NLFT write_count` - the amount of writes performed on files.
+				size_m write_count;
+				// @DOCLINE * `@NLFT write_bytes` - the amount of bytes written to files.
+				uint64_m write_bytes;
+				// @DOCLINE * `size_m phase_count[MUAF_PHASE_COUNT]` - the amount of times each phase has been performed, indexed by phase.
+				size_m phase_count[MUAF_PHASE_COUNT];
+				// @DOCLINE * `uint64_m phase_time[MUAF_PHASE_COUNT]` - the total time spent in each phase, in nanoseconds, indexed by phase.
+				uint64_m phase_time[MUAF_PHASE_COUNT];
+			};
+
+			// @DOCLINE Reads and writes include positional reads and writes, as well as reads and writes performed through the Windows API. Copies performed by the kernel (such as with [`copy_file_range`](#positional-reading-dependencies)) are not counted. Byte amounts and times are `uint64_m`, so they don't wrap around on 32-bit systems during long runs; they're added to with `MUAF_ATOMIC_ADD64`, which is only atomic on the compilers listed under [atomic operations](#atomic-operations).
+
+		// @DOCLINE ## Setting instrumentation
+
+			typedef struct muafInstrumentation muafInstrumentation;
+			typedef void (*muafPhaseCallback)(void* user, muafPhase phase, muBool end, uint64_m time);
+
+			// @DOCLINE The struct `muafInstrumentation` represents instrumentation, and has the following members:
+			struct muafInstrumentation {
+				// @DOCLINE * `@NLFT stats` - the statistics collected so far, which should be zeroed before the instrumentation is used.
+				muafStats stats;
+				// @DOCLINE * `@NLFT callback` - a function called at the beginning and end of each phase, with `user`, the phase, whether or not this is the end of the phase, and the current time in nanoseconds; can be 0.
+				muafPhaseCallback callback;
+				// @DOCLINE * `@NLFT* user` - the pointer passed to `callback`.
+				void* user;
+			};
+
+			// @DOCLINE The function `mu_set_instrumentation` sets the instrumentation that muaf records to, defined below: @NLNT
+			MUDEF void mu_set_instrumentation(muafInstrumentation* instrumentation);
+
+			// @DOCLINE The instrumentation can be 0, in which case nothing is recorded (which is the default). The given instrumentation is used by every thread, being the only global state in muaf, and must stay valid until a different instrumentation is set. It should be set before any other muaf function is called by other threads. Statistics are updated using [atomic operations](#atomic-operations), so they can be read by any thread; the callback can be called by multiple threads at once.
+
+			// @DOCLINE The time is retrieved by the macro `MUAF_INSTRUMENTATION_TIME()`, which returns the current time in nanoseconds as a `uint64_m`. It's overridable, and by default uses `timespec_get` on C11 and C++17 and `clock` otherwise (which only measures the processor time of the program), both from `time.h`.
+
+		// @DOCLINE ## Phase names
+
+			#ifdef MUAF_NAMES
+
+			// @DOCLINE The name function `muaf_phase_get_name` returns a `const char*` representation of a given phase (for example, `MUAF_PHASE_OPEN` returns "MUAF_PHASE_OPEN"), defined below: @NLNT
+			MUDEF const char* muaf_phase_get_name(muafPhase phase);
+
+			// @DOCLINE This function returns "MUAF_PHASE_UNKNOWN" in the case that `phase` is an unrecognized value.
+			// @DOCLINE > This function is a "name" function, and therefore is only defined if `MUAF_NAMES` is also defined.
+
+			#endif
+
+		#endif
+
+	// @DOCLINE # Page cache
+
+		// @DOCLINE When a file is read or written, the operating system normally keeps its data in memory (the page cache) in case it's used again. For large files that are read or written once from start to finish (such as when converting or capturing long recordings), this evicts data that's more likely to be used again, and copies every byte through memory an extra time. [WAVE readers](#wave-readers) and [WAVE writers](#wave-writers) can be told to avoid the page cache using a cache mode.
+
+		// @DOCLINE ## Cache modes
+
+			typedef uint8_m muafCacheMode;
+
+			// @DOCLINE The type `muafCacheMode` (typedef for `uint8_m`) represents how a file uses the page cache. It has the following defined values:
+
+			// @DOCLINE * `MUAF_CACHE_NORMAL` - the file uses the page cache normally, which is the default.
+			#define MUAF_CACHE_NORMAL 0
+			// @DOCLINE * `MUAF_CACHE_DROP` - the file's data is read and written through the page cache, but dropped from it once it's been read or written back to disk, using `posix_fadvise` with `POSIX_FADV_DONTNEED`.
+			#define MUAF_CACHE_DROP 1
+			// @DOCLINE * `MUAF_CACHE_DIRECT` - the file's data is read and written directly between the disk and memory, bypassing the page cache, using `O_DIRECT`.
+			#define MUAF_CACHE_DIRECT 2
+
+			// @DOCLINE Cache modes are only supported on Linux with [positional reads](#positional-reading-dependencies). If a mode isn't supported, the next mode down is used instead (so `MUAF_CACHE_DIRECT` falls back to `MUAF_CACHE_DROP`, such as on filesystems that don't support `O_DIRECT`, and `MUAF_CACHE_DROP` falls back to `MUAF_CACHE_NORMAL`), and the functions setting a cache mode report which one was used.
+
+		// @DOCLINE ## Direct I/O alignment
+
+			// @DOCLINE `O_DIRECT` requires the file offset, length, and memory of every read and write to be aligned to the filesystem's block size, which audio data almost never is (the WAVE wave-data chunk usually starts 44 bytes into the file, and reads and writes can be any amount of frames). muaf handles this internally: every read and write is widened to `MUAF_DIRECT_ALIGNMENT` bytes, an overridable macro defined as 4096 by default, which must be a power of 2 of at least the filesystem's block size, and passes through an aligned buffer of at most `MUAF_DIRECT_BLOCK_SIZE` bytes, an overridable macro defined as 1048576 by default, which must be a multiple of `MUAF_DIRECT_ALIGNMENT`.
+			#ifndef MUAF_DIRECT_ALIGNMENT
+				#define MUAF_DIRECT_ALIGNMENT 4096
+			#endif
+			#ifndef MUAF_DIRECT_BLOCK_SIZE
+				#define MUAF_DIRECT_BLOCK_SIZE 1048576
+			#endif
+
+			// @DOCLINE Reads only copy the requested bytes out of the aligned buffer. Writes that don't cover whole aligned blocks first read the blocks at their edges so that the surrounding bytes (such as the WAVE headers) are written back unchanged, and if the last block extends past the end of the file, the file is truncated back to its real length afterwards. This makes direct I/O worth it only for large reads and writes; for small ones (such as a writer without a [buffer](#wave-writer-buffers)), the extra reads and block-sized writes cost more than the page cache does.
+
+	// @DOCLINE # Resampling
+
+		// @DOCLINE muaf can convert audio data to a different sample rate while reading it, using a polyphase windowed-sinc filter. This section covers the resample filters used to do this; the functions that read resampled audio data are described in the API of each audio file format that supports it.
+
+		// @DOCLINE ## Resample quality
+
+			typedef uint8_m muResampleQuality;
+
+			// @DOCLINE The type `muResampleQuality` (typedef for `uint8_m`) represents a resample filter's quality preset, which trades speed for how well the filter removes aliasing and how much of the high frequencies it keeps. It has the following defined values:
+
+			// @DOCLINE * `MUAF_RESAMPLE_QUALITY_LOW` - 16 taps with a passband up to 85% of the lower Nyquist frequency; fastest, meant for previews.
+			#define MUAF_RESAMPLE_QUALITY_LOW 0
+			// @DOCLINE * `MUAF_RESAMPLE_QUALITY_MEDIUM` - 32 taps with a passband up to 91% of the lower Nyquist frequency.
+			#define MUAF_RESAMPLE_QUALITY_MEDIUM 1
+			// @DOCLINE * `MUAF_RESAMPLE_QUALITY_HIGH` - 64 taps with a passband up to 95% of the lower Nyquist frequency; slowest, meant for final output.
+			#define MUAF_RESAMPLE_QUALITY_HIGH 2
+
+			// @DOCLINE The amount of taps listed for each preset is for upsampling; when downsampling, the amount of taps is scaled up by the conversion ratio (capped at `MUAF_RESAMPLE_MAX_TAPS`, an overridable macro defined as 1024 by default) so that the filter's cutoff can be lowered without worsening its quality.
+			#ifndef MUAF_RESAMPLE_MAX_TAPS
+				#define MUAF_RESAMPLE_MAX_TAPS 1024
+			#endif
+
+		// @DOCLINE ## Resample filters
+
+			typedef struct muResampleFilter muResampleFilter;
+
+			// @DOCLINE The type `muResampleFilter` is an opaque struct representing a resample filter, which holds the precomputed filter bank for converting audio data from one sample rate to another. A resample filter can be created with the function `mu_create_resample_filter`, defined below: @NLNT
+			MUDEF muafResult mu_create_resample_filter(uint32_m src_rate, uint32_m dst_rate, muResampleQuality quality, muResampleFilter** filter);
+
+			// @DOCLINE `src_rate` is the sample rate being converted from, and `dst_rate` is the sample rate being converted to; if either of them are 0, `MUAF_INVALID_RESAMPLE_RATE` is returned. Once created successfully, the filter must be destroyed at some point using the function `mu_destroy_resample_filter`, defined below: @NLNT
+			MUDEF void mu_destroy_resample_filter(muResampleFilter* filter);
+
+			// @DOCLINE The filter bank holds one set of taps for each phase, with the conversion ratio reduced to its simplest form; if this form needs more than `MUAF_RESAMPLE_MAX_PHASES` phases (an overridable macro defined as 1024 by default), phases in between are interpolated linearly. Computing a filter bank is far slower than using it, so a filter should be created once for each pair of sample rates and reused for every read of every file with that pair. A filter is never modified after it's created, so it can be used by any amount of threads at once.
+			#ifndef MUAF_RESAMPLE_MAX_PHASES
+				#define MUAF_RESAMPLE_MAX_PHASES 1024
+			#endif
+
+		// @DOCLINE ## Resampled frame count
+
+			// @DOCLINE The function `mu_resampled_frame_count` returns the amount of frames that audio data with the given amount of frames has once resampled with the given filter, defined below: @NLNT
+			MUDEF uint32_m mu_resampled_frame_count(muResampleFilter* filter, uint32_m frame_count);
+
+			// @DOCLINE The result is rounded up, and is capped at 0xFFFFFFFF.
+
 	// @DOCLINE # WAVE API
 
 		// @DOCLINE This section describes muaf's API for the [Waveform Audio File Format](https://en.wikipedia.org/wiki/WAV), or WAVE. The code for this API is built based off of the original August 1991 specification for WAVE (specifically [this archive](https://www.mmsp.ece.mcgill.ca/Documents/AudioFormats/WAVE/Docs/riffmci.pdf)), and this section of muaf's documentation will reference concepts that are defined in this specification.
@@ -999,6 +1286,121 @@ Overall, muaf is okay with files not strictly complying with the specification w
 
 				// @DOCLINE The given and already loaded [WAVE profile](#wave-profile) must have a [supported audio format](#audio-formats), and said audio format [must be PCM](#is-audio-format-pcm). The given frame range must be valid for the given WAVE file, and the given data must be large enough to hold the requested amount of frames in the audio format's corresponding type.
 
+			// @DOCLINE ### Read PCM WAVE channels
+
+				// @DOCLINE The function `mu_read_WAVE_PCM_channels` reads frames from a WAVE file encoded in PCM, only decoding the samples of certain channels, defined below: @NLNT
+				MUDEF muafResult mu_read_WAVE_PCM_channels(const char* filename, muWAVEProfile* profile, uint32_m beg_frame, uint32_m frame_len, uint16_m channel_count, const uint16_m* channels, void* data);
+
+				// @DOCLINE `channels` is an array of `channel_count` channel indexes, each of which must be less than the amount of channels in the WAVE file. The frames written to `data` have `channel_count` samples each, with the sample at index `c` of each frame being from the channel `channels[c]`. Channel indexes can be listed in any order, and the same channel can be listed more than once.
+
+				// @DOCLINE The requirements for this function are otherwise the same as [`mu_read_WAVE_PCM`](#read-pcm-wave-data), except that the given data only needs to be large enough to hold the requested amount of frames with `channel_count` samples each.
+
+				// @DOCLINE Since the samples of every channel are interleaved within WAVE audio data, this function still needs to read every channel's data from the file, but only the samples of the requested channels are converted and stored. The data is read from the file in blocks of `MUAF_WAVE_READ_BLOCK_SIZE` bytes (rounded down to a whole amount of frames), which is an overridable macro defined as 65536 by default.
+				#ifndef MUAF_WAVE_READ_BLOCK_SIZE
+					#define MUAF_WAVE_READ_BLOCK_SIZE 65536
+				#endif
+
+			// @DOCLINE ### Read PCM WAVE ranges
+
+				typedef struct muWAVERange muWAVERange;
+
+				// @DOCLINE The function `mu_read_WAVE_PCM_ranges` reads several frame ranges from a WAVE file encoded in PCM, only opening the file once, defined below: @NLNT
+				MUDEF muafResult mu_read_WAVE_PCM_ranges(const char* filename, muWAVEProfile* profile, size_m range_count, muWAVERange* ranges);
+
+				// @DOCLINE `ranges` is an array of `range_count` frame ranges to be read. The struct `muWAVERange` represents a frame range to be read, and has the following members:
+				struct muWAVERange {
+					// @DOCLINE * `@NLFT beg_frame` - the first frame of the range.
+					uint32_m beg_frame;
+					// @DOCLINE * `@NLFT frame_len` - the amount of frames in the range.
+					uint32_m frame_len;
+					// @DOCLINE * `@NLFT* data` - where the frames of the range are to be stored; must be large enough to hold `frame_len` frames in the audio format's corresponding type.
+					void* data;
+				};
+
+				// @DOCLINE Each range has the same requirements as the frame range given to [`mu_read_WAVE_PCM`](#read-pcm-wave-data). Ranges can be given in any order and can overlap, but their data cannot overlap.
+
+				// @DOCLINE The ranges are sorted by their location within the file, and ranges that are close enough to each other are coalesced and read from the file at once, which is much faster than reading each range with its own call to `mu_read_WAVE_PCM`. Two ranges are coalesced if there are no more than `MUAF_WAVE_RANGE_GAP_SIZE` bytes between them (an overridable macro defined as 16384 by default) and if the coalesced read would be no larger than `MUAF_WAVE_RANGE_COALESCE_SIZE` bytes (an overridable macro defined as 1048576 by default).
+				#ifndef MUAF_WAVE_RANGE_GAP_SIZE
+					#define MUAF_WAVE_RANGE_GAP_SIZE 16384
+				#endif
+				#ifndef MUAF_WAVE_RANGE_COALESCE_SIZE
+					#define MUAF_WAVE_RANGE_COALESCE_SIZE 1048576
+				#endif
+
+			// @DOCLINE ### Read resampled PCM WAVE data
+
+				// @DOCLINE The function `mu_read_WAVE_PCM_resampled` reads frames from a WAVE file encoded in PCM, converted to another sample rate using a [resample filter](#resample-filters), defined below: @NLNT
+				MUDEF muafResult mu_read_WAVE_PCM_resampled(const char* filename, muWAVEProfile* profile, muResampleFilter* filter, uint32_m beg_frame, uint32_m frame_len, void* data);
+
+				// @DOCLINE The filter's source sample rate must match the sample rate of the WAVE file, otherwise `MUAF_INVALID_RESAMPLE_RATE` is returned. The given frame range is in frames at the filter's destination sample rate, and must be valid for the [resampled frame count](#resampled-frame-count) of the WAVE file. The requirements for this function are otherwise the same as [`mu_read_WAVE_PCM`](#read-pcm-wave-data), and the frames are stored in the audio format's corresponding type, rounded and clamped to its range.
+
+				// @DOCLINE Each resampled frame only depends on its position within the file, so a file can be read in consecutive frame ranges (for example, while streaming it) and give the exact same frames as reading it all at once. Audio data before the beginning and after the end of the file is treated as silence. The resampled frames are calculated in blocks of `MUAF_RESAMPLE_BLOCK_SIZE` frames, which is an overridable macro defined as 4096 by default. For reading resampled frames repeatedly from the same file, [`mu_read_WAVE_reader_resampled`](#read-resampled-from-wave-reader) is faster, as this function opens and closes the file on every call.
+				#ifndef MUAF_RESAMPLE_BLOCK_SIZE
+					#define MUAF_RESAMPLE_BLOCK_SIZE 4096
+				#endif
+
+			// @DOCLINE ### Stream PCM WAVE data
+
+				typedef struct muWAVEStream muWAVEStream;
+
+				// @DOCLINE A WAVE stream reads frames from a WAVE file encoded in PCM sequentially ahead of time, storing them in a ring buffer that frames can be pulled from without ever touching the file. This is useful for real-time playback, where a thread that can't afford to wait on the disk (such as an audio callback) pulls frames, while another thread keeps the ring buffer filled.
+
+				// @DOCLINE The type `muWAVEStream` is an opaque struct representing a WAVE stream. A WAVE stream can be created with the function `mu_create_WAVE_stream`, defined below: @NLNT
+				MUDEF muafResult mu_create_WAVE_stream(const char* filename, muWAVEProfile* profile, uint32_m depth, muWAVEStream** stream);
+
+				// @DOCLINE The given and already loaded [WAVE profile](#wave-profile) must have a [PCM audio format](#is-audio-format-pcm) supported by WAVE. `depth` is the capacity of the ring buffer in frames, which is how far ahead of the pulled frames the stream can read, and must be over 0; otherwise, `MUAF_INVALID_WAVE_STREAM_DEPTH` is returned. The file is kept open until the stream is destroyed, and the profile is not referenced by the stream once it's created. Once created successfully, the stream must be destroyed at some point using the function `mu_destroy_WAVE_stream`, defined below: @NLNT
+				MUDEF void mu_destroy_WAVE_stream(muWAVEStream* stream);
+
+				// @DOCLINE #### Fill WAVE stream
+
+					// @DOCLINE The function `mu_fill_WAVE_stream` reads frames from the file into the stream's ring buffer until the ring buffer is full or the end of the audio data is reached, defined below: @NLNT
+					MUDEF muafResult mu_fill_WAVE_stream(muWAVEStream* stream, uint32_m* filled);
+
+					// @DOCLINE `filled` is set to the amount of frames that were read into the ring buffer if it's not 0. This function is meant to be called repeatedly by the thread responsible for I/O, such as a background thread created by the user that calls this function and then sleeps or waits for a signal.
+
+				// @DOCLINE #### Pull from WAVE stream
+
+					// @DOCLINE The function `mu_pull_WAVE_stream` takes up to the given amount of frames from the stream's ring buffer, defined below: @NLNT
+					MUDEF uint32_m mu_pull_WAVE_stream(muWAVEStream* stream, uint32_m frame_len, void* data);
+
+					// @DOCLINE The frames are stored in `data` in the audio format's corresponding type, and the amount of frames that were pulled is returned, which can be less than `frame_len` if the ring buffer doesn't have enough frames available. This function never blocks, allocates memory, or accesses the file.
+
+				// @DOCLINE #### WAVE stream state
+
+					// @DOCLINE The function `mu_WAVE_stream_available` returns the amount of frames currently available to pull from the stream, defined below: @NLNT
+					MUDEF uint32_m mu_WAVE_stream_available(muWAVEStream* stream);
+
+					// @DOCLINE The function `mu_WAVE_stream_finished` returns whether or not every frame of the audio data has been pulled from the stream, defined below: @NLNT
+					MUDEF muBool mu_WAVE_stream_finished(muWAVEStream* stream);
+
+				// @DOCLINE #### WAVE stream threading
+
+					// @DOCLINE A WAVE stream is a single-producer, single-consumer queue: one thread can call `mu_fill_WAVE_stream` while another thread calls `mu_pull_WAVE_stream`, `mu_WAVE_stream_available`, and `mu_WAVE_stream_finished`, without any locking. The stream synchronizes using [atomic operations](#atomic-operations). Filling the stream from multiple threads at once or pulling from the stream from multiple threads at once is not safe, and the stream must not be used by any thread once `mu_destroy_WAVE_stream` is called.
+
+			// @DOCLINE ### Scan PCM WAVE silence
+
+				typedef struct muWAVESilence muWAVESilence;
+
+				// @DOCLINE The function `mu_scan_WAVE_silence` finds the silence at the beginning and end of a WAVE file encoded in PCM, and optionally the DC offset of each channel, defined below: @NLNT
+				MUDEF muafResult mu_scan_WAVE_silence(const char* filename, muWAVEProfile* profile, double threshold, muWAVESilence* silence, double* dc_offsets);
+
+				// @DOCLINE The given and already loaded [WAVE profile](#wave-profile) must have a [PCM audio format](#is-audio-format-pcm) supported by WAVE. A frame is considered silent if every sample in it is within `threshold` of 0, with `threshold` scaled so that 1 is the highest value a sample can have (for example, 0.001 for -60 dBFS); a `threshold` of 0 only considers frames of all zeros to be silent. The struct `muWAVESilence` represents the silence found in a WAVE file, and has the following members:
+				struct muWAVESilence {
+					// @DOCLINE * `@NLFT leading` - the amount of silent frames at the beginning of the audio data.
+					uint32_m leading;
+					// @DOCLINE * `@NLFT trailing` - the amount of silent frames at the end of the audio data.
+					uint32_m trailing;
+					// @DOCLINE * `@NLFT silent` - whether or not every frame is silent, in which case `leading` and `trailing` are both the amount of frames.
+					muBool silent;
+				};
+
+				// @DOCLINE If `dc_offsets` is 0, the audio data is scanned forward from the beginning until a frame that isn't silent is found, and then backward from the end until a frame that isn't silent is found, so only the silent frames (rounded up to whole blocks) are read. If `dc_offsets` is not 0, it must be large enough to hold one value for each channel, and is filled with the mean of each channel's samples (scaled the same as `threshold`); this needs every frame to be read, so the audio data is scanned forward once in full instead.
+
+				// @DOCLINE The audio data is read in blocks of `MUAF_WAVE_SCAN_BLOCK_SIZE` bytes (rounded down to a whole amount of frames), which is an overridable macro defined as 1048576 by default.
+				#ifndef MUAF_WAVE_SCAN_BLOCK_SIZE
+					#define MUAF_WAVE_SCAN_BLOCK_SIZE 1048576
+				#endif
+
 			// @DOCLINE ### Get WAVE audio format
 
 				// @DOCLINE The function `mu_get_WAVE_audio_format` returns the [audio format](#audio-formats) that a WAVE file is encoded in, defined below: @NLNT
@@ -1006,6 +1408,55 @@ Overall, muaf is okay with files not strictly complying with the specification w
 
 				// @DOCLINE If the given and already loaded [WAVE profile](#wave-profile) does not have a [supported audio format](#audio-formats) equivalent, this function returns `MUAF_FORMAT_UNKNOWN`.
 
+			// @DOCLINE ### WAVE readers
+
+				typedef struct muWAVEReader muWAVEReader;
+
+				// @DOCLINE A WAVE reader keeps a WAVE file encoded in PCM open so that frames can be read from it by multiple threads at once without reopening the file. The type `muWAVEReader` is an opaque struct representing a WAVE reader. A WAVE reader can be opened with the function `mu_open_WAVE_reader`, defined below: @NLNT
+				MUDEF muafResult mu_open_WAVE_reader(const char* filename, muWAVEProfile* profile, muWAVEReader** reader);
+
+				// @DOCLINE The given and already loaded [WAVE profile](#wave-profile) must have a [PCM audio format](#is-audio-format-pcm) supported by WAVE, and is not referenced by the reader once it's opened. Once opened successfully, the reader must be closed at some point using the function `mu_close_WAVE_reader`, defined below: @NLNT
+				MUDEF void mu_close_WAVE_reader(muWAVEReader* reader);
+
+				// @DOCLINE A reader can also be opened with a given [allocator](#allocators), which is kept by the reader and used to free it once closed, using the function `mu_open_WAVE_reader_with_allocator`, defined below: @NLNT
+				MUDEF muafResult mu_open_WAVE_reader_with_allocator(const char* filename, muWAVEProfile* profile, const muafAllocator* allocator, muWAVEReader** reader);
+
+				// @DOCLINE #### Read from WAVE reader
+
+					// @DOCLINE The function `mu_read_WAVE_reader` reads frames from a WAVE reader, defined below: @NLNT
+					MUDEF muafResult mu_read_WAVE_reader(muWAVEReader* reader, uint32_m beg_frame, uint32_m frame_len, void* data);
+
+					// @DOCLINE The given frame range must be valid for the WAVE file, and the given data must be large enough to hold the requested amount of frames in the audio format's corresponding type. The frames are read directly into `data` and converted in place, so no memory is allocated.
+
+					// @DOCLINE The frames are converted using a kernel specialized for the reader's audio format, which is chosen once when the reader is opened. On little-endian machines, 16-, 32-, and 64-bit samples are already stored in their corresponding type, and aren't converted at all; whether or not the machine is little-endian is determined by `MUAF_LITTLE_ENDIAN`, an overridable macro defined as 1 if the compiler reports a little-endian byte order (or if compiling for Windows) and 0 otherwise.
+					#ifndef MUAF_LITTLE_ENDIAN
+						#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+							#define MUAF_LITTLE_ENDIAN 1
+						#elif defined(_WIN32)
+							#define MUAF_LITTLE_ENDIAN 1
+						#else
+							#define MUAF_LITTLE_ENDIAN 0
+						#endif
+					#endif
+
+				// @DOCLINE #### Read resampled from WAVE reader
+
+					// @DOCLINE The function `mu_read_WAVE_reader_resampled` reads frames from a WAVE reader, converted to another sample rate using a [resample filter](#resample-filters), defined below: @NLNT
+					MUDEF muafResult mu_read_WAVE_reader_resampled(muWAVEReader* reader, muResampleFilter* filter, uint32_m beg_frame, uint32_m frame_len, void* data);
+
+					// @DOCLINE The requirements and behavior of this function are the same as [`mu_read_WAVE_PCM_resampled`](#read-resampled-pcm-wave-data). Unlike `mu_read_WAVE_reader`, this function allocates memory to hold the source frames and filter state for each block.
+
+				// @DOCLINE #### WAVE reader cache mode
+
+					// @DOCLINE The function `mu_set_WAVE_reader_cache` sets how a WAVE reader uses the [page cache](#page-cache), defined below: @NLNT
+					MUDEF muafResult mu_set_WAVE_reader_cache(muWAVEReader* reader, muafCacheMode mode, muafCacheMode* used);
+
+					// @DOCLINE `used` is set to the cache mode that's actually used if it's not 0, which can be lower than `mode` if it isn't supported. With `MUAF_CACHE_DROP`, the bytes of each read are dropped from the page cache once they've been read. This function must not be called while the reader is being read from by any thread.
+
+				// @DOCLINE #### WAVE reader threading
+
+					// @DOCLINE A WAVE reader reads using [positional reads](#positional-reading-dependencies), and does not modify the reader when reading, so `mu_read_WAVE_reader` and `mu_read_WAVE_reader_resampled` can be called on the same reader by any amount of threads at once for any frame ranges without any locking, including overlapping ranges (as long as the data being read into doesn't overlap). The reader must not be read from by any thread once `mu_close_WAVE_reader` is called.
+
 		// @DOCLINE ## Writing WAVE audio data
 
 			typedef struct muWAVEWrapper muWAVEWrapper;
@@ -1021,7 +1472,124 @@ Overall, muaf is okay with files not strictly complying with the specification w
 
 				// @DOCLINE The data passed into this function may be changed by this function.
 
-				// @DOCLINE This function can be called on any valid frame range any number of times in any order.
+				// @DOCLINE This function can be called on any valid frame range any number of times in any order. Since it opens and closes the file on every call, writing many small blocks of frames is much faster with a [WAVE writer](#wave-writers) given a [buffer](#wave-writer-buffers).
+
+			// @DOCLINE ### WAVE writers
+
+				typedef struct muWAVEWriter muWAVEWriter;
+
+				// @DOCLINE A WAVE writer keeps a WAVE file open so that frames can be written to it without reopening the file on every write. The type `muWAVEWriter` is an opaque struct representing a WAVE writer. A WAVE writer can be opened with the function `mu_open_WAVE_writer`, defined below: @NLNT
+				MUDEF muafResult mu_open_WAVE_writer(const char* filename, muWAVEWrapper* wrapper, muWAVEWriter** writer);
+
+				// @DOCLINE The given [WAVE wrapper](#wave-wrapper) must have already been created for the given file, and is copied into the writer, so it's not referenced by the writer once it's opened. Once opened successfully, the writer must be closed at some point using the function `mu_close_WAVE_writer`, defined below: @NLNT
+				MUDEF void mu_close_WAVE_writer(muWAVEWriter* writer);
+
+				// @DOCLINE #### Write to WAVE writer
+
+					// @DOCLINE The function `mu_write_WAVE_writer` writes frames to a WAVE writer, defined below: @NLNT
+					MUDEF muafResult mu_write_WAVE_writer(muWAVEWriter* writer, uint32_m beg_frame, uint32_m frame_len, void* data);
+
+					// @DOCLINE The requirements and behavior of this function are the same as [`mu_write_WAVE_PCM`](#write-pcm-wave-data), including that the data passed into it may be changed by it. A WAVE writer can only be written to by one thread at a time.
+
+				// @DOCLINE #### WAVE writer buffers
+
+					// @DOCLINE Writing many small blocks of frames (such as while capturing audio in real time) performs a write to the file for each block. To coalesce these into fewer, larger writes, a WAVE writer can be given a buffer with the function `mu_set_WAVE_writer_buffer`, defined below: @NLNT
+					MUDEF muafResult mu_set_WAVE_writer_buffer(muWAVEWriter* writer, size_m buffer_size);
+
+					// @DOCLINE `buffer_size` is the size of the buffer in bytes, which is rounded down to a whole amount of frames in the file; if it's 0 (or smaller than one frame), the writer has no buffer, which is the default. Any frames already in the writer's previous buffer are written to the file first.
+
+					// @DOCLINE While a writer has a buffer, frames written to it are converted into the buffer instead of being written to the file, as long as they directly follow the frames already in the buffer and fit in it. The buffer is written to the file in one write once it's full, before writing frames that don't directly follow the ones in the buffer, before a [checkpoint](#wave-writer-checkpoints), and when the writer is closed. Writes that are at least as big as the buffer are written to the file directly. Frames converted into the buffer leave the data passed in unchanged.
+
+					// @DOCLINE The frames in the buffer can be written to the file at any time with the function `mu_flush_WAVE_writer`, defined below: @NLNT
+					MUDEF muafResult mu_flush_WAVE_writer(muWAVEWriter* writer);
+
+					// @DOCLINE Since `mu_close_WAVE_writer` can't return a result, calling `mu_flush_WAVE_writer` before closing the writer is the only way to know if the last frames were written successfully. Frames that are still in the buffer are not in the file yet, so they're lost if the program stops before they're written.
+
+				// @DOCLINE #### WAVE writer checkpoints
+
+					// @DOCLINE A WAVE file's headers are written once it's created, and describe the file at its full length, so if the program writing it stops partway through (such as by crashing), the file claims to hold every frame, with the frames that were never written holding whatever the file's allocation left there. To avoid this, a WAVE writer can periodically write checkpoints, which is enabled with the function `mu_set_WAVE_writer_checkpoints`, defined below: @NLNT
+					MUDEF muafResult mu_set_WAVE_writer_checkpoints(muWAVEWriter* writer, uint32_m checkpoint_frames);
+
+					// @DOCLINE A checkpoint writes the writer's [buffer](#wave-writer-buffers) to the file, makes sure that the audio data written so far is stored on disk, and then rewrites the ckSize values of the RIFF chunk and the wave-data chunk so that the file only holds the frames up to the end of the furthest frame written so far, and makes sure that this is stored on disk as well. The audio data is always stored before the headers that describe it, so if the program stops at any point, the file holds only frames that were actually written (given that they were written in order).
+
+					// @DOCLINE Once enabled, a checkpoint is written immediately (so the file holds no frames until some are written), and then after every `checkpoint_frames` frames written since the last checkpoint, as well as when the writer is closed. Passing 0 for `checkpoint_frames` disables checkpoints, but leaves the headers as they were written by the last checkpoint. A checkpoint can also be written at any time with the function `mu_checkpoint_WAVE_writer`, defined below: @NLNT
+					MUDEF muafResult mu_checkpoint_WAVE_writer(muWAVEWriter* writer);
+
+					// @DOCLINE Since `mu_close_WAVE_writer` can't return a result, calling `mu_checkpoint_WAVE_writer` before closing the writer is the only way to know if the last checkpoint succeeded. Data is stored on disk using `fdatasync` on Linux and `FlushFileBuffers` on Windows; if [positional writes](#positional-reading-dependencies) aren't available, the data is only flushed out of the stdio buffers, and isn't guaranteed to be stored on disk.
+
+				// @DOCLINE #### WAVE writer cache mode
+
+					// @DOCLINE The function `mu_set_WAVE_writer_cache` sets how a WAVE writer uses the [page cache](#page-cache), defined below: @NLNT
+					MUDEF muafResult mu_set_WAVE_writer_cache(muWAVEWriter* writer, muafCacheMode mode, muafCacheMode* used);
+
+					// @DOCLINE `used` is set to the cache mode that's actually used if it's not 0, which can be lower than `mode` if it isn't supported. Any frames in the writer's [buffer](#wave-writer-buffers) are written to the file first. With `MUAF_CACHE_DROP`, written data can only be dropped from the page cache once it's been written back to disk, so it's dropped as the operating system writes it back, and all of it is dropped after every [checkpoint](#wave-writer-checkpoints). With `MUAF_CACHE_DIRECT`, the writer should be given a large buffer (such as `MUAF_DIRECT_BLOCK_SIZE` bytes), so that the blocks read at the edges of each write are small compared to it.
+
+			// @DOCLINE ### Recover WAVE file
+
+				// @DOCLINE The function `mu_recover_WAVE` repairs the headers of a WAVE file whose wave-data chunk claims more audio data than the file actually holds (such as a file [allocated](#wave-wrapper-allocation) with `MUAF_WAVE_ALLOCATION_NONE` whose writing stopped partway through), defined below: @NLNT
+				MUDEF muafResult mu_recover_WAVE(const char* filename, uint32_m* frames);
+
+				// @DOCLINE The wave-data chunk's ckSize is lowered to the amount of whole frames that are actually in the file, and the RIFF chunk's ckSize is set to match (writing the wave-data chunk's pad byte if it's missing); if the file already holds all of the frames that it claims to, its headers are left as-is. If any of these writes fail, `MUAF_FAILED_WRITE_FILE` is returned. `frames` is set to the amount of frames in the repaired file if it's not 0.
+
+				// @DOCLINE Only the headers of the chunks before wave-data are read, so this takes the same amount of reads and writes no matter how big the file is. The wave-data chunk must be the last chunk in the file and come after fmt-ck (which is always the case for files created by muaf). This cannot recover the frames of a file that was allocated at its full length, since the frames that were never written can't be told apart from the ones that were; [WAVE writer checkpoints](#wave-writer-checkpoints) should be used instead for those files.
+
+		// @DOCLINE ## WAVE conversions
+
+			typedef struct muWAVEConversion muWAVEConversion;
+
+			// @DOCLINE A WAVE conversion converts a WAVE file encoded in PCM into a new WAVE file encoded in PCM with a different sample width and/or channel layout, such as converting a 24-bit master to a 16-bit deliverable. The audio data is converted in blocks, which any amount of threads can work on at once. The type `muWAVEConversion` is an opaque struct representing a WAVE conversion. A WAVE conversion can be created with the function `mu_create_WAVE_conversion`, defined below: @NLNT
+			MUDEF muafResult mu_create_WAVE_conversion(const char* src_filename, muWAVEProfile* profile, const char* dst_filename, muWAVEWrapper* wrapper, const uint16_m* channel_map, muBool dither, muWAVEConversion** conversion);
+
+			// @DOCLINE The given and already loaded [WAVE profile](#wave-profile) of the source file must have a [PCM audio format](#is-audio-format-pcm) supported by WAVE. The destination file is created based on the given [WAVE wrapper](#wave-wrapper), whose members `audio_format` (which must also be a PCM audio format supported by WAVE) and `num_channels` (which must be over 0) are filled in by the user, and whose members `num_frames` and `sample_rate` are filled in by this function based on the source file; the wrapper must be freed by the user once the conversion is created successfully.
+
+			// @DOCLINE `channel_map` is an array of `wrapper->num_channels` channel indexes, where each channel in the destination file takes the samples of the channel in the source file at the given index. If `channel_map` is 0, each channel in the destination file takes the samples of the channel at the same index in the source file. If a channel index is out of range for the source file, `MUAF_INVALID_WAVE_CONVERSION_CHANNEL` is returned.
+
+			// @DOCLINE When converting to a smaller sample width, samples are rounded to the nearest value; if `dither` is `MU_TRUE`, [TPDF dither](https://en.wikipedia.org/wiki/Dither#Digital_audio) of 1 least-significant bit (in the destination format) is added before rounding. The dither's noise is seeded per block, so the output is the same no matter how many threads perform the conversion. Converting to a larger sample width is lossless.
+
+			// @DOCLINE Once created successfully, the conversion must be destroyed at some point using the function `mu_destroy_WAVE_conversion`, defined below: @NLNT
+			MUDEF void mu_destroy_WAVE_conversion(muWAVEConversion* conversion);
+
+			// @DOCLINE ### Process WAVE conversion
+
+				// @DOCLINE The function `mu_process_WAVE_conversion` converts blocks of the audio data until no blocks are left, defined below: @NLNT
+				MUDEF muafResult mu_process_WAVE_conversion(muWAVEConversion* conversion, uint32_m* blocks);
+
+				// @DOCLINE `blocks` is set to the amount of blocks converted by this call if it's not 0. Each block is read from the source file, converted, and written to the destination file; only one block is held in memory at a time per call, so the memory used is bounded by the amount of threads converting at once. If reading, converting, or writing any block fails, every call working on the conversion stops and the fatal result is returned by the call that hit the failure. The conversion is complete once every call has returned.
+
+				// @DOCLINE The macro `MUAF_WAVE_CONVERSION_BLOCK_SIZE` is the amount of frames in each block, and is overridable, defined below: @NLNT
+				#ifndef MUAF_WAVE_CONVERSION_BLOCK_SIZE
+					#define MUAF_WAVE_CONVERSION_BLOCK_SIZE 16384
+				#endif
+
+			// @DOCLINE ### WAVE conversion threading
+
+				// @DOCLINE `mu_process_WAVE_conversion` can be called on the same conversion by any amount of threads at once without any locking; each call claims blocks using [atomic operations](#atomic-operations), and blocks are read from and written to using [positional reads and writes](#positional-reading-dependencies). Whatever threads the user has available (such as a thread pool) can each call this function, including the thread that created the conversion. The conversion must not be destroyed until every call to `mu_process_WAVE_conversion` on it has returned.
+
+		// @DOCLINE ## WAVE splicing
+
+			typedef struct muWAVESegment muWAVESegment;
+
+			// @DOCLINE The function `mu_splice_WAVE` creates a new WAVE file out of frame ranges of other WAVE files encoded in PCM, one after the other, defined below: @NLNT
+			MUDEF muafResult mu_splice_WAVE(size_m segment_count, muWAVESegment* segments, const char* dst_filename);
+
+			// @DOCLINE `segments` is an array of `segment_count` segments (which must be over 0), each of which is a frame range of a WAVE file. The struct `muWAVESegment` represents a segment, and has the following members:
+			struct muWAVESegment {
+				// @DOCLINE * `@NLFT* filename` - the name of the WAVE file that the segment is taken from.
+				const char* filename;
+				// @DOCLINE * `@NLFT* profile` - the already loaded [WAVE profile](#wave-profile) of the WAVE file.
+				muWAVEProfile* profile;
+				// @DOCLINE * `@NLFT beg_frame` - the first frame of the segment.
+				uint32_m beg_frame;
+				// @DOCLINE * `@NLFT frame_len` - the amount of frames in the segment.
+				uint32_m frame_len;
+			};
+
+			// @DOCLINE Every segment's frame range must be valid for its file, and every file must have the same [PCM audio format](#is-audio-format-pcm) supported by WAVE, amount of channels, and sample rate; otherwise, `MUAF_INVALID_WAVE_SPLICE_FORMAT` is returned before the destination file is created. The same file can be used by any amount of segments, but the destination file can't be any of them. Trimming a file is done with a single segment, and concatenating files is done with a segment for the whole of each file. If copying a segment fails, the destination file is removed.
+
+			// @DOCLINE The audio data is never decoded or encoded; the destination file's chunks are laid out the same way as [`mu_create_WAVE_wrapper`](#wave-wrapper), and the raw bytes of each segment are copied directly into its wave data. On Linux, this is done with [`copy_file_range`](#positional-reading-dependencies), which lets the kernel copy the data without it passing through muaf (and, on some filesystems, share the data between files instead of copying it). Otherwise, or if `copy_file_range` fails, the data is copied through a buffer of `MUAF_WAVE_COPY_BLOCK_SIZE` bytes, which is an overridable macro defined as 1048576 by default.
+			#ifndef MUAF_WAVE_COPY_BLOCK_SIZE
+				#define MUAF_WAVE_COPY_BLOCK_SIZE 1048576
+			#endif
 
 		// @DOCLINE ## WAVE profile
 
@@ -1029,9 +1597,18 @@ Overall, muaf is okay with files not strictly complying with the specification w
 			typedef union muWAVEFormatSpecificFields muWAVEFormatSpecificFields;
 			typedef struct muWAVEChunks muWAVEChunks;
 
+			// This struct is described later. Make sure it stays updated!
+			struct muWAVEPCM {
+				uint16_m bits_per_sample;
+			};
+
 			// This union is described later. Make sure it stays updated!
 			union muWAVEFormatSpecificFields {
-				muWAVEPCM* wave_pcm;
+				#ifdef MUAF_WAVE_INLINE_SPECIFIC_FIELDS
+					muWAVEPCM wave_pcm;
+				#else
+					muWAVEPCM* wave_pcm;
+				#endif
 			};
 
 			// This struct is described later. Make sure it stays updated!
@@ -1056,6 +1633,12 @@ Overall, muaf is okay with files not strictly complying with the specification w
 			// @DOCLINE Once retrieved, the profile must be deallocated at some point using the function `mu_free_WAVE_profile`, defined below: @NLNT
 			MUDEF void mu_free_WAVE_profile(muWAVEProfile* profile);
 
+			// @DOCLINE A profile can also be retrieved with a given [allocator](#allocators) using the function `mu_get_WAVE_profile_with_allocator`, defined below: @NLNT
+			MUDEF muafResult mu_get_WAVE_profile_with_allocator(const char* filename, muWAVEProfile* profile, const muafAllocator* allocator);
+
+			// @DOCLINE A profile retrieved this way must be deallocated with the same allocator using the function `mu_free_WAVE_profile_with_allocator`, defined below: @NLNT
+			MUDEF void mu_free_WAVE_profile_with_allocator(muWAVEProfile* profile, const muafAllocator* allocator);
+
 			// @DOCLINE The struct `muWAVEProfile` represents the audio file profile of a WAVE file, and has the following members:
 			struct muWAVEProfile {
 				// @DOCLINE * `@NLFT format_tag` - the value of wFormatTag in fmt's common-fields; the format category.
@@ -1084,10 +1667,8 @@ Overall, muaf is okay with files not strictly complying with the specification w
 				#define MU_WAVE_FORMAT_PCM 0x0001
 
 				// @DOCLINE This format does store data in the [format-specific-fields portion of the fmt chunk](#wave-format-specific-fields). This data is represented by the struct `muWAVEPCM`, which has the following member:
-				struct muWAVEPCM {
-					// @DOCLINE * `@NLFT bits_per_sample` - the value of wBitsPerSample in format-specific-fields's PCM-format-specific form; the size of each sample, in bits.
-					uint16_m bits_per_sample;
-				};
+
+				// @DOCLINE * `uint16_m bits_per_sample` - the value of wBitsPerSample in format-specific-fields's PCM-format-specific form; the size of each sample, in bits.
 
 		// @DOCLINE ## WAVE format specific fields
 
@@ -1095,6 +1676,15 @@ Overall, muaf is okay with files not strictly complying with the specification w
 
 			// @DOCLINE * `muWAVEPCM* wave_pcm` - the format-specific-fields data for the [WAVE PCM format](#wave-pcm-format).
 
+			// @DOCLINE By default, the format-specific-fields data is allocated separately for each profile, which is why a profile needs to be deallocated. If `MUAF_WAVE_INLINE_SPECIFIC_FIELDS` is defined, the members of `muWAVEFormatSpecificFields` are instead stored by value (for example, `muWAVEPCM wave_pcm`), in which case retrieving a profile allocates nothing, and a profile is plain data that can be copied freely and stored in arrays without ever needing to be deallocated (although calling `mu_free_WAVE_profile` on it is still valid, and does nothing).
+
+			// @DOCLINE The macro `MU_WAVE_PCM_FIELDS(profile)` returns a `muWAVEPCM*` to the WAVE PCM format's data from a pointer to a profile either way, which can be used to write code that works regardless of whether `MUAF_WAVE_INLINE_SPECIFIC_FIELDS` is defined.
+			#ifdef MUAF_WAVE_INLINE_SPECIFIC_FIELDS
+				#define MU_WAVE_PCM_FIELDS(profile) (&(profile)->specific_fields.wave_pcm)
+			#else
+				#define MU_WAVE_PCM_FIELDS(profile) ((profile)->specific_fields.wave_pcm)
+			#endif
+
 		// @DOCLINE ## WAVE chunks
 
 			// @DOCLINE The struct `muWAVEChunks` stores the index location of known chunks within the WAVE file. It has the following members:
@@ -1130,6 +1720,28 @@ Overall, muaf is okay with files not strictly complying with the specification w
 
 			// @DOCLINE Upon a successful/non-fatal call to `mu_create_WAVE_wrapper`, the WAVE file is properly encoded, although with all of the audio data initialized to 0.
 
+			// @DOCLINE ### WAVE wrapper allocation
+
+				typedef uint8_m muWAVEAllocation;
+
+				// @DOCLINE `mu_create_WAVE_wrapper` gives the file its full length by seeking to its last byte and writing it, which relies on the filesystem to fill in the rest of the file with zeros without writing them; on filesystems that don't support sparse files, this means that every byte of the audio data is written as 0 before the function returns. The function `mu_create_WAVE_wrapper_with_allocation` creates a WAVE file in the same way, but with a given strategy for how the file's space is allocated, defined below: @NLNT
+				MUDEF muafResult mu_create_WAVE_wrapper_with_allocation(const char* filename, muWAVEWrapper* wrapper, muWAVEAllocation allocation, muWAVEAllocation* used);
+
+				// @DOCLINE If `used` is not 0, it is dereferenced and set to the strategy that was actually used, since a strategy not supported by the system or filesystem falls back to the next one that can be used.
+
+				// @DOCLINE The type `muWAVEAllocation` (typedef for `uint8_m`) represents a strategy for allocating a WAVE file's space, and has the following defined values:
+
+				// @DOCLINE * `MUAF_WAVE_ALLOCATION_SEEK` - seeks to the last byte of the file and writes it, which is what `mu_create_WAVE_wrapper` does. This is always supported.
+				#define MUAF_WAVE_ALLOCATION_SEEK 0
+				// @DOCLINE * `MUAF_WAVE_ALLOCATION_RESERVE` - reserves the disk space for the entire file without writing it, using [`fallocate`](#positional-reading-dependencies) on Linux and `SetEndOfFile` on Windows, so that writing the audio data later on can't fail due to a lack of space. The audio data reads as 0 until it is written. This falls back to `MUAF_WAVE_ALLOCATION_EXTEND` if the filesystem doesn't support it.
+				#define MUAF_WAVE_ALLOCATION_RESERVE 1
+				// @DOCLINE * `MUAF_WAVE_ALLOCATION_EXTEND` - sets the file's length without allocating any of its space, using [`ftruncate`](#positional-reading-dependencies) on Linux; on Windows, this is done the same way as `MUAF_WAVE_ALLOCATION_RESERVE`. The audio data reads as 0 until it is written. This falls back to `MUAF_WAVE_ALLOCATION_SEEK` if it isn't supported.
+				#define MUAF_WAVE_ALLOCATION_EXTEND 2
+				// @DOCLINE * `MUAF_WAVE_ALLOCATION_NONE` - only writes the headers, leaving the file to grow as the audio data is written by [`mu_write_WAVE_PCM`](#write-pcm-wave-data); the audio data is not initialized to 0. This is always supported.
+				#define MUAF_WAVE_ALLOCATION_NONE 3
+
+				// @DOCLINE The headers written with `MUAF_WAVE_ALLOCATION_NONE` already describe the file at its full length, so the file is not valid until every frame has been written (as well as the wave-data chunk's pad byte, if its length is odd), which is meant for rendering audio sequentially into a large file without waiting on its allocation first.
+
 			// @DOCLINE The struct `muWAVEWrapper` represents a WAVE file wrapper, and has the following members:
 			struct muWAVEWrapper {
 				// @DOCLINE * `@NLFT audio_format` - the [audio format](#audio-formats) of the WAVE file.
@@ -1165,10 +1777,35 @@ Overall, muaf is okay with files not strictly complying with the specification w
 
 		// @DOCLINE All values provided by the FLAC API by retrieving information from a FLAC audio file are checked and strictly guaranteed to be values permitted by the specification unless it is stated otherwise. These limitations are also strictly followed when encoding with no exceptions.
 
-		// @DOCLINE ## FLAC profile
+		// @DOCLINE ## FLAC readers
 
 			typedef struct muFLACProfile muFLACProfile;
 			typedef struct muFLACMetadataBlock muFLACMetadataBlock;
+			typedef struct muFLACReader muFLACReader;
+
+			// @DOCLINE A FLAC reader keeps a FLAC file open and decodes its frames from beginning to end, one block at a time. The type `muFLACReader` is an opaque struct representing a FLAC reader. A FLAC reader can be opened with the function `mu_open_FLAC_reader`, defined below: @NLNT
+			MUDEF muafResult mu_open_FLAC_reader(const char* filename, muFLACProfile* profile, muFLACReader** reader);
+
+			// @DOCLINE The given [FLAC profile](#flac-profile) must already be loaded, and is not referenced by the reader once it's opened. Once opened successfully, the reader must be closed at some point using the function `mu_close_FLAC_reader`, defined below: @NLNT
+			MUDEF void mu_close_FLAC_reader(muFLACReader* reader);
+
+			// @DOCLINE ### Read from FLAC reader
+
+				// @DOCLINE The function `mu_read_FLAC_reader` reads the next frames from a FLAC reader, defined below: @NLNT
+				MUDEF muafResult mu_read_FLAC_reader(muFLACReader* reader, uint32_m frame_len, void* data, uint32_m* frames_read);
+
+				// @DOCLINE The given data must be large enough to hold `frame_len` frames in the [FLAC audio format's](#get-flac-audio-format) corresponding type. `frames_read` is set to the amount of frames read, which is only less than `frame_len` once the end of the file is reached. Frames are read in order; frames decoded from a FLAC frame but not yet read are kept for the next call.
+
+				// @DOCLINE Every FLAC frame is checked against its CRCs while decoding, returning `MUAF_INVALID_FLAC_FRAME` if either check fails; the MD5 checksum in streaminfo is not checked. A FLAC reader can only be read from by one thread at a time.
+
+			// @DOCLINE ### Get FLAC audio format
+
+				// @DOCLINE The function `mu_get_FLAC_audio_format` returns the [audio format](#audio-formats) that a FLAC reader decodes audio data into, defined below: @NLNT
+				MUDEF muafAudioFormat mu_get_FLAC_audio_format(muFLACProfile* profile);
+
+				// @DOCLINE This is the smallest of `MUAF_FORMAT_PCM_S8`, `MUAF_FORMAT_PCM_S16`, `MUAF_FORMAT_PCM_S24`, or `MUAF_FORMAT_PCM_S32` that fits the FLAC file's bits per sample; if the bits per sample isn't a multiple of 8, samples are shifted up to fill the format's samples.
+
+		// @DOCLINE ## FLAC profile
 
 			// @DOCLINE A FLAC file's profile can be retrieved with the function `mu_get_FLAC_profile`, defined below: @NLNT
 			MUDEF muafResult mu_get_FLAC_profile(const char* filename, muFLACProfile* profile);
@@ -1176,6 +1813,12 @@ Overall, muaf is okay with files not strictly complying with the specification w
 			// @DOCLINE Once retrieved, the profile must be deallocated at some point using the functino `mu_free_FLAC_profile`, defined below: @NLNT
 			MUDEF void mu_free_FLAC_profile(muFLACProfile* profile);
 
+			// @DOCLINE A profile can also be retrieved with a given [allocator](#allocators) using the function `mu_get_FLAC_profile_with_allocator`, defined below: @NLNT
+			MUDEF muafResult mu_get_FLAC_profile_with_allocator(const char* filename, muFLACProfile* profile, const muafAllocator* allocator);
+
+			// @DOCLINE A profile retrieved this way must be deallocated with the same allocator using the function `mu_free_FLAC_profile_with_allocator`, defined below: @NLNT
+			MUDEF void mu_free_FLAC_profile_with_allocator(muFLACProfile* profile, const muafAllocator* allocator);
+
 			// @DOCLINE The struct `muFLACProfile` represents the audio file profile of a FLAC file, and has the following members:
 			struct muFLACProfile {
 				// @DOCLINE * `@NLFT contains_audio` - whether or not the given FLAC file has any audio data stored in it.
@@ -1237,57 +1880,439 @@ Overall, muaf is okay with files not strictly complying with the specification w
 
 				// @DOCLINE Metadata blocks that don't have any of these block types are still loaded by muaf (besides any forbidden values), and muaf does not provide a built-in way to read the values from all of these block types; these defined values are provided purely for convenience, and are copied directly from the specification.
 
-	// @DOCLINE # Result
+	// @DOCLINE # Audio file profiles
 
-		// @DOCLINE The type `muafResult` (typedef for `uint32_m`) is defined to represent how a task went. Result values can be "fatal" (meaning that the task completely failed to execute, and the program will continue as if the task had never been attempted), "non-fatal" (meaning that the task partially failed, but was still able to complete the task), and "successful" (meaning that the task fully succeeded as intended).
+		// @DOCLINE This section covers the functionality for retrieving the profile of an audio file without knowing its [audio file format](#audio-file-formats) ahead of time.
 
-		// @DOCLINE ## Result values
+		typedef union muAudioFileSpecificProfile muAudioFileSpecificProfile;
+		typedef struct muAudioFileProfile muAudioFileProfile;
 
-			// @DOCLINE The following values are defined for `muafResult` (all values not explicitly stated as being fatal, non-fatal, or successful are assumed to be fatal).
+		// @DOCLINE The struct `muAudioFileProfile` represents the profile of an audio file of any supported audio file format, and has the following members:
+		struct muAudioFileProfile {
+			// @DOCLINE * `@NLFT format` - the [audio file format](#audio-file-formats) of the file.
+			muafFileFormat format;
+			// @DOCLINE * `muAudioFileSpecificProfile specific` - the profile for the file's audio file format; `specific.wave` is the [WAVE profile](#wave-profile) if `format` is `MUAF_WAVE`, and `specific.flac` is the [FLAC profile](#flac-profile) if `format` is `MUAF_FLAC`.
+			union muAudioFileSpecificProfile {
+				muWAVEProfile wave;
+				muFLACProfile flac;
+			} specific;
+		};
 
-			// @DOCLINE ### General result values
-			// 0 -> 1023 //
+		// @DOCLINE The profile of an audio file can be retrieved with the function `mu_get_audio_file_profile`, defined below: @NLNT
+		MUDEF muafResult mu_get_audio_file_profile(const char* filename, muAudioFileProfile* profile);
 
-				// @DOCLINE * `MUAF_SUCCESS` - the task was successfully completed; real value 0.
-				#define MUAF_SUCCESS 0
-				// @DOCLINE * `MUAF_FAILED_MALLOC` - a vital call to `malloc` failed.
-				#define MUAF_FAILED_MALLOC 1
-				// @DOCLINE * `MUAF_FAILED_OPEN_FILE` - an attempt to open the file failed.
-				#define MUAF_FAILED_OPEN_FILE 2
-				// @DOCLINE * `MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION` - an attempt to retrieve/write information from/to an audio file failed, as the assumed file format was not the case (such as trying to get the profile of a WAVE file using `mu_get_WAVE_profile` when the file in question doesn't appear to actually be a WAVE file).
-				#define MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION 3
-				// @DOCLINE * `MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT` - the file is in an audio format that muaf does not support for the given task.
-				#define MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT 4
-				// @DOCLINE * `MUAF_FAILED_CREATE_FILE` - an attempt to create the file failed.
-				#define MUAF_FAILED_CREATE_FILE 5
-				// @DOCLINE * `MUAF_FAILED_REALLOC` - a vital call to `realloc` failed.
-				#define MUAF_FAILED_REALLOC 6
+		// @DOCLINE This function identifies the audio file format of the file the same way as [`mu_audio_file_format`](#get-audio-file-format), and then retrieves the profile for that audio file format. If the file is neither WAVE nor FLAC, `MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION` is returned. The file is only opened once, and the first `MUAF_HEADER_PREFIX_SIZE` bytes of the file (an overridable macro defined as 4096 by default) are read at once, from which the file format is identified and as much of the profile as possible is retrieved, meaning that most files only need a single read to be profiled.
+		#ifndef MUAF_HEADER_PREFIX_SIZE
+			#define MUAF_HEADER_PREFIX_SIZE 4096
+		#endif
 
-			// @DOCLINE ### WAVE result values
-			// 1024 -> 2047 //
+		// @DOCLINE Once retrieved, an audio file profile must be deallocated at some point using the function `mu_free_audio_file_profile`, defined below: @NLNT
+		MUDEF void mu_free_audio_file_profile(muAudioFileProfile* profile);
 
-				// @DOCLINE * `MUAF_INVALID_WAVE_CHUNK_LENGTH_FOR_FILE` - a WAVE chunk has a recorded length that is out of range for the file's actual length.
-				#define MUAF_INVALID_WAVE_CHUNK_LENGTH_FOR_FILE 1024
-				// @DOCLINE * `MUAF_INVALID_WAVE_MISSING_FMT` - the required WAVE chunk fmt-ck was not found.
-				#define MUAF_INVALID_WAVE_MISSING_FMT 1025
-				// @DOCLINE * `MUAF_INVALID_WAVE_MISSING_WAVE_DATA` - the required WAVE chunk wave-data was not found.
-				#define MUAF_INVALID_WAVE_MISSING_WAVE_DATA 1026
-				// @DOCLINE * `MUAF_INVALID_WAVE_FMT_LENGTH` - the WAVE chunk fmt-ck has an invalid recorded length.
-				#define MUAF_INVALID_WAVE_FMT_LENGTH 1027
-				// @DOCLINE * `MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE` - the WAVE chunk fmt-ck's PCM-format-specific value 'wBitsPerSample' has an invalid value; it's rather equal to 0, non-divisible by 8 without a remainder, doesn't evenly divide the length of the wave data, or doesn't align with the value for wBlockAlign.
-				#define MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE 1028
-				// @DOCLINE * `MUAF_INVALID_WAVE_FMT_CHANNELS` - the WAVE chunk fmt-ck's value 'wChannels' has an invalid value of 0.
-				#define MUAF_INVALID_WAVE_FMT_CHANNELS 1029
-				// @DOCLINE * `MUAF_INVALID_WAVE_FMT_SAMPLES_PER_SEC` - the WAVE chunk fmt-ck's value 'dwSamplesPerSec' has an invalid value of 0.
-				#define MUAF_INVALID_WAVE_FMT_SAMPLES_PER_SEC 1030
-				// @DOCLINE * `MUAF_INVALID_WAVE_FILE_WRITE_SIZE` - the WAVE file could not be created, as the size of the WAVE file would be over the maximum file size of a WAVE file due to any of the limitations of how big certain values can be encoded in WAVE (such as the ckSize for the RIFF chunk).
-				#define MUAF_INVALID_WAVE_FILE_WRITE_SIZE 1031
+		// @DOCLINE An audio file profile can also be retrieved with a given [allocator](#allocators) using the function `mu_get_audio_file_profile_with_allocator`, defined below: @NLNT
+		MUDEF muafResult mu_get_audio_file_profile_with_allocator(const char* filename, muAudioFileProfile* profile, const muafAllocator* allocator);
 
-			// @DOCLINE ### FLAC result values
-			// 2048 -> 3071 //
+		// @DOCLINE A profile retrieved this way must be deallocated with the same allocator using the function `mu_free_audio_file_profile_with_allocator`, defined below: @NLNT
+		MUDEF void mu_free_audio_file_profile_with_allocator(muAudioFileProfile* profile, const muafAllocator* allocator);
 
-				// @DOCLINE * `MUAF_INVALID_FLAC_STREAMINFO_LENGTH` - the streaminfo metadata block has an invalid recorded length (not 34 bytes).
-				#define MUAF_INVALID_FLAC_STREAMINFO_LENGTH 2048
+		// @DOCLINE ## Profile batches
+
+			typedef struct muProfileBatch muProfileBatch;
+
+			// @DOCLINE A profile batch is used to retrieve the profiles of many audio files, split up across however many threads the user wants to use. The struct `muProfileBatch` represents a profile batch, and has the following members:
+			struct muProfileBatch {
+				// @DOCLINE * `@NLFT file_count` - the amount of files in the batch.
+				size_m file_count;
+				// @DOCLINE * `const char** filenames` - the filenames of each file in the batch.
+				const char** filenames;
+				// @DOCLINE * `@NLFT next_file` - the index of the next file to be profiled. This is used internally, and should not be filled in by the user.
+				size_m next_file;
+				// @DOCLINE * `@NLFT* allocator` - the [allocator](#allocators) used for each profile, which is set to 0 by `mu_init_profile_batch`, and can be set by the user afterwards.
+				const muafAllocator* allocator;
+			};
+
+			// @DOCLINE A profile batch is initialized with the function `mu_init_profile_batch`, defined below: @NLNT
+			MUDEF void mu_init_profile_batch(muProfileBatch* batch, size_m file_count, const char** filenames);
+
+			// @DOCLINE The given filenames must stay valid for as long as the batch is being processed.
+
+			// @DOCLINE ### Process profile batch
+
+				typedef void (*muProfileBatchCallback)(void* user, size_m file, muafResult result, muAudioFileProfile* profile);
+
+				// @DOCLINE The function `mu_process_profile_batch` retrieves the profiles of files in a profile batch until every file in the batch has been claimed, defined below: @NLNT
+				MUDEF size_m mu_process_profile_batch(muProfileBatch* batch, muProfileBatchCallback callback, void* user);
+
+				// @DOCLINE Every time the profile of a file is done being retrieved, `callback` is called with the given `user` pointer, the index of the file within the batch, the result of retrieving the profile, and the profile itself. If the result is fatal, the profile shouldn't be used and doesn't need to be freed; otherwise, the callback takes ownership of the profile (which can be copied by value elsewhere) and it must be freed at some point using `mu_free_audio_file_profile_with_allocator`. This function returns the amount of files that were profiled by this call.
+
+				// @DOCLINE `mu_process_profile_batch` can be called by multiple threads at once on the same batch, in which case each thread claims the next unprofiled file in the batch as soon as it is done with its last one (synchronizing using [atomic operations](#atomic-operations)), meaning that the callback is called in the order that profiles are completed, which is not necessarily the order of the files within the batch. The callback can be called by multiple threads at once in this case. A profile batch can be reused by initializing it again once every call to process it has returned.
+
+				// @DOCLINE Each file is profiled the same way as [`mu_get_audio_file_profile_with_allocator`](#audio-file-profiles), using the batch's allocator, which must then be given when freeing the profiles. The allocator must be thread-safe if the batch is processed by multiple threads at once, which [arenas](#arenas) are not.
+
+		// @DOCLINE ## Catalog scans
+
+			typedef struct muCatalogScan muCatalogScan;
+
+			// @DOCLINE A catalog scan walks a directory tree and retrieves the basic information of every file in it, split up across however many threads the user wants to use, for cataloging large libraries of audio files without listing them beforehand. The type `muCatalogScan` is an opaque struct representing a catalog scan, which is created with the function `mu_create_catalog_scan`, defined below: @NLNT
+			MUDEF muafResult mu_create_catalog_scan(const char* root, size_m worker_count, muCatalogScan** scan);
+
+			// @DOCLINE `root` is the path of the directory to scan, which is copied by the scan. `worker_count` is the amount of workers that the scan is split up across, and must be at least 1; each worker is processed by one thread at a time. Once created successfully, the scan must be destroyed at some point using the function `mu_destroy_catalog_scan`, defined below: @NLNT
+			MUDEF void mu_destroy_catalog_scan(muCatalogScan* scan);
+
+			// @DOCLINE A scan can only be processed once, and must not be destroyed while any thread is processing it.
+
+			// @DOCLINE ### Catalog entries
+
+				typedef struct muCatalogEntry muCatalogEntry;
+
+				// @DOCLINE The struct `muCatalogEntry` represents the information retrieved for a file in a catalog scan, and has the following members:
+				struct muCatalogEntry {
+					// @DOCLINE * `@NLFT* path` - the path of the file, made up of the scan's root followed by the names of each directory leading to the file.
+					const char* path;
+					// @DOCLINE * `@NLFT file_format` - the [audio file format](#audio-file-formats) of the file, or `MUAF_UNKNOWN` if it's neither WAVE nor FLAC.
+					muafFileFormat file_format;
+					// @DOCLINE * `@NLFT audio_format` - the [audio format](#audio-formats) of the file's audio data, or `MUAF_FORMAT_UNKNOWN` if it isn't a supported one.
+					muafAudioFormat audio_format;
+					// @DOCLINE * `@NLFT channels` - the amount of channels in the file's audio data.
+					uint16_m channels;
+					// @DOCLINE * `@NLFT sample_rate` - the sample rate of the file's audio data, in frames per second.
+					uint32_m sample_rate;
+					// @DOCLINE * `@NLFT frames` - the amount of frames in the file's audio data.
+					uint64_m frames;
+					// @DOCLINE * `@NLFT result` - the result of retrieving the file's [profile](#audio-file-profiles); if it's fatal, the members above besides `path` and `file_format` are 0.
+					muafResult result;
+				};
+
+				// @DOCLINE Every regular file in the tree gets an entry, including files that aren't audio files (which have a `file_format` of `MUAF_UNKNOWN` and a result of `MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION`), so the callback can pick out which files it cares about. A directory that can't be opened (or a file or directory whose type can't be retrieved) also gets an entry, with a `file_format` of `MUAF_UNKNOWN` and a result of `MUAF_FAILED_OPEN_FILE`, and a file or directory that couldn't be queued (or whose path couldn't be allocated, in which case the entry's `path` is only its name) gets an entry with a result of `MUAF_FAILED_MALLOC`, so every file and directory found is accounted for. Symbolic links are skipped (so a tree whose links form a cycle is still only scanned once), along with any other file that isn't a regular file or directory.
+
+			// @DOCLINE ### Process catalog scan
+
+				typedef void (*muCatalogScanCallback)(void* user, size_m worker, const muCatalogEntry* entry);
+
+				// @DOCLINE The function `mu_process_catalog_scan` processes a catalog scan as one of its workers until the whole tree has been scanned, defined below: @NLNT
+				MUDEF size_m mu_process_catalog_scan(muCatalogScan* scan, size_m worker, muCatalogScanCallback callback, void* user);
+
+				// @DOCLINE `worker` is the index of the worker being processed, which must be less than the scan's worker count, and must not be processed by more than one thread at once. Every time a file has been profiled, `callback` is called with the given `user` pointer, the index of the worker, and the file's entry, which (along with its path) is only valid for the duration of the callback. This function returns the amount of entries that were reported by this call.
+
+				// @DOCLINE Each worker has its own queue of directories and files waiting to be scanned; the files and subdirectories found by listing a directory are added to the queue of the worker that listed it, which takes the most recently added item from its own queue first. Once a worker's queue is empty, it steals the least recently added item from another worker's queue (which is usually a directory high up in the tree, and therefore a large amount of work), so work is spread across every worker being processed even if the tree is very unbalanced, and a single directory holding a huge amount of files is still profiled by every worker at once. The queues are synchronized using [atomic operations](#atomic-operations), and a worker with nothing to steal waits for the other workers using `MUAF_YIELD()`, an overridable macro that gives up the rest of the thread's time slice, which uses `sched_yield` on Linux and `SwitchToThread` on Windows, and does nothing otherwise.
+
+				// @DOCLINE Since work is only ever added to the queues of workers that are processing the scan, it isn't necessary for every worker to be processed; for example, a scan created with 8 workers can be processed by only calling `mu_process_catalog_scan` for worker 0, which scans the whole tree on one thread. Every call returns once the whole tree has been scanned by all of the calls together. The callback can be called by multiple threads at once if multiple workers are processed at once.
+
+				// @DOCLINE Each file is profiled the same way as [`mu_get_audio_file_profile`](#audio-file-profiles), using an [arena](#arenas) kept by each worker, which is reset after each file, so profiling a file doesn't allocate any memory once the worker's arena has grown large enough. Directories are listed with `opendir` and `readdir` on Linux (see [directory dependencies](#directory-dependencies)), and `FindFirstFileA` and `FindNextFileA` on Windows; on any other platform, no directory can be listed, so the root gets an entry with a result of `MUAF_FAILED_OPEN_FILE`.
+
+			// @DOCLINE ### Catalog scan statistics
+
+				typedef struct muCatalogStats muCatalogStats;
+
+				// @DOCLINE The struct `muCatalogStats` reports how much work a catalog scan has done, and has the following members:
+				struct muCatalogStats {
+					// @DOCLINE * `@NLFT directories` - the amount of directories listed.
+					size_m directories;
+					// @DOCLINE * `@NLFT files` - the amount of files profiled.
+					size_m files;
+					// @DOCLINE * `@NLFT audio_files` - the amount of files whose profiles were retrieved successfully.
+					size_m audio_files;
+					// @DOCLINE * `@NLFT failed` - the amount of entries reported with a fatal result, including files that aren't audio files and directories that couldn't be opened.
+					size_m failed;
+					// @DOCLINE * `@NLFT bytes` - the total size of the files profiled, in bytes.
+					uint64_m bytes;
+					// @DOCLINE * `@NLFT steals` - the amount of directories and files that a worker took from another worker's queue.
+					size_m steals;
+				};
+
+				// @DOCLINE The statistics of a catalog scan are retrieved with the function `mu_get_catalog_scan_stats`, defined below: @NLNT
+				MUDEF void mu_get_catalog_scan_stats(muCatalogScan* scan, muCatalogStats* stats);
+
+				// @DOCLINE This function can be called while the scan is being processed (such as from the callback, to report progress), in which case each value is loaded atomically, but the values aren't necessarily from the same moment as each other. muaf does not measure time itself; throughput can be calculated by timing the processing of the scan and dividing these values by the time taken.
+
+	// @DOCLINE # Transcoding
+
+		// @DOCLINE This section covers the functionality for transcoding audio data between audio file formats. Transcoding is performed one block of frames at a time, reading from the source file and writing to the destination file as it goes, so only one block of audio data is held in memory at once no matter how long the audio is.
+
+		typedef struct muTranscodeStats muTranscodeStats;
+
+		// @DOCLINE ## Transcoding statistics
+
+			// @DOCLINE The struct `muTranscodeStats` is filled in by the transcoding functions to report how much work was done, and has the following members:
+			struct muTranscodeStats {
+				// @DOCLINE * `@NLFT frames` - the amount of frames transcoded.
+				uint64_m frames;
+				// @DOCLINE * `@NLFT blocks` - the amount of blocks transcoded (FLAC frames encoded or decoded).
+				size_m blocks;
+				// @DOCLINE * `@NLFT read_bytes` - the amount of audio data bytes read from the source file.
+				size_m read_bytes;
+				// @DOCLINE * `@NLFT written_bytes` - the amount of audio data bytes written to the destination file.
+				size_m written_bytes;
+			};
+
+			// @DOCLINE muaf does not measure time itself; throughput can be calculated by timing the call to the transcoding function and dividing these values by the time taken.
+
+		// @DOCLINE ## Transcode WAVE to FLAC
+
+			// @DOCLINE The function `mu_transcode_WAVE_to_FLAC` encodes a WAVE file encoded in PCM into a new FLAC file, defined below: @NLNT
+			MUDEF muafResult mu_transcode_WAVE_to_FLAC(const char* src_filename, muWAVEProfile* profile, const char* dst_filename, uint16_m block_size, muTranscodeStats* stats);
+
+			// @DOCLINE The given and already loaded [WAVE profile](#wave-profile) must have an audio format of `MUAF_FORMAT_PCM_U8`, `MUAF_FORMAT_PCM_S16`, `MUAF_FORMAT_PCM_S24`, or `MUAF_FORMAT_PCM_S32`, 1 to 8 channels, and a sample rate that FLAC can store (under 1048576). The FLAC file uses the same sample rate, channels, and bits per sample as the WAVE file (with 8-bit unsigned samples stored as 8-bit signed samples), and its streaminfo metadata block is filled in completely, including the MD5 checksum of the audio data.
+
+			// @DOCLINE `block_size` is the amount of frames in each block (each FLAC frame), and must be 0 or within the range of 16 to 65535; if it's 0, the value of the overridable macro `MUAF_FLAC_DEFAULT_BLOCK_SIZE` is used, defined below: @NLNT
+			#ifndef MUAF_FLAC_DEFAULT_BLOCK_SIZE
+				#define MUAF_FLAC_DEFAULT_BLOCK_SIZE 4096
+			#endif
+
+			// @DOCLINE Each block is encoded with the constant, verbatim, or fixed prediction subframe (whichever is smallest), with its residual split into Rice-coded partitions; stereo blocks (besides 32-bit) also pick whichever stereo decorrelation mode is smallest.
+
+			// @DOCLINE `stats` is filled in with [transcoding statistics](#transcoding-statistics) if it's not 0.
+
+		// @DOCLINE ## Transcode FLAC to WAVE
+
+			// @DOCLINE The function `mu_transcode_FLAC_to_WAVE` decodes a FLAC file into a new WAVE file encoded in PCM, defined below: @NLNT
+			MUDEF muafResult mu_transcode_FLAC_to_WAVE(const char* src_filename, muFLACProfile* profile, const char* dst_filename, muTranscodeStats* stats);
+
+			// @DOCLINE The given [FLAC profile](#flac-profile) must already be loaded. The WAVE file uses the same sample rate and channels as the FLAC file, and the smallest of `MUAF_FORMAT_PCM_U8`, `MUAF_FORMAT_PCM_S16`, `MUAF_FORMAT_PCM_S24`, or `MUAF_FORMAT_PCM_S32` that fits the FLAC file's bits per sample; if the bits per sample isn't a multiple of 8, samples are shifted up to fill the WAVE sample. The WAVE file's amount of frames can't go over `0xFFFFFFFF`.
+
+			// @DOCLINE Every FLAC frame is checked against its CRCs while decoding, and the decoded audio data is checked against the MD5 checksum in streaminfo (unless it's 0, meaning that it was not calculated). If any of these checks fail, `MUAF_INVALID_FLAC_FRAME` or `MUAF_INVALID_FLAC_CHECKSUM` is returned, and the WAVE file should be considered incomplete.
+
+			// @DOCLINE The FLAC file is read through a buffer whose initial size in bytes is the overridable macro `MUAF_FLAC_READ_BUFFER_SIZE`, defined below: @NLNT
+			#ifndef MUAF_FLAC_READ_BUFFER_SIZE
+				#define MUAF_FLAC_READ_BUFFER_SIZE 65536
+			#endif
+
+			// @DOCLINE The buffer grows if a single FLAC frame doesn't fit in it.
+
+			// @DOCLINE `stats` is filled in with [transcoding statistics](#transcoding-statistics) if it's not 0.
+
+	// @DOCLINE # Peak overviews
+
+		// @DOCLINE A peak overview summarizes audio data at several levels of detail, storing the minimum, maximum, and RMS of each channel for each bin of frames, so that a waveform can be drawn at any zoom level without reading the audio data again. A peak overview is generated from an audio file in a single pass and stored in its own file (a "sidecar" file), which can be loaded and queried later.
+
+		typedef struct muPeaks muPeaks;
+		typedef struct muPeaksLevel muPeaksLevel;
+		typedef struct muPeak muPeak;
+
+		// @DOCLINE ## Create WAVE peak overview
+
+			// @DOCLINE The function `mu_create_WAVE_peaks` generates a peak overview of a WAVE file encoded in PCM and writes it to a new sidecar file, defined below: @NLNT
+			MUDEF muafResult mu_create_WAVE_peaks(const char* filename, muWAVEProfile* profile, uint16_m level_count, const uint32_m* bin_sizes, const char* peaks_filename);
+
+			// @DOCLINE The given and already loaded [WAVE profile](#wave-profile) must have a [PCM audio format](#is-audio-format-pcm) supported by WAVE. `bin_sizes` is an array of `level_count` amounts of frames per bin, one for each level, in ascending order; each bin size must be over 0 and a multiple of the one before it, otherwise `MUAF_INVALID_PEAKS_BIN_SIZE` is returned. If `bin_sizes` is 0, three levels with bin sizes of 256, 4096, and 65536 are used, and `level_count` is ignored.
+
+			// @DOCLINE The audio data is read once, in blocks of `MUAF_WAVE_READ_BLOCK_SIZE` bytes. Only the bins of the smallest bin size are calculated from the audio data; each larger level is calculated from the bins of the level below it.
+
+		// @DOCLINE ## Load peak overview
+
+			// @DOCLINE The function `mu_load_peaks` loads a peak overview from a sidecar file, defined below: @NLNT
+			MUDEF muafResult mu_load_peaks(const char* filename, muPeaks* peaks);
+
+			// @DOCLINE If the file isn't a valid sidecar file, `MUAF_INVALID_PEAKS_FILE` is returned. Once loaded, the peak overview must be deallocated at some point using the function `mu_free_peaks`, defined below: @NLNT
+			MUDEF void mu_free_peaks(muPeaks* peaks);
+
+			// @DOCLINE The struct `muPeaks` represents a loaded peak overview, and has the following members:
+			struct muPeaks {
+				// @DOCLINE * `@NLFT channels` - the number of channels.
+				uint16_m channels;
+				// @DOCLINE * `@NLFT sample_rate` - the sample rate of the audio data.
+				uint32_m sample_rate;
+				// @DOCLINE * `@NLFT num_frames` - the amount of frames in the audio data.
+				uint32_m num_frames;
+				// @DOCLINE * `@NLFT level_count` - the amount of levels.
+				uint16_m level_count;
+				// @DOCLINE * `@NLFT* levels` - an array of `level_count` levels, in ascending order of bin size.
+				muPeaksLevel* levels;
+				// @DOCLINE * `@NLFT* data` - the contents of the sidecar file. This is used internally, and should not be modified by the user.
+				muByte* data;
+			};
+
+			// @DOCLINE The struct `muPeaksLevel` represents a level of a peak overview, and has the following members:
+			struct muPeaksLevel {
+				// @DOCLINE * `@NLFT bin_size` - the amount of frames per bin.
+				uint32_m bin_size;
+				// @DOCLINE * `@NLFT bin_count` - the amount of bins, with the last bin holding less than `bin_size` frames if the amount of frames isn't a multiple of it.
+				uint32_m bin_count;
+				// @DOCLINE * `@NLFT* bins` - where the bins begin within `data`. This is used internally, and should not be modified by the user.
+				muByte* bins;
+			};
+
+		// @DOCLINE ## Query peak overview
+
+			// @DOCLINE The function `mu_query_peaks` gets the peaks of a frame range split into a given amount of bins, such as one for each pixel of a drawn waveform, defined below: @NLNT
+			MUDEF void mu_query_peaks(muPeaks* peaks, uint32_m beg_frame, uint32_m frame_len, uint32_m bin_count, muPeak* data);
+
+			// @DOCLINE The given frame range must be valid for the peak overview and hold at least 1 frame, and `bin_count` must be over 0. `data` must be large enough to hold `bin_count * peaks->channels` peaks, and is filled with the peaks of each bin, with the peaks of each channel stored one after the other for each bin (like the samples of a frame). The struct `muPeak` represents the peaks of one channel across one bin, and has the following members:
+			struct muPeak {
+				// @DOCLINE * `@NLFT min` - the lowest sample, scaled to a range of -1 to 1.
+				float min;
+				// @DOCLINE * `@NLFT max` - the highest sample, scaled to a range of -1 to 1.
+				float max;
+				// @DOCLINE * `@NLFT rms` - the root mean square of the samples, scaled to a range of 0 to 1.
+				float rms;
+			};
+
+			// @DOCLINE Each requested bin is calculated from the level with the largest bin size that still fits within it, so that only a few stored bins are looked at for each requested bin no matter how far out the zoom is. As a result, the edges of each requested bin are rounded outward to the edges of the stored bins. If requested bins are smaller than the smallest bin size, the stored bins that they fall within are used. This function never accesses the audio data or the sidecar file.
+
+		// @DOCLINE ## Peak overview sidecar format
+
+			// @DOCLINE A sidecar file stores every value as little-endian, starting with a 20-byte header:
+
+			// @DOCLINE * The 4 bytes "muPK".
+			// @DOCLINE * A 16-bit version number; currently 1.
+			// @DOCLINE * The 16-bit amount of channels.
+			// @DOCLINE * The 32-bit sample rate.
+			// @DOCLINE * The 32-bit amount of frames.
+			// @DOCLINE * The 16-bit amount of levels.
+			// @DOCLINE * 2 reserved bytes, set to 0.
+
+			// @DOCLINE This is followed by the 32-bit bin size and 32-bit bin count of each level, and then the bins of each level, one level after the other. Each bin holds, for each channel, a signed 16-bit minimum, a signed 16-bit maximum (both at full scale of a signed 16-bit sample), and an unsigned 16-bit RMS (where 65535 is full scale), making each bin 6 bytes per channel. An hour of stereo audio at 48000 Hz with the default bin sizes takes up roughly 8.6 megabytes.
+
+	// @DOCLINE # Loudness analysis
+
+		// @DOCLINE muaf can measure the loudness of audio data as defined by [ITU-R BS.1770-4](https://www.itu.int/rec/R-REC-BS.1770) and [EBU R 128](https://tech.ebu.ch/publications/r128), in a single pass over the audio data. This is done with a loudness meter, which audio data is fed into as it's read.
+
+		typedef struct muLoudnessMeter muLoudnessMeter;
+		typedef struct muLoudness muLoudness;
+
+		// @DOCLINE ## Loudness meters
+
+			// @DOCLINE The type `muLoudnessMeter` is an opaque struct representing a loudness meter. A loudness meter can be created with the function `mu_create_loudness_meter`, defined below: @NLNT
+			MUDEF muafResult mu_create_loudness_meter(uint32_m sample_rate, uint16_m channels, muLoudnessMeter** meter);
+
+			// @DOCLINE `sample_rate` must be at least 10 and no more than 0x3FFFFFFF, and `channels` must be over 0; otherwise, `MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT` is returned. Once created successfully, the meter must be destroyed at some point using the function `mu_destroy_loudness_meter`, defined below: @NLNT
+			MUDEF void mu_destroy_loudness_meter(muLoudnessMeter* meter);
+
+			// @DOCLINE Every channel is weighted equally, except for audio data with 5 channels (assumed to be L, R, C, Ls, Rs), where the last 2 channels are weighted by 1.41, and audio data with 6 channels (assumed to be L, R, C, LFE, Ls, Rs), where the LFE channel is ignored and the last 2 channels are weighted by 1.41.
+
+			// @DOCLINE A loudness meter is not meant to be used by multiple threads at once; to analyze several files at once, use a meter for each.
+
+		// @DOCLINE ## Feed loudness meter
+
+			// @DOCLINE The function `mu_feed_loudness_meter` feeds frames into a loudness meter, defined below: @NLNT
+			MUDEF muafResult mu_feed_loudness_meter(muLoudnessMeter* meter, muafAudioFormat format, uint32_m frame_len, void* data);
+
+			// @DOCLINE `format` must be a [PCM audio format](#is-audio-format-pcm), and `data` must hold `frame_len` frames in its corresponding type, with as many channels as the meter was created with. Frames must be fed in order, and can be fed in ranges of any length. The frames are processed in blocks of `MUAF_LOUDNESS_BLOCK_SIZE` frames, which is an overridable macro defined as 4096 by default.
+			#ifndef MUAF_LOUDNESS_BLOCK_SIZE
+				#define MUAF_LOUDNESS_BLOCK_SIZE 4096
+			#endif
+
+			// @DOCLINE The meter stores the loudness of every 400-millisecond and 3-second block of audio data fed into it (both updated every 100 milliseconds), taking up around 600 kilobytes for an hour of audio data, as these are needed to calculate the gated results at the end.
+
+		// @DOCLINE ## Get loudness
+
+			// @DOCLINE The function `mu_get_loudness` gets the loudness of all frames fed into a loudness meter so far, defined below: @NLNT
+			MUDEF void mu_get_loudness(muLoudnessMeter* meter, muLoudness* loudness);
+
+			// @DOCLINE This function doesn't change the meter, so more frames can still be fed into the meter afterwards. The struct `muLoudness` represents the loudness of audio data, and has the following members:
+			struct muLoudness {
+				// @DOCLINE * `@NLFT integrated` - the integrated loudness, in LUFS, gated as described in BS.1770-4. If no 400-millisecond block is above the absolute gate of -70 LUFS, this is -70.
+				double integrated;
+				// @DOCLINE * `@NLFT range` - the loudness range, in LU, as described in EBU Tech 3342.
+				double range;
+				// @DOCLINE * `@NLFT true_peak` - the highest true peak of any channel, in dBTP, measured with 4x oversampling.
+				double true_peak;
+				// @DOCLINE * `@NLFT sample_peak` - the highest sample of any channel, in dBFS.
+				double sample_peak;
+				// @DOCLINE * `@NLFT replay_gain` - the gain, in dB, needed to bring the integrated loudness to the ReplayGain 2.0 reference level of -18 LUFS.
+				double replay_gain;
+			};
+
+			// @DOCLINE Peaks of completely silent audio data are given as -200 dB. The true peak oversampling is performed with a [resample filter](#resample-filters) of quality `MUAF_RESAMPLE_QUALITY_HIGH`.
+
+		// @DOCLINE ## Analyze WAVE loudness
+
+			// @DOCLINE The function `mu_analyze_WAVE_loudness` measures the loudness of a WAVE file encoded in PCM, defined below: @NLNT
+			MUDEF muafResult mu_analyze_WAVE_loudness(const char* filename, muWAVEProfile* profile, muLoudness* loudness);
+
+			// @DOCLINE The given and already loaded [WAVE profile](#wave-profile) must have a [PCM audio format](#is-audio-format-pcm) supported by WAVE. The audio data is read once, in blocks of `MUAF_WAVE_READ_BLOCK_SIZE` bytes, and fed into a loudness meter.
+
+	// @DOCLINE # Content hashing
+
+		// @DOCLINE muaf can hash the audio data of an audio file, so that files holding the same audio can be found regardless of their audio file format or metadata. The hash is [xxHash64](https://github.com/Cyan4973/xxHash) (with a seed of 0) of the audio data in a canonical form: every sample of every frame, in order, stored as a signed little-endian integer that is as many whole bytes as the audio data's samples take up. FLAC samples whose bits per sample isn't a multiple of 8 are shifted up to fill these bytes, and unsigned 8-bit samples are shifted down to be signed. This is the same form that [transcoding](#transcoding) converts between, so a WAVE file and a FLAC file transcoded from it (or vice versa) hash the same.
+
+		// @DOCLINE ## Segment hashes
+
+			// @DOCLINE Along with the hash of the whole audio data, the hashing functions can hash each segment of a given amount of frames on its own, so that files that share only some of their audio can be found. Each segment is hashed the same way as the whole audio data, with the last segment holding less frames if the amount of frames isn't a multiple of the segment length.
+
+		// @DOCLINE ## Hash WAVE audio data
+
+			// @DOCLINE The function `mu_hash_WAVE_audio` hashes the audio data of a WAVE file encoded in PCM, defined below: @NLNT
+			MUDEF muafResult mu_hash_WAVE_audio(const char* filename, muWAVEProfile* profile, uint32_m segment_len, uint64_m* hash, uint64_m* segment_hashes);
+
+			// @DOCLINE The given and already loaded [WAVE profile](#wave-profile) must have a [PCM audio format](#is-audio-format-pcm) supported by WAVE. `hash` is set to the hash of the whole audio data if it's not 0. If `segment_len` is over 0 and `segment_hashes` is not 0, `segment_hashes` is filled with the hash of each segment of `segment_len` frames, and must be large enough to hold one hash for each segment.
+
+			// @DOCLINE The audio data of WAVE files that aren't unsigned 8-bit is already in canonical form, so it's hashed directly as it's read from the file, in blocks of `MUAF_WAVE_READ_BLOCK_SIZE` bytes, without being decoded.
+
+		// @DOCLINE ## Hash FLAC audio data
+
+			// @DOCLINE The function `mu_hash_FLAC_audio` hashes the audio data of a FLAC file, defined below: @NLNT
+			MUDEF muafResult mu_hash_FLAC_audio(const char* filename, muFLACProfile* profile, uint32_m segment_len, uint64_m* hash, uint64_m* segment_hashes);
+
+			// @DOCLINE The given [FLAC profile](#flac-profile) must already be loaded. The parameters are the same as [`mu_hash_WAVE_audio`](#hash-wave-audio-data). Each FLAC frame is decoded, checked against its CRCs (returning `MUAF_INVALID_FLAC_FRAME` if either check fails), and hashed before the next FLAC frame is decoded.
+
+	// @DOCLINE # Result
+
+		// @DOCLINE The type `muafResult` (typedef for `uint32_m`) is defined to represent how a task went. Result values can be "fatal" (meaning that the task completely failed to execute, and the program will continue as if the task had never been attempted), "non-fatal" (meaning that the task partially failed, but was still able to complete the task), and "successful" (meaning that the task fully succeeded as intended).
+
+		// @DOCLINE ## Result values
+
+			// @DOCLINE The following values are defined for `muafResult` (all values not explicitly stated as being fatal, non-fatal, or successful are assumed to be fatal).
+
+			// @DOCLINE ### General result values
+			// 0 -> 1023 //
+
+				// @DOCLINE * `MUAF_SUCCESS` - the task was successfully completed; real value 0.
+				#define MUAF_SUCCESS 0
+				// @DOCLINE * `MUAF_FAILED_MALLOC` - a vital call to `malloc` failed.
+				#define MUAF_FAILED_MALLOC 1
+				// @DOCLINE * `MUAF_FAILED_OPEN_FILE` - an attempt to open the file failed.
+				#define MUAF_FAILED_OPEN_FILE 2
+				// @DOCLINE * `MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION` - an attempt to retrieve/write information from/to an audio file failed, as the assumed file format was not the case (such as trying to get the profile of a WAVE file using `mu_get_WAVE_profile` when the file in question doesn't appear to actually be a WAVE file).
+				#define MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION 3
+				// @DOCLINE * `MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT` - the file is in an audio format that muaf does not support for the given task.
+				#define MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT 4
+				// @DOCLINE * `MUAF_FAILED_CREATE_FILE` - an attempt to create the file failed.
+				#define MUAF_FAILED_CREATE_FILE 5
+				// @DOCLINE * `MUAF_FAILED_REALLOC` - a vital call to `realloc` failed.
+				#define MUAF_FAILED_REALLOC 6
+				// @DOCLINE * `MUAF_FAILED_READ_FILE` - an attempt to read data from the file failed.
+				#define MUAF_FAILED_READ_FILE 7
+				// @DOCLINE * `MUAF_FAILED_WRITE_FILE` - an attempt to write data to the file failed.
+				#define MUAF_FAILED_WRITE_FILE 8
+				// @DOCLINE * `MUAF_INVALID_RESAMPLE_RATE` - a sample rate given for a [resample filter](#resample-filters) was 0, or a resample filter's source sample rate doesn't match the sample rate of the audio data being resampled.
+				#define MUAF_INVALID_RESAMPLE_RATE 9
+				// @DOCLINE * `MUAF_INVALID_PEAKS_BIN_SIZE` - the bin sizes given for a [peak overview](#peak-overviews) were 0, not in ascending order, or not multiples of each other.
+				#define MUAF_INVALID_PEAKS_BIN_SIZE 10
+				// @DOCLINE * `MUAF_INVALID_PEAKS_FILE` - the file is not a valid [peak overview sidecar file](#peak-overview-sidecar-format).
+				#define MUAF_INVALID_PEAKS_FILE 11
+
+			// @DOCLINE ### WAVE result values
+			// 1024 -> 2047 //
+
+				// @DOCLINE * `MUAF_INVALID_WAVE_CHUNK_LENGTH_FOR_FILE` - a WAVE chunk has a recorded length that is out of range for the file's actual length.
+				#define MUAF_INVALID_WAVE_CHUNK_LENGTH_FOR_FILE 1024
+				// @DOCLINE * `MUAF_INVALID_WAVE_MISSING_FMT` - the required WAVE chunk fmt-ck was not found.
+				#define MUAF_INVALID_WAVE_MISSING_FMT 1025
+				// @DOCLINE * `MUAF_INVALID_WAVE_MISSING_WAVE_DATA` - the required WAVE chunk wave-data was not found.
+				#define MUAF_INVALID_WAVE_MISSING_WAVE_DATA 1026
+				// @DOCLINE * `MUAF_INVALID_WAVE_FMT_LENGTH` - the WAVE chunk fmt-ck has an invalid recorded length.
+				#define MUAF_INVALID_WAVE_FMT_LENGTH 1027
+				// @DOCLINE * `MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE` - the WAVE chunk fmt-ck's PCM-format-specific value 'wBitsPerSample' has an invalid value; it's rather equal to 0, non-divisible by 8 without a remainder, doesn't evenly divide the length of the wave data, or doesn't align with the value for wBlockAlign.
+				#define MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE 1028
+				// @DOCLINE * `MUAF_INVALID_WAVE_FMT_CHANNELS` - the WAVE chunk fmt-ck's value 'wChannels' has an invalid value of 0.
+				#define MUAF_INVALID_WAVE_FMT_CHANNELS 1029
+				// @DOCLINE * `MUAF_INVALID_WAVE_FMT_SAMPLES_PER_SEC` - the WAVE chunk fmt-ck's value 'dwSamplesPerSec' has an invalid value of 0.
+				#define MUAF_INVALID_WAVE_FMT_SAMPLES_PER_SEC 1030
+				// @DOCLINE * `MUAF_INVALID_WAVE_FILE_WRITE_SIZE` - the WAVE file could not be created, as the size of the WAVE file would be over the maximum file size of a WAVE file due to any of the limitations of how big certain values can be encoded in WAVE (such as the ckSize for the RIFF chunk).
+				#define MUAF_INVALID_WAVE_FILE_WRITE_SIZE 1031
+				// @DOCLINE * `MUAF_INVALID_WAVE_CONVERSION_CHANNEL` - a WAVE conversion's channel map references a channel that the source WAVE file doesn't have.
+				#define MUAF_INVALID_WAVE_CONVERSION_CHANNEL 1032
+				// @DOCLINE * `MUAF_INVALID_WAVE_SPLICE_FORMAT` - the WAVE files given for [splicing](#wave-splicing) don't all share the same audio format, amount of channels, and sample rate, or a segment's frame range isn't within its file.
+				#define MUAF_INVALID_WAVE_SPLICE_FORMAT 1033
+				// @DOCLINE * `MUAF_INVALID_WAVE_STREAM_DEPTH` - the depth given for a [WAVE stream](#stream-pcm-wave-data) was 0.
+				#define MUAF_INVALID_WAVE_STREAM_DEPTH 1034
+
+			// @DOCLINE ### FLAC result values
+			// 2048 -> 3071 //
+
+				// @DOCLINE * `MUAF_INVALID_FLAC_STREAMINFO_LENGTH` - the streaminfo metadata block has an invalid recorded length (not 34 bytes).
+				#define MUAF_INVALID_FLAC_STREAMINFO_LENGTH 2048
 				// @DOCLINE * `MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_RANGE` - the listed minimum or maximum block size within streaminfo was not within the required value range of 16 to 65535.
 				#define MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_RANGE 2049
 				// @DOCLINE * `MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_MIN_MAX` - the listed minimum and maximum block size within streaminfo do not make sense, as the maximum is smaller than the minimum.
@@ -1311,6 +2336,10 @@ Overall, muaf is okay with files not strictly complying with the specification w
 				#define MUAF_INVALID_FLAC_DUPLICATE_SEEK_TABLE 2058
 				// @DOCLINE * `MUAF_INVALID_FLAC_DUPLICATE_VORBIS_COMMENT` - more than one vorbis comment metadata block was identified.
 				#define MUAF_INVALID_FLAC_DUPLICATE_VORBIS_COMMENT 2059
+				// @DOCLINE * `MUAF_INVALID_FLAC_FRAME` - a FLAC frame is invalid; rather it has a value that isn't permitted, doesn't match streaminfo, is cut off by the end of the file, or doesn't match its CRC.
+				#define MUAF_INVALID_FLAC_FRAME 2060
+				// @DOCLINE * `MUAF_INVALID_FLAC_CHECKSUM` - the decoded audio data doesn't match the MD5 checksum in streaminfo.
+				#define MUAF_INVALID_FLAC_CHECKSUM 2061
 
 		// @DOCLINE ## Check if result is fatal
 
@@ -1345,7 +2374,8 @@ Overall, muaf is okay with files not strictly complying with the specification w
 			!defined(MU_SEEK_SET) || \
 			!defined(mu_ftell) || \
 			!defined(mu_fputc) || \
-			!defined(mu_fwrite)
+			!defined(mu_fwrite) || \
+			!defined(mu_remove)
 
 			// @DOCLINE ## `stdio.h` dependencies
 			#include <stdio.h>
@@ -1400,11 +2430,17 @@ Overall, muaf is okay with files not strictly complying with the specification w
 				#define mu_fwrite fwrite
 			#endif
 
+			// @DOCLINE * `mu_remove` - equivalent to `remove`.
+			#ifndef mu_remove
+				#define mu_remove remove
+			#endif
+
 		#endif
 
 		#if !defined(mu_malloc) || \
 			!defined(mu_free) || \
-			!defined(mu_realloc)
+			!defined(mu_realloc) || \
+			!defined(mu_qsort)
 
 			// @DOCLINE ## `stdlib.h` dependencies
 			#include <stdlib.h>
@@ -1424,10 +2460,16 @@ Overall, muaf is okay with files not strictly complying with the specification w
 				#define mu_realloc realloc
 			#endif
 
+			// @DOCLINE * `mu_qsort` - equivalent to `qsort`.
+			#ifndef mu_qsort
+				#define mu_qsort qsort
+			#endif
+
 		#endif
 
 		#if !defined(mu_memset) || \
-			!defined(mu_memcpy)
+			!defined(mu_memcpy) || \
+			!defined(mu_strlen)
 
 			// @DOCLINE ## `string.h` dependencies
 			#include <string.h>
@@ -1442,1257 +2484,7991 @@ Overall, muaf is okay with files not strictly complying with the specification w
 				#define mu_memcpy memcpy
 			#endif
 
+			// @DOCLINE * `mu_strlen` - equivalent to `strlen`.
+			#ifndef mu_strlen
+				#define mu_strlen strlen
+			#endif
+
 		#endif
 
-	MU_CPP_EXTERN_END
-#endif /* MUAF_H */
+		#if !defined(mu_sin) || \
+			!defined(mu_sqrt) || \
+			!defined(mu_tan) || \
+			!defined(mu_pow) || \
+			!defined(mu_log10)
 
-#ifdef MUAF_IMPLEMENTATION
-	MU_CPP_EXTERN_START
+			// @DOCLINE ## `math.h` dependencies
+			#include <math.h>
 
-	/* File reading stuff */
+			// @DOCLINE * `mu_sin` - equivalent to `sin`.
+			#ifndef mu_sin
+				#define mu_sin sin
+			#endif
 
-		// Struct representing a file
-		struct muafInner_File {
-			FILE_M* fptr;
-			size_m len;
-		};
-		typedef struct muafInner_File muafInner_File;
+			// @DOCLINE * `mu_sqrt` - equivalent to `sqrt`.
+			#ifndef mu_sqrt
+				#define mu_sqrt sqrt
+			#endif
 
-		// Loads a file
-		// Returns 0 on success
-		int muafInner_LoadFile(const char* filename, muafInner_File* file) {
-			// Open file
-			file->fptr = mu_fopen(filename, "rb");
-			if (!file->fptr) {
-				return -1;
-			}
+			// @DOCLINE * `mu_tan` - equivalent to `tan`.
+			#ifndef mu_tan
+				#define mu_tan tan
+			#endif
 
-			// Read length
-			mu_fseek(file->fptr, 0L, MU_SEEK_END);
-			file->len = mu_ftell(file->fptr);
+			// @DOCLINE * `mu_pow` - equivalent to `pow`.
+			#ifndef mu_pow
+				#define mu_pow pow
+			#endif
 
-			return 0;
-		}
+			// @DOCLINE * `mu_log10` - equivalent to `log10`.
+			#ifndef mu_log10
+				#define mu_log10 log10
+			#endif
 
-		// Creates a writable file
-		// If length is 0, file is not created, but opened in a writable mode
-		int muafInner_CreateFile(const char* filename, muafInner_File* file, size_m len) {
-			// Creating
-			if (len != 0) {
-				// Create file
-				file->fptr = mu_fopen(filename, "wb");
-				if (!file->fptr) {
-					return -1;
-				}
-				// Set length
-				file->len = len;
-				mu_fseek(file->fptr, len-1, MU_SEEK_SET);
-				mu_fputc('\0', file->fptr);
-			}
+			// @DOCLINE These are only used for [resampling](#resampling), [peak overviews](#peak-overviews), and [loudness analysis](#loudness-analysis). On some platforms, using the default `math.h` dependencies requires linking with the math library (such as with `-lm`).
 
-			// Opening writable
-			else {
-				// Open file
-				file->fptr = mu_fopen(filename, "rb+");
-				if (!file->fptr) {
-					return -1;
-				}
-				// Retrieve length
-				mu_fseek(file->fptr, 0L, MU_SEEK_END);
-				file->len = mu_ftell(file->fptr);
-			}
+		#endif
 
-			return 0;
-		}
+		// @DOCLINE ## Positional reading dependencies
+
+			// @DOCLINE Objects that need to be read from or written to by multiple threads at once (such as [WAVE readers](#wave-readers) and [WAVE conversions](#wave-conversions)) access files using positional reads and writes, which don't depend on a shared file position. On Linux, this is done with POSIX, whose dependencies are only defined if `MU_LINUX` is defined and `MUAF_NO_POSITIONAL_READ` is not. On Windows (`MU_WIN32`), this is done with `ReadFile` and `WriteFile` given an offset. If neither is the case, every read and write opens its own file using the `stdio.h` dependencies.
+
+			// @DOCLINE Strict C modes (such as `-std=c99`) don't declare most of these functions unless a feature-test macro is defined (`_XOPEN_SOURCE` of at least 500, `_POSIX_C_SOURCE` of at least 200809L, or `_GNU_SOURCE`), which muaf never does itself. Once the headers below are included, muaf checks which of these functions were declared, and falls back for the ones that weren't: without `pread`, `pwrite`, `ftruncate`, and `fdatasync`, `MUAF_NO_POSITIONAL_READ` is defined; and without `_GNU_SOURCE`, `MUAF_NO_COPY_FILE_RANGE` and `MUAF_NO_FALLOCATE` are defined. Functions that are overridden by the user are assumed to be declared. The functions are never declared by muaf itself, since their declarations depend on `_FILE_OFFSET_BITS`.
+
+			#if defined(MU_LINUX) && !defined(MUAF_NO_POSITIONAL_READ)
+
+				#if !defined(mu_open) || \
+					!defined(mu_close) || \
+					!defined(mu_pread) || \
+					!defined(mu_pwrite) || \
+					!defined(mu_copy_file_range) || \
+					!defined(mu_fallocate) || \
+					!defined(mu_ftruncate) || \
+					!defined(mu_fdatasync) || \
+					!defined(mu_fcntl) || \
+					!defined(mu_lseek) || \
+					!defined(mu_posix_fadvise) || \
+					!defined(MU_O_RDONLY) || \
+					!defined(MU_O_RDWR) || \
+					!defined(MU_O_CREAT) || \
+					!defined(MU_O_TRUNC) || \
+					!defined(MU_F_GETFL) || \
+					!defined(MU_F_SETFL)
+
+					// @DOCLINE ### POSIX dependencies
+					#include <sys/types.h>
+					#include <fcntl.h>
+					#include <unistd.h>
+
+					// Fall back for functions that the C library didn't declare
+					// (glibc only reads feature-test macros once, so its own macros are checked)
+					#if defined(__GLIBC__)
+						#if !defined(__USE_UNIX98) && !defined(__USE_XOPEN2K8)
+							#define MUAF_NO_XOPEN_DECLARATIONS
+						#endif
+						#if !defined(__USE_GNU)
+							#define MUAF_NO_GNU_DECLARATIONS
+						#endif
+					#else
+						#if !defined(_GNU_SOURCE) && \
+							!(defined(_XOPEN_SOURCE) && _XOPEN_SOURCE >= 500) && \
+							!(defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200809L)
+							#define MUAF_NO_XOPEN_DECLARATIONS
+						#endif
+						#if !defined(_GNU_SOURCE)
+							#define MUAF_NO_GNU_DECLARATIONS
+						#endif
+					#endif
+					#if defined(MUAF_NO_XOPEN_DECLARATIONS) && \
+						(!defined(mu_pread) || !defined(mu_pwrite) || !defined(mu_ftruncate) || !defined(mu_fdatasync))
+						#define MUAF_NO_POSITIONAL_READ
+					#endif
+					#if defined(MUAF_NO_GNU_DECLARATIONS) && !defined(mu_copy_file_range) && !defined(MUAF_NO_COPY_FILE_RANGE)
+						#define MUAF_NO_COPY_FILE_RANGE
+					#endif
+					#if defined(MUAF_NO_GNU_DECLARATIONS) && !defined(mu_fallocate) && !defined(MUAF_NO_FALLOCATE)
+						#define MUAF_NO_FALLOCATE
+					#endif
+					#undef MUAF_NO_XOPEN_DECLARATIONS
+					#undef MUAF_NO_GNU_DECLARATIONS
 
-		// Deloads a file
-		void muafInner_DeloadFile(muafInner_File* file) {
-			mu_fclose(file->fptr);
-		}
+					// @DOCLINE * `mu_open` - equivalent to `open`.
+					#ifndef mu_open
+						#define mu_open open
+					#endif
 
-		// Loads data from a file
-		void muafInner_LoadFromFile(muafInner_File* file, size_m index, size_m len, muByte* data) {
-			// Set to spot
-			mu_fseek(file->fptr, index, MU_SEEK_SET);
-			// Read data
-			mu_fread(data, len, 1, file->fptr);
-		}
+					// @DOCLINE * `mu_close` - equivalent to `close`.
+					#ifndef mu_close
+						#define mu_close close
+					#endif
 
-		// Writes data to a file
-		void muafInner_WriteToFile(muafInner_File* file, size_m index, size_m len, muByte* data) {
-			// Set to spot
-			mu_fseek(file->fptr, index, MU_SEEK_SET);
-			// Write to file
-			mu_fwrite((const void*)data, 1, len, file->fptr);
-		}
+					// @DOCLINE * `mu_pread` - equivalent to `pread`.
+					#ifndef mu_pread
+						#define mu_pread pread
+					#endif
 
-	/* WAVE */
+					// @DOCLINE * `mu_pwrite` - equivalent to `pwrite`.
+					#ifndef mu_pwrite
+						#define mu_pwrite pwrite
+					#endif
 
-		/* Enum/Misc. functions */
+					// @DOCLINE * `mu_copy_file_range` - equivalent to `copy_file_range`; only used by [splicing](#wave-splicing), and can be disabled by defining `MUAF_NO_COPY_FILE_RANGE` (such as for C libraries that don't have it); it's only declared with `_GNU_SOURCE`.
+					#if !defined(mu_copy_file_range) && !defined(MUAF_NO_COPY_FILE_RANGE)
+						#define mu_copy_file_range copy_file_range
+					#endif
 
-			// Returns whether or not given file is WAVE
-			muBool muafWAVE_IsWAVE(muafInner_File* file) {
-				// Minimum length check
-				// Includes RIFF, ckSize, and WAVE
-				if (file->len < 12) {
-					return MU_FALSE;
-				}
+					// @DOCLINE * `mu_fallocate` - equivalent to `fallocate`; only used by [WAVE wrapper allocation](#wave-wrapper-allocation), and can be disabled by defining `MUAF_NO_FALLOCATE` (such as for C libraries that don't have it); it's only declared with `_GNU_SOURCE`. `posix_fallocate` is not used, since it falls back to writing the file's contents on filesystems that don't support allocation.
+					#if !defined(mu_fallocate) && !defined(MUAF_NO_FALLOCATE)
+						#define mu_fallocate fallocate
+					#endif
+
+					// @DOCLINE * `mu_ftruncate` - equivalent to `ftruncate`.
+					#ifndef mu_ftruncate
+						#define mu_ftruncate ftruncate
+					#endif
+
+					// @DOCLINE * `mu_fdatasync` - equivalent to `fdatasync`; only used by [WAVE writer checkpoints](#wave-writer-checkpoints).
+					#ifndef mu_fdatasync
+						#define mu_fdatasync fdatasync
+					#endif
+
+					// @DOCLINE * `mu_fcntl` - equivalent to `fcntl`; only used by [page cache modes](#page-cache).
+					#ifndef mu_fcntl
+						#define mu_fcntl fcntl
+					#endif
+
+					// @DOCLINE * `mu_lseek` - equivalent to `lseek`; only used by [page cache modes](#page-cache).
+					#ifndef mu_lseek
+						#define mu_lseek lseek
+					#endif
+
+					// @DOCLINE * `mu_posix_fadvise` - equivalent to `posix_fadvise`; only used by [page cache modes](#page-cache).
+					#ifndef mu_posix_fadvise
+						#define mu_posix_fadvise posix_fadvise
+					#endif
+
+					// @DOCLINE * `MU_O_RDONLY` - equivalent to `O_RDONLY`.
+					#ifndef MU_O_RDONLY
+						#define MU_O_RDONLY O_RDONLY
+					#endif
+
+					// @DOCLINE * `MU_O_RDWR` - equivalent to `O_RDWR`.
+					#ifndef MU_O_RDWR
+						#define MU_O_RDWR O_RDWR
+					#endif
+
+					// @DOCLINE * `MU_O_CREAT` - equivalent to `O_CREAT`.
+					#ifndef MU_O_CREAT
+						#define MU_O_CREAT O_CREAT
+					#endif
+
+					// @DOCLINE * `MU_O_TRUNC` - equivalent to `O_TRUNC`.
+					#ifndef MU_O_TRUNC
+						#define MU_O_TRUNC O_TRUNC
+					#endif
+
+					// @DOCLINE * `MU_O_DIRECT` - equivalent to `O_DIRECT`, which is only defined by `fcntl.h` with `_GNU_SOURCE` on most C libraries; if it isn't defined (such as if `_GNU_SOURCE` wasn't defined before the first system header was included), `MUAF_CACHE_DIRECT` falls back to `MUAF_CACHE_DROP`.
+					#if !defined(MU_O_DIRECT) && defined(O_DIRECT)
+						#define MU_O_DIRECT O_DIRECT
+					#endif
+
+					// @DOCLINE * `MU_POSIX_FADV_DONTNEED` - equivalent to `POSIX_FADV_DONTNEED`, which isn't defined by `fcntl.h` in strict C modes without a feature-test macro; if it isn't defined, `MUAF_CACHE_DROP` falls back to `MUAF_CACHE_NORMAL`.
+					#if !defined(MU_POSIX_FADV_DONTNEED) && defined(POSIX_FADV_DONTNEED)
+						#define MU_POSIX_FADV_DONTNEED POSIX_FADV_DONTNEED
+					#endif
+
+					// @DOCLINE * `MU_F_GETFL` - equivalent to `F_GETFL`.
+					#ifndef MU_F_GETFL
+						#define MU_F_GETFL F_GETFL
+					#endif
+
+					// @DOCLINE * `MU_F_SETFL` - equivalent to `F_SETFL`.
+					#ifndef MU_F_SETFL
+						#define MU_F_SETFL F_SETFL
+					#endif
+
+				#endif
+
+			#endif
+
+		// @DOCLINE ## Directory dependencies
+
+			// @DOCLINE [Catalog scans](#catalog-scans) list directories and wait for other threads using POSIX on Linux, whose dependencies are only defined if `MU_LINUX` is defined. Like the [positional reading dependencies](#positional-reading-dependencies), `lstat` is only declared in strict C modes with a feature-test macro; if it isn't declared (and `mu_lstat` isn't overridden), or if `MUAF_NO_DIRECTORY_LISTING` is defined, catalog scans can't list directories on Linux, and report every directory as `MUAF_FAILED_OPEN_FILE`. On Windows (`MU_WIN32`), this is done with `FindFirstFileA`, `FindNextFileA`, and `SwitchToThread`.
+
+			#ifdef MU_LINUX
+
+				#if !defined(mu_opendir) || \
+					!defined(mu_readdir) || \
+					!defined(mu_closedir) || \
+					!defined(mu_lstat) || \
+					!defined(mu_sched_yield) || \
+					!defined(MU_S_ISDIR) || \
+					!defined(MU_S_ISREG)
+
+					// @DOCLINE ### POSIX directory dependencies
+					#include <sys/types.h>
+					#include <sys/stat.h>
+					#include <dirent.h>
+					#include <sched.h>
+
+					// Fall back if the C library didn't declare lstat
+					// (Checked the same way as the positional reading dependencies)
+					#if !defined(mu_lstat) && !defined(MUAF_NO_DIRECTORY_LISTING)
+						#if defined(__GLIBC__)
+							#if !defined(__USE_XOPEN_EXTENDED) && !defined(__USE_XOPEN2K)
+								#define MUAF_NO_DIRECTORY_LISTING
+							#endif
+						#elif !defined(_GNU_SOURCE) && \
+							!(defined(_XOPEN_SOURCE) && _XOPEN_SOURCE >= 500) && \
+							!(defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200809L)
+							#define MUAF_NO_DIRECTORY_LISTING
+						#endif
+					#endif
+
+					// @DOCLINE * `mu_opendir` - equivalent to `opendir`.
+					#ifndef mu_opendir
+						#define mu_opendir opendir
+					#endif
+
+					// @DOCLINE * `mu_readdir` - equivalent to `readdir`.
+					#ifndef mu_readdir
+						#define mu_readdir readdir
+					#endif
+
+					// @DOCLINE * `mu_closedir` - equivalent to `closedir`.
+					#ifndef mu_closedir
+						#define mu_closedir closedir
+					#endif
+
+					// @DOCLINE * `mu_lstat` - equivalent to `lstat`.
+					#ifndef mu_lstat
+						#define mu_lstat lstat
+					#endif
+
+					// @DOCLINE * `mu_sched_yield` - equivalent to `sched_yield`.
+					#ifndef mu_sched_yield
+						#define mu_sched_yield sched_yield
+					#endif
+
+					// @DOCLINE * `MU_S_ISDIR` - equivalent to `S_ISDIR`.
+					#ifndef MU_S_ISDIR
+						#define MU_S_ISDIR S_ISDIR
+					#endif
+
+					// @DOCLINE * `MU_S_ISREG` - equivalent to `S_ISREG`.
+					#ifndef MU_S_ISREG
+						#define MU_S_ISREG S_ISREG
+					#endif
+
+				#endif
+
+			#endif
+
+	MU_CPP_EXTERN_END
+
+	// @DOCLINE # C++ API
+
+		// @DOCLINE muaf has an optional C++17 layer over its C API, which is defined in the header if `MUAF_CPP` is defined before inclusion while compiling as C++. It's defined in the namespace `muaf`, is header-only, and doesn't throw any exceptions; every function that can fail returns a `muafResult`, the same way as the C functions it calls.
+
+		#if defined(__cplusplus) && defined(MUAF_CPP)
+
+			#include <type_traits>
+			#include <utility>
+
+			// @DOCLINE ## Spans
+
+				// @DOCLINE The C++ API reads and writes audio data through the type `muaf::span<T>`. If compiling for C++20 or higher, it is an alias for `std::span<T>`; otherwise, it's a minimal equivalent with the member functions `data` and `size`, which can be constructed from a pointer and size, an array, or any container with `data` and `size` member functions (such as `std::vector`).
+				#if (__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)) && __has_include(<span>)
+					#include <span>
+				#endif
+
+				namespace muaf {
+
+					#ifdef __cpp_lib_span
+
+						template<typename T>
+						using span = std::span<T>;
+
+					#else
+
+						template<typename T>
+						class span {
+						public:
+							constexpr span() noexcept : m_data(nullptr), m_size(0) {}
+							constexpr span(T* data, size_m size) noexcept : m_data(data), m_size(size) {}
+
+							template<size_m N>
+							constexpr span(T (&arr)[N]) noexcept : m_data(arr), m_size(N) {}
+
+							template<typename C, typename = std::enable_if_t<std::is_convertible_v<decltype(std::declval<C&>().data()), T*>>>
+							constexpr span(C& container) noexcept : m_data(container.data()), m_size(container.size()) {}
+
+							constexpr T* data() const noexcept { return m_data; }
+							constexpr size_m size() const noexcept { return m_size; }
+
+						private:
+							T* m_data;
+							size_m m_size;
+						};
+
+					#endif
+
+				}
+
+			// @DOCLINE ## Sample types
+
+				// @DOCLINE The corresponding type of an [audio format](#audio-formats) can be retrieved at compile time with `muaf::sample_type_t<format>` (for example, `muaf::sample_type_t<MUAF_FORMAT_PCM_S24>` is `int32_m`). The function `muaf::is_sample_type<T>(format)` returns whether or not `T` is the corresponding type of an audio format; this is checked on every read and write, returning `MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT` if the span's type doesn't match the file's audio format.
+				namespace muaf {
+
+					template<muafAudioFormat F> struct sample_type {};
+					template<> struct sample_type<MUAF_FORMAT_PCM_U8>  { using type = uint8_m; };
+					template<> struct sample_type<MUAF_FORMAT_PCM_S8>  { using type = int8_m;  };
+					template<> struct sample_type<MUAF_FORMAT_PCM_S16> { using type = int16_m; };
+					template<> struct sample_type<MUAF_FORMAT_PCM_S24> { using type = int32_m; };
+					template<> struct sample_type<MUAF_FORMAT_PCM_S32> { using type = int32_m; };
+					template<> struct sample_type<MUAF_FORMAT_PCM_S64> { using type = int64_m; };
+
+					template<muafAudioFormat F>
+					using sample_type_t = typename sample_type<F>::type;
+
+					template<typename T>
+					constexpr bool is_sample_type(muafAudioFormat format) noexcept {
+						switch (format) {
+							default: return false;
+							case MUAF_FORMAT_PCM_U8:  return std::is_same_v<T, uint8_m>;
+							case MUAF_FORMAT_PCM_S8:  return std::is_same_v<T, int8_m>;
+							case MUAF_FORMAT_PCM_S16: return std::is_same_v<T, int16_m>;
+							case MUAF_FORMAT_PCM_S24: case MUAF_FORMAT_PCM_S32: return std::is_same_v<T, int32_m>;
+							case MUAF_FORMAT_PCM_S64: return std::is_same_v<T, int64_m>;
+						}
+					}
+
+				}
+
+			// @DOCLINE ## C++ readers and writers
+
+				// @DOCLINE The classes `muaf::WaveReader`, `muaf::FlacReader`, and `muaf::WaveWriter` each own a [WAVE reader](#wave-readers), [FLAC reader](#flac-readers), or [WAVE writer](#wave-writers), which is closed once the object is destroyed. They are default-constructible (holding nothing), movable (leaving the moved-from object holding nothing), and not copyable. Each has the member functions `is_open`, `close`, and `handle` (which returns the underlying C object, or 0 if it holds nothing), as well as `format`, `channels`, `frames`, and `sample_rate`, describing the file's audio data.
+
+				// @DOCLINE `WaveReader::open(filename)` and `FlacReader::open(filename)` get the file's profile, open the reader, and free the profile, so no profile needs to be kept by the caller. `WaveReader::read(beg_frame, data)` reads `data.size() / channels()` frames into the span in the same way as [`mu_read_WAVE_reader`](#read-from-wave-reader), and can be called from multiple threads at once. `WaveReader::set_cache(mode, used)` calls [`mu_set_WAVE_reader_cache`](#wave-reader-cache-mode), with `used` being 0 by default. `FlacReader::read(data, frames_read)` reads the next `data.size() / channels()` frames in the same way as [`mu_read_FLAC_reader`](#read-from-flac-reader), setting `frames_read` to the amount of frames read.
+
+				// @DOCLINE `WaveWriter::create(filename, format, channels, sample_rate, frames, allocation)` [creates a WAVE file](#wave-wrapper-allocation) (with `allocation` being `MUAF_WAVE_ALLOCATION_SEEK` by default) and opens a writer to it, and `WaveWriter::open(filename, wrapper)` opens a writer to a WAVE file already created with the given wrapper. `WaveWriter::write(beg_frame, data)` writes `data.size() / channels()` frames from the span in the same way as [`mu_write_WAVE_writer`](#write-to-wave-writer), and may change the data in the span. `WaveWriter::set_buffer(buffer_size)` and `WaveWriter::flush()` call [`mu_set_WAVE_writer_buffer` and `mu_flush_WAVE_writer`](#wave-writer-buffers), `WaveWriter::set_checkpoints(checkpoint_frames)` and `WaveWriter::checkpoint()` call [`mu_set_WAVE_writer_checkpoints` and `mu_checkpoint_WAVE_writer`](#wave-writer-checkpoints), and `WaveWriter::set_cache(mode, used)` calls [`mu_set_WAVE_writer_cache`](#wave-writer-cache-mode).
+
+				// @DOCLINE Calling any of these member functions (besides `open`, `create`, and `close`) on an object that holds nothing returns `MUAF_FAILED_OPEN_FILE` without calling the C API.
+				namespace muaf {
+
+					class WaveReader {
+					public:
+						WaveReader() noexcept = default;
+						~WaveReader() { close(); }
+
+						WaveReader(const WaveReader&) = delete;
+						WaveReader& operator=(const WaveReader&) = delete;
+
+						WaveReader(WaveReader&& other) noexcept { take(other); }
+						WaveReader& operator=(WaveReader&& other) noexcept {
+							if (this != &other) {
+								close();
+								take(other);
+							}
+							return *this;
+						}
+
+						muafResult open(const char* filename) noexcept {
+							close();
+							muWAVEProfile profile;
+							muafResult res = mu_get_WAVE_profile(filename, &profile);
+							if (muaf_result_is_fatal(res)) {
+								return res;
+							}
+
+							muafResult open_res = mu_open_WAVE_reader(filename, &profile, &m_reader);
+							if (muaf_result_is_fatal(open_res)) {
+								m_reader = nullptr;
+								res = open_res;
+							} else {
+								m_format = mu_get_WAVE_audio_format(&profile);
+								m_channels = profile.channels;
+								m_frames = profile.chunks.wave_len / profile.block_align;
+								m_sample_rate = profile.samples_per_sec;
+							}
+							mu_free_WAVE_profile(&profile);
+							return res;
+						}
+
+						void close() noexcept {
+							if (m_reader) {
+								mu_close_WAVE_reader(m_reader);
+								m_reader = nullptr;
+							}
+						}
+
+						template<typename T>
+						muafResult read(uint32_m beg_frame, span<T> data) const noexcept {
+							if (!m_reader) {
+								return MUAF_FAILED_OPEN_FILE;
+							}
+							if (!is_sample_type<T>(m_format)) {
+								return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+							}
+							return mu_read_WAVE_reader(m_reader, beg_frame, (uint32_m)(data.size() / m_channels), data.data());
+						}
+
+						muafResult set_cache(muafCacheMode mode, muafCacheMode* used = nullptr) noexcept {
+							if (!m_reader) {
+								return MUAF_FAILED_OPEN_FILE;
+							}
+							return mu_set_WAVE_reader_cache(m_reader, mode, used);
+						}
+
+						bool is_open() const noexcept { return m_reader != nullptr; }
+						muWAVEReader* handle() const noexcept { return m_reader; }
+						muafAudioFormat format() const noexcept { return m_format; }
+						uint16_m channels() const noexcept { return m_channels; }
+						uint32_m frames() const noexcept { return m_frames; }
+						uint32_m sample_rate() const noexcept { return m_sample_rate; }
+
+					private:
+						void take(WaveReader& other) noexcept {
+							m_reader = std::exchange(other.m_reader, nullptr);
+							m_format = other.m_format;
+							m_channels = other.m_channels;
+							m_frames = other.m_frames;
+							m_sample_rate = other.m_sample_rate;
+						}
+
+						muWAVEReader* m_reader = nullptr;
+						muafAudioFormat m_format = MUAF_FORMAT_UNKNOWN;
+						uint16_m m_channels = 0;
+						uint32_m m_frames = 0;
+						uint32_m m_sample_rate = 0;
+					};
+
+					class FlacReader {
+					public:
+						FlacReader() noexcept = default;
+						~FlacReader() { close(); }
+
+						FlacReader(const FlacReader&) = delete;
+						FlacReader& operator=(const FlacReader&) = delete;
+
+						FlacReader(FlacReader&& other) noexcept { take(other); }
+						FlacReader& operator=(FlacReader&& other) noexcept {
+							if (this != &other) {
+								close();
+								take(other);
+							}
+							return *this;
+						}
+
+						muafResult open(const char* filename) noexcept {
+							close();
+							muFLACProfile profile;
+							muafResult res = mu_get_FLAC_profile(filename, &profile);
+							if (muaf_result_is_fatal(res)) {
+								return res;
+							}
+
+							muafResult open_res = mu_open_FLAC_reader(filename, &profile, &m_reader);
+							if (muaf_result_is_fatal(open_res)) {
+								m_reader = nullptr;
+								res = open_res;
+							} else {
+								m_format = mu_get_FLAC_audio_format(&profile);
+								m_channels = profile.num_channels;
+								m_frames = profile.num_samples;
+								m_sample_rate = profile.sample_rate;
+							}
+							mu_free_FLAC_profile(&profile);
+							return res;
+						}
+
+						void close() noexcept {
+							if (m_reader) {
+								mu_close_FLAC_reader(m_reader);
+								m_reader = nullptr;
+							}
+						}
+
+						template<typename T>
+						muafResult read(span<T> data, uint32_m& frames_read) noexcept {
+							frames_read = 0;
+							if (!m_reader) {
+								return MUAF_FAILED_OPEN_FILE;
+							}
+							if (!is_sample_type<T>(m_format)) {
+								return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+							}
+							return mu_read_FLAC_reader(m_reader, (uint32_m)(data.size() / m_channels), data.data(), &frames_read);
+						}
+
+						bool is_open() const noexcept { return m_reader != nullptr; }
+						muFLACReader* handle() const noexcept { return m_reader; }
+						muafAudioFormat format() const noexcept { return m_format; }
+						uint16_m channels() const noexcept { return m_channels; }
+						uint64_m frames() const noexcept { return m_frames; }
+						uint32_m sample_rate() const noexcept { return m_sample_rate; }
+
+					private:
+						void take(FlacReader& other) noexcept {
+							m_reader = std::exchange(other.m_reader, nullptr);
+							m_format = other.m_format;
+							m_channels = other.m_channels;
+							m_frames = other.m_frames;
+							m_sample_rate = other.m_sample_rate;
+						}
+
+						muFLACReader* m_reader = nullptr;
+						muafAudioFormat m_format = MUAF_FORMAT_UNKNOWN;
+						uint16_m m_channels = 0;
+						uint64_m m_frames = 0;
+						uint32_m m_sample_rate = 0;
+					};
+
+					class WaveWriter {
+					public:
+						WaveWriter() noexcept = default;
+						~WaveWriter() { close(); }
+
+						WaveWriter(const WaveWriter&) = delete;
+						WaveWriter& operator=(const WaveWriter&) = delete;
+
+						WaveWriter(WaveWriter&& other) noexcept { take(other); }
+						WaveWriter& operator=(WaveWriter&& other) noexcept {
+							if (this != &other) {
+								close();
+								take(other);
+							}
+							return *this;
+						}
+
+						muafResult create(const char* filename, muafAudioFormat format, uint16_m channels, uint32_m sample_rate, uint32_m frames, muWAVEAllocation allocation = MUAF_WAVE_ALLOCATION_SEEK) noexcept {
+							close();
+							muWAVEWrapper wrapper;
+							wrapper.audio_format = format;
+							wrapper.num_frames = frames;
+							wrapper.num_channels = channels;
+							wrapper.sample_rate = sample_rate;
+							muafResult res = mu_create_WAVE_wrapper_with_allocation(filename, &wrapper, allocation, nullptr);
+							if (muaf_result_is_fatal(res)) {
+								return res;
+							}
+
+							muafResult open_res = open(filename, wrapper);
+							mu_free_WAVE_wrapper(&wrapper);
+							return muaf_result_is_fatal(open_res) ? open_res : res;
+						}
+
+						muafResult open(const char* filename, muWAVEWrapper& wrapper) noexcept {
+							close();
+							muafResult res = mu_open_WAVE_writer(filename, &wrapper, &m_writer);
+							if (muaf_result_is_fatal(res)) {
+								m_writer = nullptr;
+								return res;
+							}
+							m_format = wrapper.audio_format;
+							m_channels = wrapper.num_channels;
+							m_frames = wrapper.num_frames;
+							m_sample_rate = wrapper.sample_rate;
+							return res;
+						}
+
+						void close() noexcept {
+							if (m_writer) {
+								mu_close_WAVE_writer(m_writer);
+								m_writer = nullptr;
+							}
+						}
+
+						template<typename T>
+						muafResult write(uint32_m beg_frame, span<T> data) noexcept {
+							if (!m_writer) {
+								return MUAF_FAILED_OPEN_FILE;
+							}
+							if (!is_sample_type<T>(m_format)) {
+								return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+							}
+							return mu_write_WAVE_writer(m_writer, beg_frame, (uint32_m)(data.size() / m_channels), data.data());
+						}
+
+						muafResult set_checkpoints(uint32_m checkpoint_frames) noexcept {
+							if (!m_writer) {
+								return MUAF_FAILED_OPEN_FILE;
+							}
+							return mu_set_WAVE_writer_checkpoints(m_writer, checkpoint_frames);
+						}
+
+						muafResult checkpoint() noexcept {
+							if (!m_writer) {
+								return MUAF_FAILED_OPEN_FILE;
+							}
+							return mu_checkpoint_WAVE_writer(m_writer);
+						}
+
+						muafResult set_buffer(size_m buffer_size) noexcept {
+							if (!m_writer) {
+								return MUAF_FAILED_OPEN_FILE;
+							}
+							return mu_set_WAVE_writer_buffer(m_writer, buffer_size);
+						}
+
+						muafResult flush() noexcept {
+							if (!m_writer) {
+								return MUAF_FAILED_OPEN_FILE;
+							}
+							return mu_flush_WAVE_writer(m_writer);
+						}
+
+						muafResult set_cache(muafCacheMode mode, muafCacheMode* used = nullptr) noexcept {
+							if (!m_writer) {
+								return MUAF_FAILED_OPEN_FILE;
+							}
+							return mu_set_WAVE_writer_cache(m_writer, mode, used);
+						}
+
+						bool is_open() const noexcept { return m_writer != nullptr; }
+						muWAVEWriter* handle() const noexcept { return m_writer; }
+						muafAudioFormat format() const noexcept { return m_format; }
+						uint16_m channels() const noexcept { return m_channels; }
+						uint32_m frames() const noexcept { return m_frames; }
+						uint32_m sample_rate() const noexcept { return m_sample_rate; }
+
+					private:
+						void take(WaveWriter& other) noexcept {
+							m_writer = std::exchange(other.m_writer, nullptr);
+							m_format = other.m_format;
+							m_channels = other.m_channels;
+							m_frames = other.m_frames;
+							m_sample_rate = other.m_sample_rate;
+						}
+
+						muWAVEWriter* m_writer = nullptr;
+						muafAudioFormat m_format = MUAF_FORMAT_UNKNOWN;
+						uint16_m m_channels = 0;
+						uint32_m m_frames = 0;
+						uint32_m m_sample_rate = 0;
+					};
+
+				}
+
+		#endif /* __cplusplus && MUAF_CPP */
+
+#endif /* MUAF_H */
+
+#ifdef MUAF_IMPLEMENTATION
+	MU_CPP_EXTERN_START
+
+	/* Allocators */
+
+		// Allocates memory with the given allocator (0 for default)
+		void* muafInner_Alloc(const muafAllocator* allocator, size_m size) {
+			if (allocator) {
+				return allocator->alloc(allocator->user, size);
+			}
+			return mu_malloc(size);
+		}
+
+		// Reallocates memory with the given allocator (0 for default)
+		void* muafInner_Realloc(const muafAllocator* allocator, void* ptr, size_m size) {
+			if (allocator) {
+				return allocator->realloc(allocator->user, ptr, size);
+			}
+			return mu_realloc(ptr, size);
+		}
+
+		// Frees memory with the given allocator (0 for default)
+		void muafInner_Free(const muafAllocator* allocator, void* ptr) {
+			if (allocator) {
+				allocator->free(allocator->user, ptr);
+				return;
+			}
+			mu_free(ptr);
+		}
+
+		/* Arenas */
+
+			// Struct representing a block of an arena
+			// (Followed by its data, starting at the next aligned position)
+			struct muafInner_ArenaBlock {
+				struct muafInner_ArenaBlock* next;
+				// Capacity and used amount of data
+				size_m cap;
+				size_m used;
+			};
+			typedef struct muafInner_ArenaBlock muafInner_ArenaBlock;
+
+			// Struct representing an arena
+			struct muafArena {
+				size_m block_size;
+				// First block and block currently being allocated from
+				muafInner_ArenaBlock* first;
+				muafInner_ArenaBlock* cur;
+				// Most recent allocation (0 if none)
+				muByte* last;
+			};
+
+			// Rounds size up to arena alignment
+			#define MUAF_ARENA_ALIGN(size) (((size) + (MUAF_ARENA_ALIGNMENT-1)) & ~((size_m)(MUAF_ARENA_ALIGNMENT-1)))
+
+			// Returns the data of an arena block
+			muByte* muafInner_ArenaBlockData(muafInner_ArenaBlock* block) {
+				return ((muByte*)block) + MUAF_ARENA_ALIGN(sizeof(muafInner_ArenaBlock));
+			}
+
+			// Allocates a new arena block with the given capacity
+			muafInner_ArenaBlock* muafInner_CreateArenaBlock(size_m cap) {
+				muafInner_ArenaBlock* block = (muafInner_ArenaBlock*)mu_malloc(MUAF_ARENA_ALIGN(sizeof(muafInner_ArenaBlock)) + cap);
+				if (!block) {
+					return 0;
+				}
+				block->next = 0;
+				block->cap = cap;
+				block->used = 0;
+				return block;
+			}
+
+			// Creates an arena
+			MUDEF muafResult mu_create_arena(size_m block_size, muafArena** arena) {
+				if (block_size == 0) {
+					block_size = MUAF_ARENA_BLOCK_SIZE;
+				}
+
+				muafArena* a = (muafArena*)mu_malloc(sizeof(muafArena));
+				if (!a) {
+					return MUAF_FAILED_MALLOC;
+				}
+				a->block_size = MUAF_ARENA_ALIGN(block_size);
+				a->first = muafInner_CreateArenaBlock(a->block_size);
+				if (!a->first) {
+					mu_free(a);
+					return MUAF_FAILED_MALLOC;
+				}
+				a->cur = a->first;
+				a->last = 0;
+
+				*arena = a;
+				return MUAF_SUCCESS;
+			}
+
+			// Destroys an arena
+			MUDEF void mu_destroy_arena(muafArena* arena) {
+				muafInner_ArenaBlock* block = arena->first;
+				while (block) {
+					muafInner_ArenaBlock* next = block->next;
+					mu_free(block);
+					block = next;
+				}
+				mu_free(arena);
+			}
+
+			// Frees everything allocated from an arena
+			MUDEF void mu_reset_arena(muafArena* arena) {
+				// Keep every block, just mark them as unused
+				for (muafInner_ArenaBlock* block = arena->first; block; block = block->next) {
+					block->used = 0;
+				}
+				arena->cur = arena->first;
+				arena->last = 0;
+			}
+
+			// Allocates from an arena
+			// Each allocation is preceded by its size, taking up one alignment
+			void* muafInner_ArenaAlloc(void* user, size_m size) {
+				muafArena* arena = (muafArena*)user;
+				size_m need = MUAF_ARENA_ALIGNMENT + MUAF_ARENA_ALIGN(size);
+
+				// Move onto the next block that fits
+				// (Blocks after the current one are always unused)
+				while (arena->cur->used + need > arena->cur->cap) {
+					muafInner_ArenaBlock* next = arena->cur->next;
+					if (!next || need > next->cap) {
+						// Insert a new block after the current one
+						muafInner_ArenaBlock* block = muafInner_CreateArenaBlock((need > arena->block_size) ? need : arena->block_size);
+						if (!block) {
+							return 0;
+						}
+						block->next = next;
+						arena->cur->next = block;
+						next = block;
+					}
+					arena->cur = next;
+				}
+
+				// Hand out memory after size
+				muByte* data = muafInner_ArenaBlockData(arena->cur) + arena->cur->used;
+				*(size_m*)data = size;
+				arena->cur->used += need;
+				arena->last = data + MUAF_ARENA_ALIGNMENT;
+				return arena->last;
+			}
+
+			// Frees from an arena
+			// Only does anything if it's the most recent allocation
+			void muafInner_ArenaFree(void* user, void* ptr) {
+				muafArena* arena = (muafArena*)user;
+				if (ptr == 0 || ptr != arena->last) {
+					return;
+				}
+				size_m size = *(size_m*)(arena->last - MUAF_ARENA_ALIGNMENT);
+				arena->cur->used -= MUAF_ARENA_ALIGNMENT + MUAF_ARENA_ALIGN(size);
+				arena->last = 0;
+			}
+
+			// Reallocates from an arena
+			// Grows in place if it's the most recent allocation and fits
+			void* muafInner_ArenaRealloc(void* user, void* ptr, size_m size) {
+				muafArena* arena = (muafArena*)user;
+				if (ptr == 0) {
+					return muafInner_ArenaAlloc(user, size);
+				}
+
+				size_m* old_size = (size_m*)(((muByte*)ptr) - MUAF_ARENA_ALIGNMENT);
+				if (ptr == arena->last) {
+					size_m old_need = MUAF_ARENA_ALIGNMENT + MUAF_ARENA_ALIGN(*old_size);
+					size_m new_need = MUAF_ARENA_ALIGNMENT + MUAF_ARENA_ALIGN(size);
+					if (arena->cur->used - old_need + new_need <= arena->cur->cap) {
+						arena->cur->used = arena->cur->used - old_need + new_need;
+						*old_size = size;
+						return ptr;
+					}
+				}
+
+				// Copy into a new allocation
+				void* new_ptr = muafInner_ArenaAlloc(user, size);
+				if (!new_ptr) {
+					return 0;
+				}
+				mu_memcpy(new_ptr, ptr, (*old_size < size) ? *old_size : size);
+				return new_ptr;
+			}
+
+			// Returns allocator for an arena
+			MUDEF muafAllocator mu_get_arena_allocator(muafArena* arena) {
+				muafAllocator allocator;
+				allocator.alloc = muafInner_ArenaAlloc;
+				allocator.realloc = muafInner_ArenaRealloc;
+				allocator.free = muafInner_ArenaFree;
+				allocator.user = (void*)arena;
+				return allocator;
+			}
+
+	/* Instrumentation */
+
+		#ifdef MUAF_INSTRUMENTATION
+
+			// Instrumentation currently being recorded to (0 if none)
+			muafInstrumentation* muafInner_Instrumentation = 0;
+
+			MUDEF void mu_set_instrumentation(muafInstrumentation* instrumentation) {
+				muafInner_Instrumentation = instrumentation;
+			}
+
+			// Time dependency
+			#ifndef MUAF_INSTRUMENTATION_TIME
+				#include <time.h>
+				uint64_m muafInner_InstrumentationTime(void) {
+					#if (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L) || (defined(__cplusplus) && __cplusplus >= 201703L)
+						struct timespec ts;
+						timespec_get(&ts, TIME_UTC);
+						return (((uint64_m)ts.tv_sec) * 1000000000) + ((uint64_m)ts.tv_nsec);
+					#else
+						return (uint64_m)((((double)clock()) / CLOCKS_PER_SEC) * 1000000000.0);
+					#endif
+				}
+				#define MUAF_INSTRUMENTATION_TIME() muafInner_InstrumentationTime()
+			#endif
+
+			// Begins a phase, returning the time it began
+			uint64_m muafInner_BeginPhase(muafPhase phase) {
+				muafInstrumentation* inst = muafInner_Instrumentation;
+				if (!inst) {
+					return 0;
+				}
+				uint64_m time = MUAF_INSTRUMENTATION_TIME();
+				if (inst->callback) {
+					inst->callback(inst->user, phase, MU_FALSE, time);
+				}
+				return time;
+			}
+
+			// Ends a phase given the time it began
+			void muafInner_EndPhase(muafPhase phase, uint64_m beg) {
+				muafInstrumentation* inst = muafInner_Instrumentation;
+				if (!inst) {
+					return;
+				}
+				uint64_m time = MUAF_INSTRUMENTATION_TIME();
+				MUAF_ATOMIC_ADD(&inst->stats.phase_count[phase], 1);
+				MUAF_ATOMIC_ADD64(&inst->stats.phase_time[phase], time - beg);
+				if (inst->callback) {
+					inst->callback(inst->user, phase, MU_TRUE, time);
+				}
+			}
+
+			// Adds to a statistic
+			#define MUAF_COUNT(member, n) if (muafInner_Instrumentation) { MUAF_ATOMIC_ADD(&muafInner_Instrumentation->stats.member, (size_m)(n)); }
+			#define MUAF_COUNT64(member, n) if (muafInner_Instrumentation) { MUAF_ATOMIC_ADD64(&muafInner_Instrumentation->stats.member, (n)); }
+
+			// Times a phase in the current scope
+			#define MUAF_BEGIN_PHASE(var, phase) uint64_m var = muafInner_BeginPhase(phase)
+			#define MUAF_END_PHASE(var, phase) muafInner_EndPhase(phase, var)
+
+			/* Counted stdio.h dependencies */
+
+				FILE_M* muafInner_FOpen(const char* filename, const char* mode) {
+					MUAF_BEGIN_PHASE(t, MUAF_PHASE_OPEN);
+					FILE_M* f = mu_fopen(filename, mode);
+					MUAF_END_PHASE(t, MUAF_PHASE_OPEN);
+					MUAF_COUNT(open_count, 1);
+					return f;
+				}
+
+				int muafInner_FSeek(FILE_M* stream, long offset, int whence) {
+					MUAF_COUNT(seek_count, 1);
+					return mu_fseek(stream, offset, whence);
+				}
+
+				size_m muafInner_FRead(void* ptr, size_m size, size_m nmemb, FILE_M* stream) {
+					MUAF_BEGIN_PHASE(t, MUAF_PHASE_READ);
+					size_m read = mu_fread(ptr, size, nmemb, stream);
+					MUAF_END_PHASE(t, MUAF_PHASE_READ);
+					MUAF_COUNT(read_count, 1);
+					MUAF_COUNT64(read_bytes, read * size);
+					return read;
+				}
+
+				size_m muafInner_FWrite(const void* ptr, size_m size, size_m nmemb, FILE_M* stream) {
+					MUAF_BEGIN_PHASE(t, MUAF_PHASE_WRITE);
+					size_m written = mu_fwrite(ptr, size, nmemb, stream);
+					MUAF_END_PHASE(t, MUAF_PHASE_WRITE);
+					MUAF_COUNT(write_count, 1);
+					MUAF_COUNT64(write_bytes, written * size);
+					return written;
+				}
+
+				int muafInner_FPutc(int c, FILE_M* stream) {
+					MUAF_BEGIN_PHASE(t, MUAF_PHASE_WRITE);
+					int res = mu_fputc(c, stream);
+					MUAF_END_PHASE(t, MUAF_PHASE_WRITE);
+					MUAF_COUNT(write_count, 1);
+					MUAF_COUNT64(write_bytes, (res == c) ? 1 : 0);
+					return res;
+				}
+
+		#else
+
+			// (Compiled out)
+			#define MUAF_COUNT(member, n)
+			#define MUAF_COUNT64(member, n)
+			#define MUAF_BEGIN_PHASE(var, phase)
+			#define MUAF_END_PHASE(var, phase)
+
+			#define muafInner_FOpen mu_fopen
+			#define muafInner_FSeek mu_fseek
+			#define muafInner_FRead mu_fread
+			#define muafInner_FWrite mu_fwrite
+			#define muafInner_FPutc mu_fputc
+
+		#endif
+
+	/* File reading stuff */
+
+		// Struct representing a file
+		struct muafInner_File {
+			FILE_M* fptr;
+			size_m len;
+			// Cached data from the beginning of the file (0 if none)
+			muByte* prefix;
+			size_m prefix_len;
+		};
+		typedef struct muafInner_File muafInner_File;
+
+		// Loads a file
+		// Returns 0 on success
+		int muafInner_LoadFile(const char* filename, muafInner_File* file) {
+			// Open file
+			file->fptr = muafInner_FOpen(filename, "rb");
+			if (!file->fptr) {
+				return -1;
+			}
+			file->prefix = 0;
+			file->prefix_len = 0;
+
+			// Read length
+			muafInner_FSeek(file->fptr, 0L, MU_SEEK_END);
+			file->len = mu_ftell(file->fptr);
+
+			return 0;
+		}
+
+		// Loads a file, reading its first bytes into the given buffer at once
+		// so that any reads within them don't need to access the file
+		// Returns 0 on success
+		int muafInner_LoadFilePrefix(const char* filename, muafInner_File* file, muByte* prefix, size_m prefix_len) {
+			// Open file
+			if (muafInner_LoadFile(filename, file) != 0) {
+				return -1;
+			}
+
+			// Read prefix
+			if (prefix_len > file->len) {
+				prefix_len = file->len;
+			}
+			muafInner_FSeek(file->fptr, 0L, MU_SEEK_SET);
+			if (muafInner_FRead(prefix, 1, prefix_len, file->fptr) == prefix_len) {
+				file->prefix = prefix;
+				file->prefix_len = prefix_len;
+			}
+
+			return 0;
+		}
+
+		// Creates a writable file
+		// If length is 0, file is not created, but opened in a writable mode
+		int muafInner_CreateFile(const char* filename, muafInner_File* file, size_m len) {
+			file->prefix = 0;
+			file->prefix_len = 0;
+
+			// Creating
+			if (len != 0) {
+				// Create file
+				file->fptr = muafInner_FOpen(filename, "wb");
+				if (!file->fptr) {
+					return -1;
+				}
+				// Set length
+				file->len = len;
+				muafInner_FSeek(file->fptr, len-1, MU_SEEK_SET);
+				muafInner_FPutc('\0', file->fptr);
+			}
+
+			// Opening writable
+			else {
+				// Open file
+				file->fptr = muafInner_FOpen(filename, "rb+");
+				if (!file->fptr) {
+					return -1;
+				}
+				// Retrieve length
+				muafInner_FSeek(file->fptr, 0L, MU_SEEK_END);
+				file->len = mu_ftell(file->fptr);
+			}
+
+			return 0;
+		}
+
+		// Creates a writable, empty file that's treated as having the given length
+		// Returns 0 on success
+		int muafInner_CreateEmptyFile(const char* filename, muafInner_File* file, size_m len) {
+			file->prefix = 0;
+			file->prefix_len = 0;
+
+			file->fptr = muafInner_FOpen(filename, "wb");
+			if (!file->fptr) {
+				return -1;
+			}
+			file->len = len;
+			return 0;
+		}
+
+		// Deloads a file
+		void muafInner_DeloadFile(muafInner_File* file) {
+			mu_fclose(file->fptr);
+		}
+
+		// Loads data from a file
+		void muafInner_LoadFromFile(muafInner_File* file, size_m index, size_m len, muByte* data) {
+			// Copy from prefix if it's all within it
+			if (index < file->prefix_len && len <= file->prefix_len - index) {
+				mu_memcpy(data, file->prefix + index, len);
+				return;
+			}
+
+			// Set to spot
+			muafInner_FSeek(file->fptr, index, MU_SEEK_SET);
+			// Read data
+			muafInner_FRead(data, len, 1, file->fptr);
+		}
+
+		// Writes data to a file
+		muafResult muafInner_WriteToFile(muafInner_File* file, size_m index, size_m len, muByte* data) {
+			// Set to spot
+			muafInner_FSeek(file->fptr, index, MU_SEEK_SET);
+			// Write to file
+			if (muafInner_FWrite((const void*)data, 1, len, file->fptr) != len) {
+				return MUAF_FAILED_WRITE_FILE;
+			}
+			return MUAF_SUCCESS;
+		}
+
+	/* Positional file reading stuff */
+
+		#if defined(MU_LINUX) && !defined(MUAF_NO_POSITIONAL_READ)
+
+			// Struct representing a positionally-readable file
+			struct muafInner_PFile {
+				int fd;
+				// How the file uses the page cache
+				muafCacheMode cache;
+			};
+			typedef struct muafInner_PFile muafInner_PFile;
+
+			// Opens a positionally-readable file
+			// (Also writable if 'writable' is true; file must already exist)
+			muafResult muafInner_OpenPFile(const char* filename, muBool writable, muafInner_PFile* file) {
+				MUAF_BEGIN_PHASE(t, MUAF_PHASE_OPEN);
+				file->fd = mu_open(filename, (writable) ? MU_O_RDWR : MU_O_RDONLY);
+				MUAF_END_PHASE(t, MUAF_PHASE_OPEN);
+				MUAF_COUNT(open_count, 1);
+				if (file->fd < 0) {
+					return MUAF_FAILED_OPEN_FILE;
+				}
+				file->cache = MUAF_CACHE_NORMAL;
+				return MUAF_SUCCESS;
+			}
+
+			// Closes a positionally-readable file
+			void muafInner_ClosePFile(muafInner_PFile* file) {
+				mu_close(file->fd);
+			}
+
+			// Reads data from a positionally-readable file, ignoring its cache mode
+			// Thread-safe
+			muafResult muafInner_PReadAll(int fd, size_m index, size_m len, muByte* data) {
+				// Read until all data is read, since pread can read less than requested
+				while (len > 0) {
+					MUAF_BEGIN_PHASE(t, MUAF_PHASE_READ);
+					ssize_t read_len = mu_pread(fd, data, len, (off_t)index);
+					MUAF_END_PHASE(t, MUAF_PHASE_READ);
+					MUAF_COUNT(read_count, 1);
+					if (read_len <= 0) {
+						return MUAF_FAILED_READ_FILE;
+					}
+					MUAF_COUNT64(read_bytes, read_len);
+					index += (size_m)read_len;
+					data += read_len;
+					len -= (size_m)read_len;
+				}
+				return MUAF_SUCCESS;
+			}
+
+			// Writes data to a positionally-writable file, ignoring its cache mode
+			// Thread-safe
+			muafResult muafInner_PWriteAll(int fd, size_m index, size_m len, muByte* data) {
+				// Write until all data is written, since pwrite can write less than requested
+				while (len > 0) {
+					MUAF_BEGIN_PHASE(t, MUAF_PHASE_WRITE);
+					ssize_t write_len = mu_pwrite(fd, data, len, (off_t)index);
+					MUAF_END_PHASE(t, MUAF_PHASE_WRITE);
+					MUAF_COUNT(write_count, 1);
+					if (write_len <= 0) {
+						return MUAF_FAILED_WRITE_FILE;
+					}
+					MUAF_COUNT64(write_bytes, write_len);
+					index += (size_m)write_len;
+					data += write_len;
+					len -= (size_m)write_len;
+				}
+				return MUAF_SUCCESS;
+			}
+
+			/* Direct I/O */
+
+				// Rounds down/up to the direct I/O alignment
+				#define MUAF_DIRECT_FLOOR(n) ((n) & ~((size_m)(MUAF_DIRECT_ALIGNMENT-1)))
+				#define MUAF_DIRECT_CEIL(n) MUAF_DIRECT_FLOOR((n) + (MUAF_DIRECT_ALIGNMENT-1))
+
+				// Allocates an aligned buffer for direct I/O
+				// Returns the aligned buffer, and sets 'raw' to the pointer to free
+				muByte* muafInner_AllocDirect(size_m len, muByte** raw) {
+					*raw = (muByte*)mu_malloc(len + MUAF_DIRECT_ALIGNMENT);
+					if (!*raw) {
+						return 0;
+					}
+					return *raw + ((MUAF_DIRECT_ALIGNMENT - (((size_m)*raw) % MUAF_DIRECT_ALIGNMENT)) % MUAF_DIRECT_ALIGNMENT);
+				}
+
+				// Reads an aligned block with direct I/O, zeroing what's past the end of the file
+				// ('index' and 'len' must be aligned)
+				muafResult muafInner_ReadDirectBlock(int fd, size_m index, size_m len, muByte* block) {
+					while (len > 0) {
+						MUAF_BEGIN_PHASE(t, MUAF_PHASE_READ);
+						ssize_t read_len = mu_pread(fd, block, len, (off_t)index);
+						MUAF_END_PHASE(t, MUAF_PHASE_READ);
+						MUAF_COUNT(read_count, 1);
+						if (read_len < 0) {
+							return MUAF_FAILED_READ_FILE;
+						}
+						// (Short reads only happen at the end of the file)
+						if (read_len == 0 || MUAF_DIRECT_FLOOR((size_m)read_len) != (size_m)read_len) {
+							mu_memset(block + read_len, 0, len - (size_m)read_len);
+							MUAF_COUNT64(read_bytes, read_len);
+							return MUAF_SUCCESS;
+						}
+						MUAF_COUNT64(read_bytes, read_len);
+						index += (size_m)read_len;
+						block += read_len;
+						len -= (size_m)read_len;
+					}
+					return MUAF_SUCCESS;
+				}
+
+				// Reads data from a positionally-readable file with direct I/O
+				// Thread-safe
+				muafResult muafInner_ReadPFileDirect(muafInner_PFile* file, size_m index, size_m len, muByte* data) {
+					// Allocate aligned buffer
+					size_m end = index + len;
+					size_m pos = MUAF_DIRECT_FLOOR(index);
+					size_m buf_len = MUAF_DIRECT_CEIL(end) - pos;
+					if (buf_len > MUAF_DIRECT_BLOCK_SIZE) {
+						buf_len = MUAF_DIRECT_BLOCK_SIZE;
+					}
+					muByte* raw;
+					muByte* buf = muafInner_AllocDirect(buf_len, &raw);
+					if (!buf) {
+						return MUAF_FAILED_MALLOC;
+					}
+
+					// Read each aligned block, and copy out the part that was requested
+					muafResult res = MUAF_SUCCESS;
+					while (pos < end) {
+						size_m block_len = MUAF_DIRECT_CEIL(end) - pos;
+						if (block_len > buf_len) {
+							block_len = buf_len;
+						}
+						MUAF_BEGIN_PHASE(t, MUAF_PHASE_READ);
+						ssize_t read_len = mu_pread(file->fd, buf, block_len, (off_t)pos);
+						MUAF_END_PHASE(t, MUAF_PHASE_READ);
+						MUAF_COUNT(read_count, 1);
+						if (read_len <= 0) {
+							res = MUAF_FAILED_READ_FILE;
+							break;
+						}
+						MUAF_COUNT64(read_bytes, read_len);
+
+						size_m copy_beg = (pos < index) ? (index - pos) : 0;
+						size_m copy_end = ((size_m)read_len < end - pos) ? (size_m)read_len : (end - pos);
+						// (Reading less than a whole amount of blocks means the end of the file was reached)
+						if (copy_end <= copy_beg || (copy_end < end - pos && MUAF_DIRECT_FLOOR((size_m)read_len) != (size_m)read_len)) {
+							res = MUAF_FAILED_READ_FILE;
+							break;
+						}
+						mu_memcpy(data + (pos + copy_beg - index), buf + copy_beg, copy_end - copy_beg);
+						pos += (size_m)read_len;
+					}
+
+					mu_free(raw);
+					return res;
+				}
+
+				// Writes data to a positionally-writable file with direct I/O
+				// Not thread-safe (since the blocks at the edges are read and written back)
+				muafResult muafInner_WritePFileDirect(muafInner_PFile* file, size_m index, size_m len, muByte* data) {
+					// Get length of file, to undo extending it past where the data ends
+					off_t file_len = mu_lseek(file->fd, 0, MU_SEEK_END);
+					if (file_len < 0) {
+						return MUAF_FAILED_WRITE_FILE;
+					}
+
+					// Allocate aligned buffer
+					size_m end = index + len;
+					size_m pos = MUAF_DIRECT_FLOOR(index);
+					size_m buf_len = MUAF_DIRECT_CEIL(end) - pos;
+					if (buf_len > MUAF_DIRECT_BLOCK_SIZE) {
+						buf_len = MUAF_DIRECT_BLOCK_SIZE;
+					}
+					muByte* raw;
+					muByte* buf = muafInner_AllocDirect(buf_len, &raw);
+					if (!buf) {
+						return MUAF_FAILED_MALLOC;
+					}
+
+					muafResult res = MUAF_SUCCESS;
+					while (pos < end) {
+						size_m block_len = MUAF_DIRECT_CEIL(end) - pos;
+						if (block_len > buf_len) {
+							block_len = buf_len;
+						}
+						size_m data_beg = (pos < index) ? index : pos;
+						size_m data_end = (pos + block_len < end) ? (pos + block_len) : end;
+
+						// Read the edge blocks that are only partly written over
+						if (data_beg != pos) {
+							res = muafInner_ReadDirectBlock(file->fd, pos, MUAF_DIRECT_ALIGNMENT, buf);
+						}
+						if (!muaf_result_is_fatal(res) && data_end != pos + block_len && (data_beg == pos || block_len > MUAF_DIRECT_ALIGNMENT)) {
+							res = muafInner_ReadDirectBlock(file->fd, pos + block_len - MUAF_DIRECT_ALIGNMENT, MUAF_DIRECT_ALIGNMENT, buf + block_len - MUAF_DIRECT_ALIGNMENT);
+						}
+						if (muaf_result_is_fatal(res)) {
+							break;
+						}
+
+						// Write data over them
+						mu_memcpy(buf + (data_beg - pos), data + (data_beg - index), data_end - data_beg);
+						res = muafInner_PWriteAll(file->fd, pos, block_len, buf);
+						if (muaf_result_is_fatal(res)) {
+							break;
+						}
+						pos += block_len;
+					}
+					mu_free(raw);
+
+					// Cut off the part of the last block past the real end of the file
+					if (!muaf_result_is_fatal(res)) {
+						size_m real_len = ((size_m)file_len > end) ? (size_m)file_len : end;
+						if (pos > real_len && mu_ftruncate(file->fd, (off_t)real_len) != 0) {
+							res = MUAF_FAILED_WRITE_FILE;
+						}
+					}
+					return res;
+				}
+
+			/* Cache modes */
+
+				// Sets how a positionally-readable file uses the page cache
+				// Returns the cache mode actually used
+				muafCacheMode muafInner_SetPFileCache(muafInner_PFile* file, muafCacheMode mode) {
+					int flags = mu_fcntl(file->fd, MU_F_GETFL);
+					if (flags < 0) {
+						return file->cache;
+					}
+
+					#ifdef MU_O_DIRECT
+						// Turn direct I/O on or off
+						// (Fails on filesystems that don't support it, falling back to dropping)
+						if (mode == MUAF_CACHE_DIRECT) {
+							if ((flags & MU_O_DIRECT) || mu_fcntl(file->fd, MU_F_SETFL, flags | MU_O_DIRECT) == 0) {
+								file->cache = MUAF_CACHE_DIRECT;
+								return file->cache;
+							}
+						}
+						else if ((flags & MU_O_DIRECT) && mu_fcntl(file->fd, MU_F_SETFL, flags & ~MU_O_DIRECT) != 0) {
+							return file->cache;
+						}
+					#endif
+
+					#ifdef MU_POSIX_FADV_DONTNEED
+						file->cache = (mode != MUAF_CACHE_NORMAL) ? MUAF_CACHE_DROP : MUAF_CACHE_NORMAL;
+						return file->cache;
+					#else
+						file->cache = MUAF_CACHE_NORMAL;
+						return file->cache; if (mode) {}
+					#endif
+				}
+
+				// Drops a range of a positionally-readable file from the page cache if its cache mode says to
+				// (A length of 0 means to the end of the file)
+				void muafInner_DropPFile(muafInner_PFile* file, size_m index, size_m len) {
+					#ifdef MU_POSIX_FADV_DONTNEED
+						if (file->cache == MUAF_CACHE_DROP) {
+							mu_posix_fadvise(file->fd, (off_t)index, (off_t)len, MU_POSIX_FADV_DONTNEED);
+						}
+					#else
+						return; if (file) {} if (index) {} if (len) {}
+					#endif
+				}
+
+			// Reads data from a positionally-readable file
+			// Thread-safe
+			muafResult muafInner_ReadPFile(muafInner_PFile* file, size_m index, size_m len, muByte* data) {
+				if (file->cache == MUAF_CACHE_DIRECT) {
+					return muafInner_ReadPFileDirect(file, index, len, data);
+				}
+				muafResult res = muafInner_PReadAll(file->fd, index, len, data);
+				muafInner_DropPFile(file, index, len);
+				return res;
+			}
+
+			// Writes data to a positionally-writable file
+			// Thread-safe (unless using direct I/O)
+			muafResult muafInner_WritePFile(muafInner_PFile* file, size_m index, size_m len, muByte* data) {
+				if (file->cache == MUAF_CACHE_DIRECT) {
+					return muafInner_WritePFileDirect(file, index, len, data);
+				}
+				muafResult res = muafInner_PWriteAll(file->fd, index, len, data);
+				// (Starts writing the data back, and drops whatever already was)
+				muafInner_DropPFile(file, index, len);
+				return res;
+			}
+
+			// Makes sure data written to a positionally-writable file is stored on disk
+			muafResult muafInner_SyncPFile(muafInner_PFile* file) {
+				MUAF_BEGIN_PHASE(t, MUAF_PHASE_WRITE);
+				int sync_res = mu_fdatasync(file->fd);
+				MUAF_END_PHASE(t, MUAF_PHASE_WRITE);
+				// (Everything's been written back now, so all of it can be dropped)
+				muafInner_DropPFile(file, 0, 0);
+				return (sync_res == 0) ? MUAF_SUCCESS : MUAF_FAILED_WRITE_FILE;
+			}
+
+		#elif defined(MU_WIN32) && !defined(MUAF_NO_POSITIONAL_READ)
+
+			#include <windows.h>
+
+			// Struct representing a positionally-readable file
+			struct muafInner_PFile {
+				HANDLE handle;
+			};
+			typedef struct muafInner_PFile muafInner_PFile;
+
+			// Opens a positionally-readable file
+			// (Also writable if 'writable' is true; file must already exist)
+			muafResult muafInner_OpenPFile(const char* filename, muBool writable, muafInner_PFile* file) {
+				MUAF_BEGIN_PHASE(t, MUAF_PHASE_OPEN);
+				file->handle = CreateFileA(
+					filename,
+					(writable) ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+					FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0
+				);
+				MUAF_END_PHASE(t, MUAF_PHASE_OPEN);
+				MUAF_COUNT(open_count, 1);
+				if (file->handle == INVALID_HANDLE_VALUE) {
+					return MUAF_FAILED_OPEN_FILE;
+				}
+				return MUAF_SUCCESS;
+			}
+
+			// Closes a positionally-readable file
+			void muafInner_ClosePFile(muafInner_PFile* file) {
+				CloseHandle(file->handle);
+			}
+
+			// Reads data from a positionally-readable file
+			// Thread-safe
+			muafResult muafInner_ReadPFile(muafInner_PFile* file, size_m index, size_m len, muByte* data) {
+				// Read in pieces that fit in a DWORD
+				while (len > 0) {
+					DWORD to_read = (len > 0x40000000) ? 0x40000000 : (DWORD)len;
+					// Offset is given through OVERLAPPED, so the file pointer isn't depended on
+					OVERLAPPED overlapped;
+					mu_memset(&overlapped, 0, sizeof(overlapped));
+					overlapped.Offset = (DWORD)(((uint64_m)index) & 0xFFFFFFFF);
+					overlapped.OffsetHigh = (DWORD)(((uint64_m)index) >> 32);
+
+					DWORD read_len = 0;
+					MUAF_BEGIN_PHASE(t, MUAF_PHASE_READ);
+					BOOL read_res = ReadFile(file->handle, data, to_read, &read_len, &overlapped);
+					MUAF_END_PHASE(t, MUAF_PHASE_READ);
+					MUAF_COUNT(read_count, 1);
+					MUAF_COUNT64(read_bytes, read_len);
+					if (!read_res || read_len == 0) {
+						return MUAF_FAILED_READ_FILE;
+					}
+					index += read_len;
+					data += read_len;
+					len -= read_len;
+				}
+				return MUAF_SUCCESS;
+			}
+
+			// Writes data to a positionally-writable file
+			// Thread-safe
+			muafResult muafInner_WritePFile(muafInner_PFile* file, size_m index, size_m len, muByte* data) {
+				// Write in pieces that fit in a DWORD
+				while (len > 0) {
+					DWORD to_write = (len > 0x40000000) ? 0x40000000 : (DWORD)len;
+					// Offset is given through OVERLAPPED, so the file pointer isn't depended on
+					OVERLAPPED overlapped;
+					mu_memset(&overlapped, 0, sizeof(overlapped));
+					overlapped.Offset = (DWORD)(((uint64_m)index) & 0xFFFFFFFF);
+					overlapped.OffsetHigh = (DWORD)(((uint64_m)index) >> 32);
+
+					DWORD write_len = 0;
+					MUAF_BEGIN_PHASE(t, MUAF_PHASE_WRITE);
+					BOOL write_res = WriteFile(file->handle, data, to_write, &write_len, &overlapped);
+					MUAF_END_PHASE(t, MUAF_PHASE_WRITE);
+					MUAF_COUNT(write_count, 1);
+					MUAF_COUNT64(write_bytes, write_len);
+					if (!write_res || write_len == 0) {
+						return MUAF_FAILED_WRITE_FILE;
+					}
+					index += write_len;
+					data += write_len;
+					len -= write_len;
+				}
+				return MUAF_SUCCESS;
+			}
+
+			// Makes sure data written to a positionally-writable file is stored on disk
+			muafResult muafInner_SyncPFile(muafInner_PFile* file) {
+				MUAF_BEGIN_PHASE(t, MUAF_PHASE_WRITE);
+				BOOL sync_res = FlushFileBuffers(file->handle);
+				MUAF_END_PHASE(t, MUAF_PHASE_WRITE);
+				return (sync_res) ? MUAF_SUCCESS : MUAF_FAILED_WRITE_FILE;
+			}
+
+			// Sets how a positionally-readable file uses the page cache
+			// (Not supported, since FILE_FLAG_NO_BUFFERING can only be given when opening)
+			muafCacheMode muafInner_SetPFileCache(muafInner_PFile* file, muafCacheMode mode) {
+				return MUAF_CACHE_NORMAL; if (file) {} if (mode) {}
+			}
+
+		#else
+
+			// Struct representing a positionally-readable file
+			// (No positional reading available, so every read/write opens the file)
+			struct muafInner_PFile {
+				char* filename;
+			};
+			typedef struct muafInner_PFile muafInner_PFile;
+
+			// Opens a positionally-readable file
+			// (Also writable if 'writable' is true; file must already exist)
+			muafResult muafInner_OpenPFile(const char* filename, muBool writable, muafInner_PFile* file) {
+				// Make sure file can be opened
+				muafInner_File test;
+				int open_res = (writable) ? muafInner_CreateFile(filename, &test, 0) : muafInner_LoadFile(filename, &test);
+				if (open_res != 0) {
+					return MUAF_FAILED_OPEN_FILE;
+				}
+				muafInner_DeloadFile(&test);
+
+				// Copy filename
+				size_m len = 0;
+				while (filename[len]) {
+					++len;
+				}
+				file->filename = (char*)mu_malloc(len + 1);
+				if (!file->filename) {
+					return MUAF_FAILED_MALLOC;
+				}
+				mu_memcpy(file->filename, filename, len + 1);
+				return MUAF_SUCCESS;
+			}
+
+			// Closes a positionally-readable file
+			void muafInner_ClosePFile(muafInner_PFile* file) {
+				mu_free(file->filename);
+			}
+
+			// Reads data from a positionally-readable file
+			// Thread-safe
+			muafResult muafInner_ReadPFile(muafInner_PFile* file, size_m index, size_m len, muByte* data) {
+				muafInner_File f;
+				if (muafInner_LoadFile(file->filename, &f) != 0) {
+					return MUAF_FAILED_OPEN_FILE;
+				}
+				muafInner_FSeek(f.fptr, index, MU_SEEK_SET);
+				size_m read_len = muafInner_FRead(data, 1, len, f.fptr);
+				muafInner_DeloadFile(&f);
+				if (read_len != len) {
+					return MUAF_FAILED_READ_FILE;
+				}
+				return MUAF_SUCCESS;
+			}
+
+			// Writes data to a positionally-writable file
+			// Thread-safe (as long as the written ranges don't overlap)
+			muafResult muafInner_WritePFile(muafInner_PFile* file, size_m index, size_m len, muByte* data) {
+				muafInner_File f;
+				if (muafInner_CreateFile(file->filename, &f, 0) != 0) {
+					return MUAF_FAILED_OPEN_FILE;
+				}
+				muafInner_FSeek(f.fptr, index, MU_SEEK_SET);
+				size_m write_len = muafInner_FWrite((const void*)data, 1, len, f.fptr);
+				muafInner_DeloadFile(&f);
+				if (write_len != len) {
+					return MUAF_FAILED_WRITE_FILE;
+				}
+				return MUAF_SUCCESS;
+			}
+
+			// Makes sure data written to a positionally-writable file is stored on disk
+			// (Every write already closes the file, flushing it, and there's no
+			// standard way to do more than that)
+			muafResult muafInner_SyncPFile(muafInner_PFile* file) {
+				return MUAF_SUCCESS; if (file) {}
+			}
+
+			// Sets how a positionally-readable file uses the page cache
+			// (Not supported through stdio)
+			muafCacheMode muafInner_SetPFileCache(muafInner_PFile* file, muafCacheMode mode) {
+				return MUAF_CACHE_NORMAL; if (file) {} if (mode) {}
+			}
+
+		#endif
+
+		// Copies data from one positionally-readable file to another
+		muafResult muafInner_CopyPFile(muafInner_PFile* src, size_m src_index, muafInner_PFile* dst, size_m dst_index, size_m len) {
+			// Let the kernel copy if possible
+			// (Falls back to copying through a buffer on any failure, such as
+			// the files being on different filesystems on older kernels)
+			#if defined(MU_LINUX) && !defined(MUAF_NO_POSITIONAL_READ) && !defined(MUAF_NO_COPY_FILE_RANGE)
+				// (Offsets could be cut off otherwise)
+				if (sizeof(off_t) >= sizeof(size_m)) {
+					while (len > 0) {
+						off_t in_off = (off_t)src_index;
+						off_t out_off = (off_t)dst_index;
+						ssize_t copied = mu_copy_file_range(src->fd, &in_off, dst->fd, &out_off, len, 0);
+						if (copied <= 0) {
+							break;
+						}
+						src_index += (size_m)copied;
+						dst_index += (size_m)copied;
+						len -= (size_m)copied;
+					}
+					if (len == 0) {
+						return MUAF_SUCCESS;
+					}
+				}
+			#endif
+
+			// Copy through a buffer
+			size_m buf_len = (len < MUAF_WAVE_COPY_BLOCK_SIZE) ? len : MUAF_WAVE_COPY_BLOCK_SIZE;
+			muByte* buf = (muByte*)mu_malloc(buf_len);
+			if (!buf) {
+				return MUAF_FAILED_MALLOC;
+			}
+			muafResult res = MUAF_SUCCESS;
+			while (len > 0) {
+				size_m piece = (len < buf_len) ? len : buf_len;
+				res = muafInner_ReadPFile(src, src_index, piece, buf);
+				if (muaf_result_is_fatal(res)) {
+					break;
+				}
+				res = muafInner_WritePFile(dst, dst_index, piece, buf);
+				if (muaf_result_is_fatal(res)) {
+					break;
+				}
+				src_index += piece;
+				dst_index += piece;
+				len -= piece;
+			}
+			mu_free(buf);
+			return res;
+		}
+
+		// Creates a file of the given length without writing its contents
+		// Returns the strategy used, which is MUAF_WAVE_ALLOCATION_SEEK if the
+		// file couldn't be allocated this way and still needs to be created
+		muWAVEAllocation muafInner_AllocateFile(const char* filename, size_m len, muWAVEAllocation allocation) {
+			#if defined(MU_LINUX) && !defined(MUAF_NO_POSITIONAL_READ)
+				// (Length could be cut off otherwise)
+				if (sizeof(off_t) < sizeof(size_m)) {
+					return MUAF_WAVE_ALLOCATION_SEEK;
+				}
+
+				int fd = mu_open(filename, MU_O_RDWR | MU_O_CREAT | MU_O_TRUNC, 0666);
+				if (fd < 0) {
+					return MUAF_WAVE_ALLOCATION_SEEK;
+				}
+
+				// Reserve space
+				// (Fails on filesystems that don't support it, falling back to extending)
+				#ifndef MUAF_NO_FALLOCATE
+					if (allocation == MUAF_WAVE_ALLOCATION_RESERVE) {
+						if (mu_fallocate(fd, 0, 0, (off_t)len) == 0) {
+							mu_close(fd);
+							return MUAF_WAVE_ALLOCATION_RESERVE;
+						}
+					}
+				#endif
+
+				// Extend
+				allocation = (mu_ftruncate(fd, (off_t)len) == 0) ? MUAF_WAVE_ALLOCATION_EXTEND : MUAF_WAVE_ALLOCATION_SEEK;
+				mu_close(fd);
+				return allocation;
+
+			#elif defined(MU_WIN32) && !defined(MUAF_NO_POSITIONAL_READ)
+				HANDLE handle = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE, 0, 0, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0);
+				if (handle == INVALID_HANDLE_VALUE) {
+					return MUAF_WAVE_ALLOCATION_SEEK;
+				}
+
+				// Setting the end of the file reserves its space without writing it
+				LARGE_INTEGER end;
+				end.QuadPart = (LONGLONG)len;
+				BOOL set = SetFilePointerEx(handle, end, 0, FILE_BEGIN) && SetEndOfFile(handle);
+				CloseHandle(handle);
+				return (set) ? MUAF_WAVE_ALLOCATION_RESERVE : MUAF_WAVE_ALLOCATION_SEEK;
+
+			#else
+				// No way to allocate without writing
+				return MUAF_WAVE_ALLOCATION_SEEK; if (filename) {} if (len) {} if (allocation) {}
+			#endif
+		}
+
+	/* Checksums */
+
+		/* MD5 */
+
+			// Struct representing an MD5 calculation in progress
+			struct muafInner_MD5 {
+				uint32_m state[4];
+				// Total length in bytes
+				uint64_m len;
+				// Unprocessed bytes
+				muByte buf[64];
+			};
+			typedef struct muafInner_MD5 muafInner_MD5;
+
+			// Per-round shift amounts
+			const uint8_m muafInner_MD5Shifts[64] = {
+				7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+				5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+				4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+				6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+			};
+
+			// Per-round constants (floor(abs(sin(i+1)) * 2^32))
+			const uint32_m muafInner_MD5Constants[64] = {
+				0xD76AA478, 0xE8C7B756, 0x242070DB, 0xC1BDCEEE, 0xF57C0FAF, 0x4787C62A, 0xA8304613, 0xFD469501,
+				0x698098D8, 0x8B44F7AF, 0xFFFF5BB1, 0x895CD7BE, 0x6B901122, 0xFD987193, 0xA679438E, 0x49B40821,
+				0xF61E2562, 0xC040B340, 0x265E5A51, 0xE9B6C7AA, 0xD62F105D, 0x02441453, 0xD8A1E681, 0xE7D3FBC8,
+				0x21E1CDE6, 0xC33707D6, 0xF4D50D87, 0x455A14ED, 0xA9E3E905, 0xFCEFA3F8, 0x676F02D9, 0x8D2A4C8A,
+				0xFFFA3942, 0x8771F681, 0x6D9D6122, 0xFDE5380C, 0xA4BEEA44, 0x4BDECFA9, 0xF6BB4B60, 0xBEBFBC70,
+				0x289B7EC6, 0xEAA127FA, 0xD4EF3085, 0x04881D05, 0xD9D4D039, 0xE6DB99E5, 0x1FA27CF8, 0xC4AC5665,
+				0xF4292244, 0x432AFF97, 0xAB9423A7, 0xFC93A039, 0x655B59C3, 0x8F0CCC92, 0xFFEFF47D, 0x85845DD1,
+				0x6FA87E4F, 0xFE2CE6E0, 0xA3014314, 0x4E0811A1, 0xF7537E82, 0xBD3AF235, 0x2AD7D2BB, 0xEB86D391
+			};
+
+			// Starts an MD5 calculation
+			void muafInner_MD5Init(muafInner_MD5* md5) {
+				md5->state[0] = 0x67452301;
+				md5->state[1] = 0xEFCDAB89;
+				md5->state[2] = 0x98BADCFE;
+				md5->state[3] = 0x10325476;
+				md5->len = 0;
+			}
+
+			// Processes a 64-byte block
+			void muafInner_MD5Block(muafInner_MD5* md5, muByte* block) {
+				// Read block as little-endian words
+				uint32_m m[16];
+				for (uint8_m i = 0; i < 16; ++i) {
+					m[i] = MU_RLEU32(block + (i * 4));
+				}
+
+				uint32_m a = md5->state[0], b = md5->state[1], c = md5->state[2], d = md5->state[3];
+				for (uint8_m i = 0; i < 64; ++i) {
+					uint32_m f;
+					uint8_m g;
+					if (i < 16) {
+						f = (b & c) | ((~b) & d);
+						g = i;
+					} else if (i < 32) {
+						f = (d & b) | ((~d) & c);
+						g = (5 * i + 1) & 15;
+					} else if (i < 48) {
+						f = b ^ c ^ d;
+						g = (3 * i + 5) & 15;
+					} else {
+						f = c ^ (b | (~d));
+						g = (7 * i) & 15;
+					}
+					f += a + muafInner_MD5Constants[i] + m[g];
+					a = d;
+					d = c;
+					c = b;
+					b += (f << muafInner_MD5Shifts[i]) | (f >> (32 - muafInner_MD5Shifts[i]));
+				}
+
+				md5->state[0] += a;
+				md5->state[1] += b;
+				md5->state[2] += c;
+				md5->state[3] += d;
+			}
+
+			// Adds data to an MD5 calculation
+			void muafInner_MD5Update(muafInner_MD5* md5, muByte* data, size_m len) {
+				size_m buf_len = (size_m)(md5->len & 63);
+				md5->len += len;
+
+				// Fill up previously unprocessed bytes
+				if (buf_len != 0) {
+					size_m fill = 64 - buf_len;
+					if (fill > len) {
+						fill = len;
+					}
+					mu_memcpy(md5->buf + buf_len, data, fill);
+					buf_len += fill;
+					data += fill;
+					len -= fill;
+					if (buf_len < 64) {
+						return;
+					}
+					muafInner_MD5Block(md5, md5->buf);
+				}
+
+				// Process whole blocks directly
+				while (len >= 64) {
+					muafInner_MD5Block(md5, data);
+					data += 64;
+					len -= 64;
+				}
+
+				// Store what's left
+				if (len != 0) {
+					mu_memcpy(md5->buf, data, len);
+				}
+			}
+
+			// Finishes an MD5 calculation
+			void muafInner_MD5Final(muafInner_MD5* md5, muByte digest[16]) {
+				// Pad with 0x80, zeros, and the length in bits
+				uint64_m bit_len = md5->len * 8;
+				muByte pad[72];
+				mu_memset(pad, 0, sizeof(pad));
+				pad[0] = 0x80;
+				// (So that the length ends exactly at the end of a block)
+				size_m pad_len = 64 - ((size_m)((md5->len + 8) & 63));
+				MU_WLEU64(pad + pad_len, bit_len);
+				muafInner_MD5Update(md5, pad, pad_len + 8);
+
+				// Output state as little-endian
+				for (uint8_m i = 0; i < 4; ++i) {
+					MU_WLEU32(digest + (i * 4), md5->state[i]);
+				}
+			}
+
+		/* xxHash64 */
+
+			// Struct representing an xxHash64 calculation in progress
+			struct muafInner_XXH64 {
+				uint64_m acc[4];
+				// Total length in bytes
+				uint64_m len;
+				// Unprocessed bytes
+				muByte buf[32];
+			};
+			typedef struct muafInner_XXH64 muafInner_XXH64;
+
+			#define MUAF_XXH64_P1 0x9E3779B185EBCA87ULL
+			#define MUAF_XXH64_P2 0xC2B2AE3D27D4EB4FULL
+			#define MUAF_XXH64_P3 0x165667B19E3779F9ULL
+			#define MUAF_XXH64_P4 0x85EBCA77C2B2AE63ULL
+			#define MUAF_XXH64_P5 0x27D4EB2F165667C5ULL
+			#define MUAF_XXH64_ROTL(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+			// Starts an xxHash64 calculation (seed 0)
+			void muafInner_XXH64Init(muafInner_XXH64* h) {
+				h->acc[0] = MUAF_XXH64_P1 + MUAF_XXH64_P2;
+				h->acc[1] = MUAF_XXH64_P2;
+				h->acc[2] = 0;
+				h->acc[3] = 0 - MUAF_XXH64_P1;
+				h->len = 0;
+			}
+
+			// Mixes 8 bytes into an accumulator
+			uint64_m muafInner_XXH64Round(uint64_m acc, uint64_m input) {
+				acc += input * MUAF_XXH64_P2;
+				acc = MUAF_XXH64_ROTL(acc, 31);
+				return acc * MUAF_XXH64_P1;
+			}
+
+			// Merges an accumulator into the final hash
+			uint64_m muafInner_XXH64Merge(uint64_m h, uint64_m acc) {
+				h ^= muafInner_XXH64Round(0, acc);
+				return (h * MUAF_XXH64_P1) + MUAF_XXH64_P4;
+			}
+
+			// Processes a 32-byte stripe
+			void muafInner_XXH64Stripe(muafInner_XXH64* h, muByte* b) {
+				h->acc[0] = muafInner_XXH64Round(h->acc[0], MU_RLEU64(b));
+				h->acc[1] = muafInner_XXH64Round(h->acc[1], MU_RLEU64(b+8));
+				h->acc[2] = muafInner_XXH64Round(h->acc[2], MU_RLEU64(b+16));
+				h->acc[3] = muafInner_XXH64Round(h->acc[3], MU_RLEU64(b+24));
+			}
+
+			// Adds data to an xxHash64 calculation
+			void muafInner_XXH64Update(muafInner_XXH64* h, muByte* data, size_m len) {
+				size_m buffered = (size_m)(h->len % 32);
+				h->len += len;
+
+				// Fill up buffered stripe
+				if (buffered != 0) {
+					size_m fill = 32 - buffered;
+					if (fill > len) {
+						fill = len;
+					}
+					mu_memcpy(h->buf + buffered, data, fill);
+					data += fill;
+					len -= fill;
+					if (buffered + fill < 32) {
+						return;
+					}
+					muafInner_XXH64Stripe(h, h->buf);
+				}
+
+				// Process whole stripes directly
+				while (len >= 32) {
+					muafInner_XXH64Stripe(h, data);
+					data += 32;
+					len -= 32;
+				}
+				mu_memcpy(h->buf, data, len);
+			}
+
+			// Finishes an xxHash64 calculation
+			uint64_m muafInner_XXH64Final(muafInner_XXH64* h) {
+				uint64_m hash;
+				if (h->len >= 32) {
+					hash = MUAF_XXH64_ROTL(h->acc[0], 1) + MUAF_XXH64_ROTL(h->acc[1], 7) + MUAF_XXH64_ROTL(h->acc[2], 12) + MUAF_XXH64_ROTL(h->acc[3], 18);
+					for (uint8_m a = 0; a < 4; ++a) {
+						hash = muafInner_XXH64Merge(hash, h->acc[a]);
+					}
+				} else {
+					hash = MUAF_XXH64_P5;
+				}
+				hash += h->len;
+
+				// Remaining bytes
+				size_m rem = (size_m)(h->len % 32);
+				muByte* b = h->buf;
+				for (; rem >= 8; rem -= 8, b += 8) {
+					hash ^= muafInner_XXH64Round(0, MU_RLEU64(b));
+					hash = (MUAF_XXH64_ROTL(hash, 27) * MUAF_XXH64_P1) + MUAF_XXH64_P4;
+				}
+				if (rem >= 4) {
+					hash ^= ((uint64_m)MU_RLEU32(b)) * MUAF_XXH64_P1;
+					hash = (MUAF_XXH64_ROTL(hash, 23) * MUAF_XXH64_P2) + MUAF_XXH64_P3;
+					rem -= 4;
+					b += 4;
+				}
+				for (; rem > 0; --rem, ++b) {
+					hash ^= ((uint64_m)b[0]) * MUAF_XXH64_P5;
+					hash = MUAF_XXH64_ROTL(hash, 11) * MUAF_XXH64_P1;
+				}
+
+				// Avalanche
+				hash ^= hash >> 33;
+				hash *= MUAF_XXH64_P2;
+				hash ^= hash >> 29;
+				hash *= MUAF_XXH64_P3;
+				hash ^= hash >> 32;
+				return hash;
+			}
+
+	/* Resampling */
+
+		// Struct representing a resample filter
+		struct muResampleFilter {
+			// Sample rates
+			uint32_m src_rate;
+			uint32_m dst_rate;
+			// Conversion ratio in simplest form
+			// (Destination frame n lands on source position n * down / up)
+			uint64_m up;
+			uint64_m down;
+			// Taps per phase, and how many of them come before the source frame
+			// that a destination frame lands on
+			uint32_m taps;
+			uint32_m left;
+			// Filter bank; holds phases+1 phases of taps
+			// (Last phase is the first phase shifted by one source frame, so that
+			// interpolating past the last phase doesn't need a special case)
+			uint32_m phases;
+			double* bank;
+		};
+
+		// Quality preset values
+		uint32_m muafInner_ResampleTaps(muResampleQuality quality) {
+			switch (quality) {
+				default: case MUAF_RESAMPLE_QUALITY_LOW: return 16; break;
+				case MUAF_RESAMPLE_QUALITY_MEDIUM: return 32; break;
+				case MUAF_RESAMPLE_QUALITY_HIGH: return 64; break;
+			}
+		}
+		double muafInner_ResampleRolloff(muResampleQuality quality) {
+			switch (quality) {
+				default: case MUAF_RESAMPLE_QUALITY_LOW: return 0.85; break;
+				case MUAF_RESAMPLE_QUALITY_MEDIUM: return 0.91; break;
+				case MUAF_RESAMPLE_QUALITY_HIGH: return 0.95; break;
+			}
+		}
+		double muafInner_ResampleBeta(muResampleQuality quality) {
+			switch (quality) {
+				default: case MUAF_RESAMPLE_QUALITY_LOW: return 6.0; break;
+				case MUAF_RESAMPLE_QUALITY_MEDIUM: return 8.0; break;
+				case MUAF_RESAMPLE_QUALITY_HIGH: return 10.0; break;
+			}
+		}
+
+		// Greatest common divisor
+		uint64_m muafInner_GCD(uint64_m a, uint64_m b) {
+			while (b) {
+				uint64_m t = a % b;
+				a = b;
+				b = t;
+			}
+			return a;
+		}
+
+		// Zeroth-order modified Bessel function of the first kind
+		double muafInner_BesselI0(double x) {
+			double sum = 1.0;
+			double term = 1.0;
+			double hx = x / 2.0;
+			for (uint32_m k = 1; k < 64; ++k) {
+				term *= hx / (double)k;
+				double sq = term * term;
+				sum += sq;
+				if (sq < sum * 1e-17) {
+					break;
+				}
+			}
+			return sum;
+		}
+
+		// Kaiser-windowed sinc at distance d (in source frames)
+		double muafInner_ResampleKernel(double d, double cutoff, double half, double beta, double i0_beta) {
+			// Window
+			double r = d / half;
+			if (r <= -1.0 || r >= 1.0) {
+				return 0.0;
+			}
+			double w = muafInner_BesselI0(beta * mu_sqrt(1.0 - (r * r))) / i0_beta;
+
+			// Sinc
+			double x = 3.14159265358979323846 * cutoff * d;
+			double sinc = (x > -1e-9 && x < 1e-9) ? 1.0 : (mu_sin(x) / x);
+			return cutoff * sinc * w;
+		}
+
+		// Creates a resample filter
+		MUDEF muafResult mu_create_resample_filter(uint32_m src_rate, uint32_m dst_rate, muResampleQuality quality, muResampleFilter** filter) {
+			if (src_rate == 0 || dst_rate == 0) {
+				return MUAF_INVALID_RESAMPLE_RATE;
+			}
+
+			// Allocate filter
+			muResampleFilter* f = (muResampleFilter*)mu_malloc(sizeof(muResampleFilter));
+			if (!f) {
+				return MUAF_FAILED_MALLOC;
+			}
+
+			// Reduce ratio
+			uint64_m gcd = muafInner_GCD(src_rate, dst_rate);
+			f->src_rate = src_rate;
+			f->dst_rate = dst_rate;
+			f->up = dst_rate / gcd;
+			f->down = src_rate / gcd;
+
+			// Same rate: single tap that passes frames through
+			if (f->up == f->down) {
+				f->taps = 1;
+				f->left = 0;
+				f->phases = 1;
+				f->bank = (double*)mu_malloc(sizeof(double) * 2);
+				if (!f->bank) {
+					mu_free(f);
+					return MUAF_FAILED_MALLOC;
+				}
+				f->bank[0] = 1.0;
+				f->bank[1] = 0.0;
+				*filter = f;
+				return MUAF_SUCCESS;
+			}
+
+			// Calculate tap count
+			// (Downsampling lowers the cutoff, so the kernel is widened by the same amount)
+			uint64_m taps = muafInner_ResampleTaps(quality);
+			double cutoff = muafInner_ResampleRolloff(quality);
+			if (f->down > f->up) {
+				taps = ((taps * f->down) + f->up - 1) / f->up;
+				cutoff = (cutoff * (double)f->up) / (double)f->down;
+			}
+			if (taps > MUAF_RESAMPLE_MAX_TAPS) {
+				taps = MUAF_RESAMPLE_MAX_TAPS;
+			}
+			taps += taps & 1;
+			f->taps = (uint32_m)taps;
+			f->left = (f->taps / 2) - 1;
+			f->phases = (f->up > MUAF_RESAMPLE_MAX_PHASES) ? MUAF_RESAMPLE_MAX_PHASES : (uint32_m)f->up;
+
+			// Allocate bank
+			f->bank = (double*)mu_malloc(sizeof(double) * f->taps * (((size_m)f->phases) + 1));
+			if (!f->bank) {
+				mu_free(f);
+				return MUAF_FAILED_MALLOC;
+			}
+
+			// Fill each phase
+			double beta = muafInner_ResampleBeta(quality);
+			double i0_beta = muafInner_BesselI0(beta);
+			double half = ((double)f->taps) / 2.0;
+			for (uint32_m p = 0; p <= f->phases; ++p) {
+				double* phase = f->bank + (((size_m)p) * f->taps);
+				double frac = ((double)p) / ((double)f->phases);
+				double sum = 0.0;
+				for (uint32_m k = 0; k < f->taps; ++k) {
+					phase[k] = muafInner_ResampleKernel(((double)k) - ((double)f->left) - frac, cutoff, half, beta, i0_beta);
+					sum += phase[k];
+				}
+				// (Normalize so that each phase has a gain of 1 at DC)
+				for (uint32_m k = 0; k < f->taps; ++k) {
+					phase[k] /= sum;
+				}
+			}
+
+			*filter = f;
+			return MUAF_SUCCESS;
+		}
+
+		// Destroys a resample filter
+		MUDEF void mu_destroy_resample_filter(muResampleFilter* filter) {
+			mu_free(filter->bank);
+			mu_free(filter);
+		}
+
+		// Gets resampled frame count
+		MUDEF uint32_m mu_resampled_frame_count(muResampleFilter* filter, uint32_m frame_count) {
+			// (Can't overflow, since up and frame_count both fit in 32 bits)
+			uint64_m count = ((((uint64_m)frame_count) * filter->up) + filter->down - 1) / filter->down;
+			return (count > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_m)count;
+		}
+
+		// Gets the range of source frames needed to calculate a range of
+		// destination frames; 'src_beg' can be negative, as frames before the
+		// audio data are needed for the first few destination frames
+		void muafInner_ResampleWindow(muResampleFilter* filter, uint32_m beg_frame, uint32_m frame_len, int64_m* src_beg, size_m* src_len) {
+			int64_m first = (int64_m)((((uint64_m)beg_frame) * filter->down) / filter->up);
+			int64_m last = (int64_m)((((uint64_m)beg_frame + frame_len - 1) * filter->down) / filter->up);
+			*src_beg = first - filter->left;
+			*src_len = (size_m)(last - first) + filter->taps;
+		}
+
+		// Dot product between source frames and one phase of taps
+		// (Written with independent sums over contiguous arrays so that the
+		// compiler can vectorize it)
+		double muafInner_ResampleDot(const double* src, const double* taps, uint32_m count) {
+			double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+			uint32_m k = 0;
+			for (; k + 4 <= count; k += 4) {
+				s0 += src[k] * taps[k];
+				s1 += src[k+1] * taps[k+1];
+				s2 += src[k+2] * taps[k+2];
+				s3 += src[k+3] * taps[k+3];
+			}
+			for (; k < count; ++k) {
+				s0 += src[k] * taps[k];
+			}
+			return (s0 + s1) + (s2 + s3);
+		}
+
+		// Calculates one destination frame for one channel
+		// 'src' points to the source frames of the channel, starting at the source
+		// frame 'src_beg' from muafInner_ResampleWindow
+		double muafInner_ResampleFrame(muResampleFilter* filter, const double* src, int64_m src_beg, uint32_m frame) {
+			// Find the source frame and phase that this frame lands on
+			uint64_m pos = ((uint64_m)frame) * filter->down;
+			int64_m src_frame = (int64_m)(pos / filter->up);
+			uint64_m rem = (pos % filter->up) * filter->phases;
+			uint64_m p = rem / filter->up;
+			uint64_m p_rem = rem % filter->up;
+
+			const double* s = src + ((src_frame - src_beg) - filter->left);
+			const double* phase = filter->bank + (p * filter->taps);
+			double v = muafInner_ResampleDot(s, phase, filter->taps);
+
+			// Interpolate between phases if the exact phase isn't in the bank
+			if (p_rem != 0) {
+				double frac = ((double)p_rem) / ((double)filter->up);
+				double v1 = muafInner_ResampleDot(s, phase + filter->taps, filter->taps);
+				v += (v1 - v) * frac;
+			}
+			return v;
+		}
+
+		// Rounds and clamps a resampled value to a signed sample of a given bit depth
+		int64_m muafInner_ResampleQuantize(double v, uint8_m bits) {
+			double max = (double)(((uint64_m)1) << (bits - 1));
+			if (v >= max - 0.5) {
+				return (int64_m)((((uint64_m)1) << (bits - 1)) - 1);
+			}
+			if (v <= -max) {
+				return -((int64_m)((((uint64_m)1) << (bits - 1)) - 1)) - 1;
+			}
+			return (int64_m)((v < 0.0) ? (v - 0.5) : (v + 0.5));
+		}
+
+	/* WAVE */
+
+		/* Enum/Misc. functions */
+
+			// Returns whether or not given file is WAVE
+			muBool muafWAVE_IsWAVE(muafInner_File* file) {
+				// Minimum length check
+				// Includes RIFF, ckSize, and WAVE
+				if (file->len < 12) {
+					return MU_FALSE;
+				}
+
+				// Load first 12 bytes
+				muByte data[12];
+				muafInner_LoadFromFile(file, 0, 12, data);
+
+				// Check for RIFF
+				if (MU_RBEU32(data) != 0x52494646) {
+					return MU_FALSE;
+				}
+				// Skip size and check for WAVE
+				if (MU_RBEU32(data+8) != 0x57415645) {
+					return MU_FALSE;
+				}
+
+				// Has RIFF and WAVE, so likely WAVE.
+				return MU_TRUE;
+			}
+
+			// Returns WAVE support for given audio formats
+			muBool muafWAVE_FormatSupport(muafAudioFormat format) {
+				// Perform based on audio format
+				switch (format) {
+					// Unknown
+					default: return MU_FALSE; break;
+
+					// Supported PCM
+					case MUAF_FORMAT_PCM_U8:  case MUAF_FORMAT_PCM_S16:
+					case MUAF_FORMAT_PCM_S24: case MUAF_FORMAT_PCM_S32:
+					case MUAF_FORMAT_PCM_S64:
+						return MU_TRUE;
+					break;
+				}
+			}
+
+			// Returns the amount of bits in each sample of a PCM format
+			uint8_m muafWAVE_PCMBits(muafAudioFormat format) {
+				switch (format) {
+					default: return 0; break;
+					case MUAF_FORMAT_PCM_U8:  return 8;  break;
+					case MUAF_FORMAT_PCM_S16: return 16; break;
+					case MUAF_FORMAT_PCM_S24: return 24; break;
+					case MUAF_FORMAT_PCM_S32: return 32; break;
+					case MUAF_FORMAT_PCM_S64: return 64; break;
+				}
+			}
+
+		/* Profiling */
+
+			// Gets chunk information about WAVE file
+			// Does check for required chunks
+			muafResult muafWAVE_GetChunks(muafInner_File* file, muWAVEProfile* profile) {
+				// Start after RIFF, ckSize, and WAVE
+				size_m beg_i = 12;
+				// Loop through each chunk
+				while (MU_TRUE) {
+					// Account for pad byte
+					if (beg_i % 2 != 0) {
+						beg_i += 1;
+					}
+
+					// Break out of loop if we're at end of file now
+					// + ensure length for ckID and ckSize
+					if (beg_i >= file->len || file->len-beg_i < 8) {
+						break;
+					}
+
+					// Get data for ckID and ckSize
+					muByte ck_data[8];
+					muafInner_LoadFromFile(file, beg_i, 8, ck_data);
+
+					// Read ID and length
+					uint32_m ck_id = MU_RBEU32(ck_data);
+					uint32_m len = MU_RLEU32(ck_data+4);
+					// Verify length
+					if (beg_i + 8 + len > file->len) {
+						return MUAF_INVALID_WAVE_CHUNK_LENGTH_FOR_FILE;
+					}
+
+					size_m* pid = 0;
+					uint32_m* plen = 0;
+					switch (ck_id) {
+						default: break;
+						// fmt
+						case 0x666D7420: {
+							pid = &profile->chunks.fmt;
+							plen = &profile->chunks.fmt_len;
+						} break;
+						// wave
+						case 0x64617461: {
+							pid = &profile->chunks.wave;
+							plen = &profile->chunks.wave_len;
+						} break;
+						// fact
+						case 0x66616374: {
+							pid = &profile->chunks.fact;
+							plen = &profile->chunks.fact_len;
+						} break;
+						// cue
+						case 0x63756520: {
+							pid = &profile->chunks.cue;
+							plen = &profile->chunks.cue_len;
+						} break;
+						// playlist
+						case 0x706C7374: {
+							pid = &profile->chunks.playlist;
+							plen = &profile->chunks.playlist_len;
+						} break;
+						// LIST
+						case 0x4C495354: {
+							// Read list type
+							if (len > 4) {
+								muByte list_type[4];
+								muafInner_LoadFromFile(file, beg_i+8, 4, list_type);
+								uint32_m ulist_type = MU_RBEU32(list_type);
+								switch (ulist_type) {
+									default: break;
+									// assoc-data
+									case 0x6164746C: {
+										pid = &profile->chunks.assoc_data;
+										plen = &profile->chunks.assoc_data_len;
+									} break;
+								}
+							}
+						} break;
+					}
+
+					// Record ID and length if necessary
+					if (pid && plen) {
+						*pid = beg_i + 8;
+						*plen = len;
+					}
+					// Move to next chunk
+					beg_i += 8 + len;
+				}
+
+				// Make sure fmt and wave data have been defined
+				if (!profile->chunks.fmt) {
+					return MUAF_INVALID_WAVE_MISSING_FMT;
+				}
+				if (!profile->chunks.wave) {
+					return MUAF_INVALID_WAVE_MISSING_WAVE_DATA;
+				}
+
+				return MUAF_SUCCESS;
+			}
+
+			// Gets fmt WAVE PCM info
+			muafResult muafWAVE_GetFmtPCMInfo(muafInner_File* file, muWAVEProfile* profile, const muafAllocator* allocator) {
+				// Ensure extra length
+				if (profile->chunks.fmt_len < 14+2) {
+					return MUAF_INVALID_WAVE_FMT_LENGTH;
+				}
+				// Read PCM-format-specific data
+				muByte pcm_format_spec[2];
+				muafInner_LoadFromFile(file, profile->chunks.fmt+14, 2, pcm_format_spec);
+
+				// Allocate struct
+				#ifndef MUAF_WAVE_INLINE_SPECIFIC_FIELDS
+					profile->specific_fields.wave_pcm = (muWAVEPCM*)muafInner_Alloc(allocator, sizeof(muWAVEPCM));
+					if (!profile->specific_fields.wave_pcm) {
+						return MUAF_FAILED_MALLOC;
+					}
+				#else
+					// (Stored inline; nothing to allocate)
+					if (allocator) {}
+				#endif
+				muWAVEPCM* pcm = MU_WAVE_PCM_FIELDS(profile);
+
+				// Read bits per sample
+				pcm->bits_per_sample = MU_RLEU16(pcm_format_spec);
+				// - Verify it doesn't equal 0
+				if (pcm->bits_per_sample == 0) {
+					return MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE;
+				}
+				// - Verify it's divisible by 8
+				if (pcm->bits_per_sample % 8 != 0) {
+					return MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE;
+				}
+				// - Verify it works with wBlockAlign
+				if (((uint64_m)profile->channels) * (((uint64_m)pcm->bits_per_sample) / 8) != profile->block_align) {
+					return MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE;
+				}
+				// - Verify it works with wave data length
+				if (profile->chunks.wave_len % (pcm->bits_per_sample / 8) != 0) {
+					return MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE;
+				}
+
+				return MUAF_SUCCESS;
+			}
+
+			// Gets fmt information from WAVE file
+			// Chunks need to be loaded before this
+			muafResult muafWAVE_GetFmtInfo(muafInner_File* file, muWAVEProfile* profile, const muafAllocator* allocator) {
+				// Ensure minimum fmt length
+				if (profile->chunks.fmt_len < 14) {
+					return MUAF_INVALID_WAVE_FMT_LENGTH;
+				}
+
+				// Read fmt-ck's common-fields
+				muByte fmt_common_fields[14];
+				muafInner_LoadFromFile(file, profile->chunks.fmt, 14, fmt_common_fields);
+
+				// Read values
+				profile->format_tag = MU_RLEU16(fmt_common_fields);
+
+				profile->channels = MU_RLEU16(fmt_common_fields + 2);
+				if (profile->channels == 0) {
+					return MUAF_INVALID_WAVE_FMT_CHANNELS;
+				}
+
+				profile->samples_per_sec = MU_RLEU32(fmt_common_fields + 4);
+				if (profile->samples_per_sec == 0) {
+					return MUAF_INVALID_WAVE_FMT_SAMPLES_PER_SEC;
+				}
+
+				// Make sure to verify these values if muaf ever uses them!
+				profile->avg_bytes_per_sec = MU_RLEU32(fmt_common_fields + 8);
+				profile->block_align = MU_RLEU16(fmt_common_fields + 12);
+
+				// Allocate and read any format specific fields
+				switch (profile->format_tag) {
+					default: break;
+					// WAVE PCM
+					case MU_WAVE_FORMAT_PCM: {
+						muafResult res = muafWAVE_GetFmtPCMInfo(file, profile, allocator);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+					} break;
+				}
+
+				return MUAF_SUCCESS;
+			}
+
+			// Handles ckSize in case it's shorter than the file length
+			// Call muafWAVE_IsWAVE BEFORE this!!
+			void muafWAVE_HandleCkSize(muafInner_File* file) {
+				// Read ckSize
+				muByte data[4];
+				muafInner_LoadFromFile(file, 4, 4, data);
+				size_m ck_size = MU_RLEU32(data) + 8;
+				if (ck_size < file->len) {
+					file->len = ck_size;
+				}
+			}
+
+			// Gets WAVE profile given inner file
+			// Call muafWAVE_IsWAVE BEFORE this!!
+			// Modifies file length (muafWAVE_HandleCkSize)
+			muafResult muafWAVE_GetProfile(muafInner_File* file, muWAVEProfile* profile, const muafAllocator* allocator) {
+				// Correct file length based on ckSize
+				muafWAVE_HandleCkSize(file);
+
+				// Zero-out profile memory
+				mu_memset(profile, 0, sizeof(muWAVEProfile));
+
+				// Get chunk information
+				MUAF_BEGIN_PHASE(chunks_t, MUAF_PHASE_WAVE_CHUNKS);
+				muafResult res = muafWAVE_GetChunks(file, profile);
+				MUAF_END_PHASE(chunks_t, MUAF_PHASE_WAVE_CHUNKS);
+				if (muaf_result_is_fatal(res)) {
+					return res;
+				}
+				// Get fmt information
+				MUAF_BEGIN_PHASE(fmt_t, MUAF_PHASE_WAVE_FMT);
+				res = muafWAVE_GetFmtInfo(file, profile, allocator);
+				MUAF_END_PHASE(fmt_t, MUAF_PHASE_WAVE_FMT);
+				if (muaf_result_is_fatal(res)) {
+					mu_free_WAVE_profile_with_allocator(profile, allocator);
+					return res;
+				}
+
+				return res;
+			}
+
+			// Gets WAVE profile
+			MUDEF muafResult mu_get_WAVE_profile(const char* filename, muWAVEProfile* profile) {
+				return mu_get_WAVE_profile_with_allocator(filename, profile, 0);
+			}
+
+			// Gets WAVE profile with allocator
+			MUDEF muafResult mu_get_WAVE_profile_with_allocator(const char* filename, muWAVEProfile* profile, const muafAllocator* allocator) {
+				// Open file and read header prefix
+				muafInner_File file;
+				muByte prefix[MUAF_HEADER_PREFIX_SIZE];
+				if (muafInner_LoadFilePrefix(filename, &file, prefix, sizeof(prefix)) != 0) {
+					return MUAF_FAILED_OPEN_FILE;
+				}
+				
+				// Make sure it's WAVE
+				if (!muafWAVE_IsWAVE(&file)) {
+					muafInner_DeloadFile(&file);
+					return MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION;
+				}
+
+				// Get profile
+				muafResult res = muafWAVE_GetProfile(&file, profile, allocator);
+
+				// Close file
+				muafInner_DeloadFile(&file);
+				return res;
+			}
+
+			// Frees memory for WAVE profile
+			MUDEF void mu_free_WAVE_profile(muWAVEProfile* profile) {
+				mu_free_WAVE_profile_with_allocator(profile, 0);
+			}
+
+			// Frees memory for WAVE profile with allocator
+			MUDEF void mu_free_WAVE_profile_with_allocator(muWAVEProfile* profile, const muafAllocator* allocator) {
+				// Free format specific fields if it exists
+				// Any member will do for this check due to overlapping union memory
+				#ifndef MUAF_WAVE_INLINE_SPECIFIC_FIELDS
+					if (profile->specific_fields.wave_pcm != 0) {
+						muafInner_Free(allocator, profile->specific_fields.wave_pcm);
+					}
+				#else
+					// (Stored inline; nothing to free)
+					return; if (profile) {} if (allocator) {}
+				#endif
+			}
+
+		/* Kernels */
+
+			// Converts sample_count raw WAVE PCM samples (b_data) into the
+			// format's type (data), or the other way around for encoding.
+			// Converting in place is safe when the larger of the two starts
+			// at or before the smaller, as each sample is read before being
+			// written, going forward.
+			typedef void (*muafWAVE_DecodeKernel)(muByte* b_data, size_m sample_count, muByte* data);
+			typedef void (*muafWAVE_EncodeKernel)(muByte* data, size_m sample_count, muByte* b_data);
+
+			// Defines a kernel converting samples of in_size bytes into
+			// samples of out_size bytes; the sizes are constant, so the loop
+			// can be unrolled and vectorized by the compiler.
+			#define MUAF_WAVE_KERNEL(name, in_size, out_size, convert) \
+				void name(muByte* in, size_m sample_count, muByte* out) { \
+					for (size_m s = 0; s < sample_count; ++s) { \
+						muByte* i = in + (s * (in_size)); \
+						muByte* o = out + (s * (out_size)); \
+						convert \
+					} \
+				}
+
+			// Copies samples that are already in the right representation
+			void muafWAVE_CopyKernel(muByte* in, size_m byte_count, muByte* out) {
+				// (Nothing to do if converting in place)
+				if (in != out) {
+					mu_memcpy(out, in, byte_count);
+				}
+			}
+
+			/* Decoding */
+
+				// MUAF_FORMAT_PCM_U8
+				void muafWAVE_DecodeU8(muByte* b_data, size_m sample_count, muByte* data) {
+					muafWAVE_CopyKernel(b_data, sample_count, data);
+				}
+
+				// MUAF_FORMAT_PCM_S24
+				// (Sign-extended from 24 bits without branching)
+				MUAF_WAVE_KERNEL(muafWAVE_DecodeS24, 3, 4,
+					int32_m sample = (int32_m)(MU_RLEU24(i) ^ 0x800000) - 0x800000;
+					mu_memcpy(o, &sample, 4);
+				)
+
+				#if MUAF_LITTLE_ENDIAN
+
+					// MUAF_FORMAT_PCM_S16
+					void muafWAVE_DecodeS16(muByte* b_data, size_m sample_count, muByte* data) {
+						muafWAVE_CopyKernel(b_data, sample_count * 2, data);
+					}
+
+					// MUAF_FORMAT_PCM_S32
+					void muafWAVE_DecodeS32(muByte* b_data, size_m sample_count, muByte* data) {
+						muafWAVE_CopyKernel(b_data, sample_count * 4, data);
+					}
+
+					// MUAF_FORMAT_PCM_S64
+					void muafWAVE_DecodeS64(muByte* b_data, size_m sample_count, muByte* data) {
+						muafWAVE_CopyKernel(b_data, sample_count * 8, data);
+					}
+
+				#else
+
+					// MUAF_FORMAT_PCM_S16
+					MUAF_WAVE_KERNEL(muafWAVE_DecodeS16, 2, 2,
+						int16_m sample = MU_RLES16(i);
+						mu_memcpy(o, &sample, 2);
+					)
+
+					// MUAF_FORMAT_PCM_S32
+					MUAF_WAVE_KERNEL(muafWAVE_DecodeS32, 4, 4,
+						int32_m sample = MU_RLES32(i);
+						mu_memcpy(o, &sample, 4);
+					)
+
+					// MUAF_FORMAT_PCM_S64
+					MUAF_WAVE_KERNEL(muafWAVE_DecodeS64, 8, 8,
+						int64_m sample = MU_RLES64(i);
+						mu_memcpy(o, &sample, 8);
+					)
+
+				#endif
+
+				// Gets the decoding kernel for a format, or 0 if unsupported
+				muafWAVE_DecodeKernel muafWAVE_GetDecodeKernel(muafAudioFormat format) {
+					switch (format) {
+						default: return 0; break;
+						case MUAF_FORMAT_PCM_U8:  return muafWAVE_DecodeU8;  break;
+						case MUAF_FORMAT_PCM_S16: return muafWAVE_DecodeS16; break;
+						case MUAF_FORMAT_PCM_S24: return muafWAVE_DecodeS24; break;
+						case MUAF_FORMAT_PCM_S32: return muafWAVE_DecodeS32; break;
+						case MUAF_FORMAT_PCM_S64: return muafWAVE_DecodeS64; break;
+					}
+				}
+
+			/* Encoding */
+
+				// MUAF_FORMAT_PCM_U8
+				void muafWAVE_EncodeU8(muByte* data, size_m sample_count, muByte* b_data) {
+					muafWAVE_CopyKernel(data, sample_count, b_data);
+				}
+
+				// MUAF_FORMAT_PCM_S24
+				MUAF_WAVE_KERNEL(muafWAVE_EncodeS24, 4, 3,
+					int32_m sample;
+					mu_memcpy(&sample, i, 4);
+					MU_WLES24(o, sample);
+				)
+
+				#if MUAF_LITTLE_ENDIAN
+
+					// MUAF_FORMAT_PCM_S16
+					void muafWAVE_EncodeS16(muByte* data, size_m sample_count, muByte* b_data) {
+						muafWAVE_CopyKernel(data, sample_count * 2, b_data);
+					}
+
+					// MUAF_FORMAT_PCM_S32
+					void muafWAVE_EncodeS32(muByte* data, size_m sample_count, muByte* b_data) {
+						muafWAVE_CopyKernel(data, sample_count * 4, b_data);
+					}
+
+					// MUAF_FORMAT_PCM_S64
+					void muafWAVE_EncodeS64(muByte* data, size_m sample_count, muByte* b_data) {
+						muafWAVE_CopyKernel(data, sample_count * 8, b_data);
+					}
+
+				#else
+
+					// MUAF_FORMAT_PCM_S16
+					MUAF_WAVE_KERNEL(muafWAVE_EncodeS16, 2, 2,
+						int16_m sample;
+						mu_memcpy(&sample, i, 2);
+						MU_WLES16(o, sample);
+					)
+
+					// MUAF_FORMAT_PCM_S32
+					MUAF_WAVE_KERNEL(muafWAVE_EncodeS32, 4, 4,
+						int32_m sample;
+						mu_memcpy(&sample, i, 4);
+						MU_WLES32(o, sample);
+					)
+
+					// MUAF_FORMAT_PCM_S64
+					MUAF_WAVE_KERNEL(muafWAVE_EncodeS64, 8, 8,
+						int64_m sample;
+						mu_memcpy(&sample, i, 8);
+						MU_WLES64(o, sample);
+					)
+
+				#endif
+
+				// Gets the encoding kernel for a format, or 0 if unsupported
+				muafWAVE_EncodeKernel muafWAVE_GetEncodeKernel(muafAudioFormat format) {
+					switch (format) {
+						default: return 0; break;
+						case MUAF_FORMAT_PCM_U8:  return muafWAVE_EncodeU8;  break;
+						case MUAF_FORMAT_PCM_S16: return muafWAVE_EncodeS16; break;
+						case MUAF_FORMAT_PCM_S24: return muafWAVE_EncodeS24; break;
+						case MUAF_FORMAT_PCM_S32: return muafWAVE_EncodeS32; break;
+						case MUAF_FORMAT_PCM_S64: return muafWAVE_EncodeS64; break;
+					}
+				}
+
+		/* Reading */
+
+			/* PCM reading */
+
+				// Reads PCM data from WAVE file given inner file
+				muafResult muafWAVE_ReadPCM(muafInner_File* file, muWAVEProfile* profile, muafAudioFormat format, uint32_m beg_frame, uint32_m frame_len, muByte* data) {
+					// Get kernel for format
+					muafWAVE_DecodeKernel decode = muafWAVE_GetDecodeKernel(format);
+					if (!decode) {
+						return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+					}
+
+					// Read raw data into the end of data
+					// (Raw samples are never larger than decoded samples)
+					size_m sample_count = ((size_m)frame_len) * profile->channels;
+					size_m raw_sample_size = profile->block_align / profile->channels;
+					muByte* b_data = data + (sample_count * (muaf_audio_format_sample_size(format) - raw_sample_size));
+					muafInner_LoadFromFile(file, profile->chunks.wave + (((size_m)beg_frame) * profile->block_align), sample_count * raw_sample_size, b_data);
+
+					// Convert in place
+					decode(b_data, sample_count, data);
+					return MUAF_SUCCESS;
+				}
+
+				// Reads PCM data from a WAVE file
+				MUDEF muafResult mu_read_WAVE_PCM(const char* filename, muWAVEProfile* profile, uint32_m beg_frame, uint32_m frame_len, void* data) {
+					// Open file
+					muafInner_File file;
+					if (muafInner_LoadFile(filename, &file) != 0) {
+						return MUAF_FAILED_OPEN_FILE;
+					}
+
+					// Perform reading
+					MUAF_BEGIN_PHASE(t, MUAF_PHASE_WAVE_READ_PCM);
+					muafResult res = muafWAVE_ReadPCM(
+						&file, profile,
+						mu_get_WAVE_audio_format(profile),
+						beg_frame, frame_len, (muByte*)data
+					);
+					MUAF_END_PHASE(t, MUAF_PHASE_WAVE_READ_PCM);
+
+					// Close file and return
+					muafInner_DeloadFile(&file);
+					return res;
+				}
+
+			/* Channel reading */
+
+				// Converts the samples of the given channels from raw WAVE PCM frames
+				// (b_data, frame_count frames of block_align bytes each) into
+				// interleaved frames of channel_count samples in the format's type.
+				void muafWAVE_DecodePCMChannels(muafAudioFormat format, muByte* b_data, size_m frame_count, size_m block_align, uint16_m channel_count, const uint16_m* channels, muByte* data) {
+					// Perform based on format
+					// (Switch is outside of the loops so that each loop stays tight)
+					switch (format) {
+						default: break;
+
+						// MUAF_FORMAT_PCM_U8
+						case MUAF_FORMAT_PCM_U8: {
+							uint8_m* out = (uint8_m*)data;
+							for (size_m f = 0; f < frame_count; ++f) {
+								muByte* frame = b_data + (f * block_align);
+								for (uint16_m c = 0; c < channel_count; ++c) {
+									*out++ = MU_RLEU8(frame + channels[c]);
+								}
+							}
+						} break;
+
+						// MUAF_FORMAT_PCM_S16
+						case MUAF_FORMAT_PCM_S16: {
+							int16_m* out = (int16_m*)data;
+							for (size_m f = 0; f < frame_count; ++f) {
+								muByte* frame = b_data + (f * block_align);
+								for (uint16_m c = 0; c < channel_count; ++c) {
+									*out++ = MU_RLES16(frame + (channels[c] * 2));
+								}
+							}
+						} break;
+
+						// MUAF_FORMAT_PCM_S24
+						case MUAF_FORMAT_PCM_S24: {
+							int32_m* out = (int32_m*)data;
+							for (size_m f = 0; f < frame_count; ++f) {
+								muByte* frame = b_data + (f * block_align);
+								for (uint16_m c = 0; c < channel_count; ++c) {
+									// (Sign-extend from 24 bits)
+									int32_m sample = (int32_m)MU_RLEU24(frame + (channels[c] * 3));
+									*out++ = (sample & 0x800000) ? (sample | ~((int32_m)0xFFFFFF)) : sample;
+								}
+							}
+						} break;
+
+						// MUAF_FORMAT_PCM_S32
+						case MUAF_FORMAT_PCM_S32: {
+							int32_m* out = (int32_m*)data;
+							for (size_m f = 0; f < frame_count; ++f) {
+								muByte* frame = b_data + (f * block_align);
+								for (uint16_m c = 0; c < channel_count; ++c) {
+									*out++ = MU_RLES32(frame + (channels[c] * 4));
+								}
+							}
+						} break;
+
+						// MUAF_FORMAT_PCM_S64
+						case MUAF_FORMAT_PCM_S64: {
+							int64_m* out = (int64_m*)data;
+							for (size_m f = 0; f < frame_count; ++f) {
+								muByte* frame = b_data + (f * block_align);
+								for (uint16_m c = 0; c < channel_count; ++c) {
+									*out++ = MU_RLES64(frame + (channels[c] * 8));
+								}
+							}
+						} break;
+					}
+				}
+
+				// Reads the PCM data of certain channels from WAVE file given inner file
+				muafResult muafWAVE_ReadPCMChannels(muafInner_File* file, muWAVEProfile* profile, muafAudioFormat format, uint32_m beg_frame, uint32_m frame_len, uint16_m channel_count, const uint16_m* channels, muByte* data) {
+					// Make sure format is supported
+					if (!MUAF_FORMAT_IS_PCM(format) || !muafWAVE_FormatSupport(format)) {
+						return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+					}
+
+					// Calculate how many frames can be read per block
+					size_m block_align = profile->block_align;
+					size_m block_frames = MUAF_WAVE_READ_BLOCK_SIZE / block_align;
+					if (block_frames == 0) {
+						block_frames = 1;
+					}
+					if (block_frames > frame_len) {
+						block_frames = frame_len;
+					}
+					if (block_frames == 0) {
+						return MUAF_SUCCESS;
+					}
+
+					// Allocate block
+					muByte* b_data = (muByte*)mu_malloc(block_frames * block_align);
+					if (!b_data) {
+						return MUAF_FAILED_MALLOC;
+					}
+
+					// Read and decode each block
+					size_m out_frame_size = muaf_audio_format_sample_size(format) * channel_count;
+					size_m f = 0;
+					while (f < frame_len) {
+						// Calculate frame count for this block
+						size_m count = frame_len - f;
+						if (count > block_frames) {
+							count = block_frames;
+						}
+
+						// Read raw frames
+						muafInner_LoadFromFile(file, profile->chunks.wave + ((((size_m)beg_frame) + f) * block_align), count * block_align, b_data);
+						// Decode requested channels
+						muafWAVE_DecodePCMChannels(format, b_data, count, block_align, channel_count, channels, data + (f * out_frame_size));
+
+						f += count;
+					}
+
+					// Free block and return
+					mu_free(b_data);
+					return MUAF_SUCCESS;
+				}
+
+				// Reads PCM data of certain channels from a WAVE file
+				MUDEF muafResult mu_read_WAVE_PCM_channels(const char* filename, muWAVEProfile* profile, uint32_m beg_frame, uint32_m frame_len, uint16_m channel_count, const uint16_m* channels, void* data) {
+					// Open file
+					muafInner_File file;
+					if (muafInner_LoadFile(filename, &file) != 0) {
+						return MUAF_FAILED_OPEN_FILE;
+					}
+
+					// Perform reading
+					muafResult res = muafWAVE_ReadPCMChannels(
+						&file, profile,
+						mu_get_WAVE_audio_format(profile),
+						beg_frame, frame_len,
+						channel_count, channels,
+						(muByte*)data
+					);
+
+					// Close file and return
+					muafInner_DeloadFile(&file);
+					return res;
+				}
+
+			/* Range reading */
+
+				// Converts raw WAVE PCM samples into the format's type
+				void muafWAVE_DecodePCM(muafAudioFormat format, muByte* b_data, size_m sample_count, muByte* data) {
+					muafWAVE_DecodeKernel decode = muafWAVE_GetDecodeKernel(format);
+					if (decode) {
+						decode(b_data, sample_count, data);
+					}
+				}
+
+				// Compares two range pointers based on their beginning frame (for qsort)
+				int muafWAVE_CompareRanges(const void* a, const void* b) {
+					uint32_m beg_a = (*(muWAVERange**)a)->beg_frame;
+					uint32_m beg_b = (*(muWAVERange**)b)->beg_frame;
+					return (beg_a > beg_b) - (beg_a < beg_b);
+				}
+
+				// Reads PCM data of multiple ranges from WAVE file given inner file
+				muafResult muafWAVE_ReadPCMRanges(muafInner_File* file, muWAVEProfile* profile, muafAudioFormat format, size_m range_count, muWAVERange* ranges) {
+					// Make sure format is supported
+					if (!MUAF_FORMAT_IS_PCM(format) || !muafWAVE_FormatSupport(format)) {
+						return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+					}
+					if (range_count == 0) {
+						return MUAF_SUCCESS;
+					}
+					// (Nothing to read if every range is empty)
+					size_m total_frames = 0;
+					for (size_m r = 0; r < range_count; ++r) {
+						total_frames += ranges[r].frame_len;
+					}
+					if (total_frames == 0) {
+						return MUAF_SUCCESS;
+					}
+
+					// Calculate sizes
+					size_m block_align = profile->block_align;
+					size_m out_frame_size = muaf_audio_format_sample_size(format) * profile->channels;
+					// - Max amount of frames in a coalesced read
+					size_m max_frames = MUAF_WAVE_RANGE_COALESCE_SIZE / block_align;
+					if (max_frames == 0) {
+						max_frames = 1;
+					}
+					// - Max amount of frames between coalesced ranges
+					size_m gap_frames = MUAF_WAVE_RANGE_GAP_SIZE / block_align;
+
+					// Sort ranges by location
+					muWAVERange** sorted = (muWAVERange**)mu_malloc(sizeof(muWAVERange*) * range_count);
+					if (!sorted) {
+						return MUAF_FAILED_MALLOC;
+					}
+					for (size_m r = 0; r < range_count; ++r) {
+						sorted[r] = &ranges[r];
+					}
+					mu_qsort(sorted, range_count, sizeof(muWAVERange*), muafWAVE_CompareRanges);
+
+					// Allocate read buffer
+					// (Only as large as the largest possible read needs)
+					size_m buf_frames = 0;
+					for (size_m r = 0; r < range_count; ++r) {
+						if (sorted[r]->frame_len > buf_frames) {
+							buf_frames = sorted[r]->frame_len;
+						}
+					}
+					if (buf_frames < max_frames && range_count > 1) {
+						buf_frames = max_frames;
+					}
+					if (buf_frames > max_frames) {
+						buf_frames = max_frames;
+					}
+					muByte* b_data = (muByte*)mu_malloc(buf_frames * block_align);
+					if (!b_data) {
+						mu_free(sorted);
+						return MUAF_FAILED_MALLOC;
+					}
+
+					// Loop through each group of coalesced ranges
+					size_m r = 0;
+					while (r < range_count) {
+						size_m group_beg = sorted[r]->beg_frame;
+						size_m group_end = group_beg + sorted[r]->frame_len;
+
+						// Range too large to be coalesced; read it on its own in blocks
+						if (sorted[r]->frame_len > max_frames) {
+							size_m f = 0;
+							while (f < sorted[r]->frame_len) {
+								size_m count = sorted[r]->frame_len - f;
+								if (count > buf_frames) {
+									count = buf_frames;
+								}
+								muafInner_LoadFromFile(file, profile->chunks.wave + ((group_beg + f) * block_align), count * block_align, b_data);
+								muafWAVE_DecodePCM(format, b_data, count * profile->channels, ((muByte*)sorted[r]->data) + (f * out_frame_size));
+								f += count;
+							}
+							++r;
+							continue;
+						}
+
+						// Find last range within this group
+						size_m last = r + 1;
+						while (last < range_count) {
+							size_m beg = sorted[last]->beg_frame;
+							size_m end = beg + sorted[last]->frame_len;
+							if (end < group_end) {
+								end = group_end;
+							}
+							// Too far away or too large
+							if (beg > group_end + gap_frames || end - group_beg > max_frames) {
+								break;
+							}
+							group_end = end;
+							++last;
+						}
+
+						// Read the group at once
+						muafInner_LoadFromFile(file, profile->chunks.wave + (group_beg * block_align), (group_end - group_beg) * block_align, b_data);
+						// Decode each range within the group
+						for (; r < last; ++r) {
+							muafWAVE_DecodePCM(
+								format,
+								b_data + ((sorted[r]->beg_frame - group_beg) * block_align),
+								((size_m)sorted[r]->frame_len) * profile->channels,
+								(muByte*)sorted[r]->data
+							);
+						}
+					}
+
+					// Free and return
+					mu_free(b_data);
+					mu_free(sorted);
+					return MUAF_SUCCESS;
+				}
+
+				// Reads PCM data of multiple ranges from a WAVE file
+				MUDEF muafResult mu_read_WAVE_PCM_ranges(const char* filename, muWAVEProfile* profile, size_m range_count, muWAVERange* ranges) {
+					// Open file
+					muafInner_File file;
+					if (muafInner_LoadFile(filename, &file) != 0) {
+						return MUAF_FAILED_OPEN_FILE;
+					}
+
+					// Perform reading
+					muafResult res = muafWAVE_ReadPCMRanges(
+						&file, profile,
+						mu_get_WAVE_audio_format(profile),
+						range_count, ranges
+					);
+
+					// Close file and return
+					muafInner_DeloadFile(&file);
+					return res;
+				}
+
+			/* Streaming */
+
+				// Struct representing a WAVE stream
+				struct muWAVEStream {
+					// Open file
+					muafInner_File file;
+					// Copied info about audio data
+					muafAudioFormat format;
+					uint16_m channels;
+					size_m block_align;
+					size_m wave;
+					uint32_m num_frames;
+					// Size of a decoded frame
+					size_m frame_size;
+					// Next frame to be read from the file (only used by producer)
+					uint32_m next_frame;
+					// Block for reading raw data (only used by producer)
+					muByte* b_data;
+					size_m b_frames;
+					// Ring buffer
+					muByte* ring;
+					size_m capacity;
+					// Total amount of frames written/read to/from ring buffer (atomic)
+					// (Never more than num_frames, so no wraparound)
+					size_m write_count;
+					size_m read_count;
+				};
+
+				// Creates a WAVE stream
+				MUDEF muafResult mu_create_WAVE_stream(const char* filename, muWAVEProfile* profile, uint32_m depth, muWAVEStream** stream) {
+					// Make sure format is supported
+					muafAudioFormat format = mu_get_WAVE_audio_format(profile);
+					if (!MUAF_FORMAT_IS_PCM(format) || !muafWAVE_FormatSupport(format)) {
+						return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+					}
+					// Make sure ring buffer can hold frames
+					if (depth == 0) {
+						return MUAF_INVALID_WAVE_STREAM_DEPTH;
+					}
+
+					// Allocate stream
+					muWAVEStream* s = (muWAVEStream*)mu_malloc(sizeof(muWAVEStream));
+					if (!s) {
+						return MUAF_FAILED_MALLOC;
+					}
+					mu_memset(s, 0, sizeof(muWAVEStream));
+
+					// Copy info
+					s->format = format;
+					s->channels = profile->channels;
+					s->block_align = profile->block_align;
+					s->wave = profile->chunks.wave;
+					s->num_frames = profile->chunks.wave_len / profile->block_align;
+					s->frame_size = muaf_audio_format_sample_size(format) * s->channels;
+
+					// Allocate ring buffer
+					s->capacity = depth;
+					s->ring = (muByte*)mu_malloc(s->capacity * s->frame_size);
+					if (!s->ring) {
+						mu_free(s);
+						return MUAF_FAILED_MALLOC;
+					}
+
+					// Allocate read block
+					s->b_frames = MUAF_WAVE_READ_BLOCK_SIZE / s->block_align;
+					if (s->b_frames == 0) {
+						s->b_frames = 1;
+					}
+					if (s->b_frames > s->capacity) {
+						s->b_frames = s->capacity;
+					}
+					s->b_data = (muByte*)mu_malloc(s->b_frames * s->block_align);
+					if (!s->b_data) {
+						mu_free(s->ring);
+						mu_free(s);
+						return MUAF_FAILED_MALLOC;
+					}
+
+					// Open file
+					if (muafInner_LoadFile(filename, &s->file) != 0) {
+						mu_free(s->b_data);
+						mu_free(s->ring);
+						mu_free(s);
+						return MUAF_FAILED_OPEN_FILE;
+					}
+
+					*stream = s;
+					return MUAF_SUCCESS;
+				}
+
+				// Destroys a WAVE stream
+				MUDEF void mu_destroy_WAVE_stream(muWAVEStream* stream) {
+					muafInner_DeloadFile(&stream->file);
+					mu_free(stream->b_data);
+					mu_free(stream->ring);
+					mu_free(stream);
+				}
+
+				// Fills a WAVE stream's ring buffer (producer)
+				MUDEF muafResult mu_fill_WAVE_stream(muWAVEStream* stream, uint32_m* filled) {
+					MU_SET_RESULT(filled, 0)
+
+					// Calculate free space
+					size_m write_count = stream->write_count;
+					size_m space = stream->capacity - (write_count - MUAF_ATOMIC_LOAD(&stream->read_count));
+
+					// Fill in blocks until full or out of frames
+					uint32_m total = 0;
+					while (space > 0 && stream->next_frame < stream->num_frames) {
+						// Calculate frame count for this block
+						size_m count = stream->num_frames - stream->next_frame;
+						if (count > space) {
+							count = space;
+						}
+						if (count > stream->b_frames) {
+							count = stream->b_frames;
+						}
+
+						// Read raw frames
+						muafInner_LoadFromFile(&stream->file, stream->wave + (((size_m)stream->next_frame) * stream->block_align), count * stream->block_align, stream->b_data);
+
+						// Decode into ring buffer, split in two if it wraps around
+						size_m ring_i = write_count % stream->capacity;
+						size_m first = stream->capacity - ring_i;
+						if (first > count) {
+							first = count;
+						}
+						muafWAVE_DecodePCM(stream->format, stream->b_data, first * stream->channels, stream->ring + (ring_i * stream->frame_size));
+						if (first < count) {
+							muafWAVE_DecodePCM(stream->format, stream->b_data + (first * stream->block_align), (count - first) * stream->channels, stream->ring);
+						}
+
+						// Publish frames
+						write_count += count;
+						MUAF_ATOMIC_STORE(&stream->write_count, write_count);
+
+						stream->next_frame += (uint32_m)count;
+						space -= count;
+						total += (uint32_m)count;
+					}
+
+					MU_SET_RESULT(filled, total)
+					return MUAF_SUCCESS;
+				}
+
+				// Pulls frames from a WAVE stream's ring buffer (consumer)
+				MUDEF uint32_m mu_pull_WAVE_stream(muWAVEStream* stream, uint32_m frame_len, void* data) {
+					// Calculate available frames
+					size_m read_count = stream->read_count;
+					size_m available = MUAF_ATOMIC_LOAD(&stream->write_count) - read_count;
+					size_m count = frame_len;
+					if (count > available) {
+						count = available;
+					}
+					if (count == 0) {
+						return 0;
+					}
+
+					// Copy out of ring buffer, split in two if it wraps around
+					size_m ring_i = read_count % stream->capacity;
+					size_m first = stream->capacity - ring_i;
+					if (first > count) {
+						first = count;
+					}
+					mu_memcpy(data, stream->ring + (ring_i * stream->frame_size), first * stream->frame_size);
+					if (first < count) {
+						mu_memcpy(((muByte*)data) + (first * stream->frame_size), stream->ring, (count - first) * stream->frame_size);
+					}
+
+					// Release space
+					MUAF_ATOMIC_STORE(&stream->read_count, read_count + count);
+					return (uint32_m)count;
+				}
+
+				// Returns available frames in WAVE stream (consumer)
+				MUDEF uint32_m mu_WAVE_stream_available(muWAVEStream* stream) {
+					return (uint32_m)(MUAF_ATOMIC_LOAD(&stream->write_count) - stream->read_count);
+				}
+
+				// Returns if every frame has been pulled from WAVE stream (consumer)
+				MUDEF muBool mu_WAVE_stream_finished(muWAVEStream* stream) {
+					return stream->read_count == stream->num_frames;
+				}
+
+			/* Readers */
+
+				// Struct representing a WAVE reader
+				struct muWAVEReader {
+					// Positionally-readable file
+					muafInner_PFile file;
+					// Copied info about audio data
+					muafAudioFormat format;
+					uint16_m channels;
+					size_m block_align;
+					size_m wave;
+					size_m raw_sample_size;
+					size_m sample_size;
+					uint32_m num_frames;
+					uint32_m sample_rate;
+					// Kernel converting raw samples
+					muafWAVE_DecodeKernel decode;
+					// Allocator the reader was allocated with
+					muBool has_allocator;
+					muafAllocator allocator;
+				};
+
+				// Opens a WAVE reader
+				MUDEF muafResult mu_open_WAVE_reader(const char* filename, muWAVEProfile* profile, muWAVEReader** reader) {
+					return mu_open_WAVE_reader_with_allocator(filename, profile, 0, reader);
+				}
+
+				// Opens a WAVE reader with allocator
+				MUDEF muafResult mu_open_WAVE_reader_with_allocator(const char* filename, muWAVEProfile* profile, const muafAllocator* allocator, muWAVEReader** reader) {
+					// Make sure format is supported
+					muafAudioFormat format = mu_get_WAVE_audio_format(profile);
+					if (!MUAF_FORMAT_IS_PCM(format) || !muafWAVE_FormatSupport(format)) {
+						return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+					}
+
+					// Allocate reader
+					muWAVEReader* r = (muWAVEReader*)muafInner_Alloc(allocator, sizeof(muWAVEReader));
+					if (!r) {
+						return MUAF_FAILED_MALLOC;
+					}
+
+					// Open file
+					muafResult res = muafInner_OpenPFile(filename, MU_FALSE, &r->file);
+					if (muaf_result_is_fatal(res)) {
+						muafInner_Free(allocator, r);
+						return res;
+					}
+
+					// Keep allocator
+					r->has_allocator = (allocator != 0);
+					if (allocator) {
+						r->allocator = *allocator;
+					}
+
+					// Copy info
+					r->format = format;
+					r->channels = profile->channels;
+					r->block_align = profile->block_align;
+					r->wave = profile->chunks.wave;
+					r->raw_sample_size = profile->block_align / profile->channels;
+					r->sample_size = muaf_audio_format_sample_size(format);
+					r->num_frames = profile->chunks.wave_len / profile->block_align;
+					r->sample_rate = profile->samples_per_sec;
+					// (Resolved once here, rather than on every read)
+					r->decode = muafWAVE_GetDecodeKernel(format);
+
+					*reader = r;
+					return MUAF_SUCCESS;
+				}
+
+				// Closes a WAVE reader
+				MUDEF void mu_close_WAVE_reader(muWAVEReader* reader) {
+					muafInner_ClosePFile(&reader->file);
+
+					// Free with the allocator it was allocated with
+					// (Copied out first, since it's inside the reader)
+					if (reader->has_allocator) {
+						muafAllocator allocator = reader->allocator;
+						muafInner_Free(&allocator, reader);
+					}
+					else {
+						mu_free(reader);
+					}
+				}
+
+				// Reads frames from a WAVE reader
+				MUDEF muafResult mu_read_WAVE_reader(muWAVEReader* reader, uint32_m beg_frame, uint32_m frame_len, void* data) {
+					size_m sample_count = ((size_m)frame_len) * reader->channels;
+					// Read raw data into the end of data
+					// (Raw samples are never larger than decoded samples)
+					muByte* b_data = ((muByte*)data) + (sample_count * (reader->sample_size - reader->raw_sample_size));
+					muafResult res = muafInner_ReadPFile(&reader->file, reader->wave + (((size_m)beg_frame) * reader->block_align), sample_count * reader->raw_sample_size, b_data);
+					if (muaf_result_is_fatal(res)) {
+						return res;
+					}
+
+					// Convert in place
+					// (Safe going forward, as each decoded sample is written
+					// at or before where its raw sample was read from)
+					reader->decode(b_data, sample_count, (muByte*)data);
+					return MUAF_SUCCESS;
+				}
+
+				// Sets a WAVE reader's cache mode
+				MUDEF muafResult mu_set_WAVE_reader_cache(muWAVEReader* reader, muafCacheMode mode, muafCacheMode* used) {
+					muafCacheMode cache = muafInner_SetPFileCache(&reader->file, mode);
+					if (used) {
+						*used = cache;
+					}
+					return MUAF_SUCCESS;
+				}
+
+			/* General reading */
+
+				// Gets audio format of WAVE file
+				MUDEF muafAudioFormat mu_get_WAVE_audio_format(muWAVEProfile* profile) {
+					// Perform based on format tag
+					switch (profile->format_tag) {
+						// Unknown
+						default: return MUAF_FORMAT_UNKNOWN; break;
+
+						// PCM
+						case MU_WAVE_FORMAT_PCM: {
+							// Perform based on bits per sample
+							switch (MU_WAVE_PCM_FIELDS(profile)->bits_per_sample) {
+								default: return MUAF_FORMAT_UNKNOWN; break;
+								case 8:  return MUAF_FORMAT_PCM_U8;  break;
+								case 16: return MUAF_FORMAT_PCM_S16; break;
+								case 24: return MUAF_FORMAT_PCM_S24; break;
+								case 32: return MUAF_FORMAT_PCM_S32; break;
+								case 64: return MUAF_FORMAT_PCM_S64; break;
+							}
+						} break;
+					}
+				}
+
+		/* Writing */
+
+			/* Wrapper */
+
+				/* PCM fmt writing */
+
+					// MUAF_FORMAT_PCM_U8
+					muafResult muafWAVE_FmtPCMU8(muafInner_File* file, muWAVEWrapper* wrapper) {
+						// Fill out info
+						muByte fmt[16];
+
+						// - wFormatTag
+						MU_WLEU16(fmt, MU_WAVE_FORMAT_PCM);
+						// - wChannels
+						MU_WLEU16(fmt+2, wrapper->num_channels);
+						// - dwSamplesPerSec
+						MU_WLEU32(fmt+4, wrapper->sample_rate);
+						// - dwAvgBytesPerSec
+						uint64_m avg_bytes = ((uint64_m)wrapper->num_channels) * ((uint64_m)wrapper->sample_rate) * 1;
+						if (avg_bytes > 0xFFFFFFFF) {
+							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						}
+						MU_WLEU32(fmt+8, avg_bytes);
+						// - wBlockAlign
+						MU_WLEU16(fmt+12, wrapper->num_channels);
+
+						// - wBitsPerSample
+						MU_WLEU16(fmt+14, 8);
+
+						// Write to file
+						muafInner_WriteToFile(file, wrapper->chunks.fmt, 16, fmt);
+						return MUAF_SUCCESS;
+					}
+
+					// MUAF_FORMAT_PCM_S16
+					muafResult muafWAVE_FmtPCMS16(muafInner_File* file, muWAVEWrapper* wrapper) {
+						// Fill out info
+						muByte fmt[16];
+
+						// - wFormatTag
+						MU_WLEU16(fmt, MU_WAVE_FORMAT_PCM);
+						// - wChannels
+						MU_WLEU16(fmt+2, wrapper->num_channels);
+						// - dwSamplesPerSec
+						MU_WLEU32(fmt+4, wrapper->sample_rate);
+						// - dwAvgBytesPerSec
+						uint64_m avg_bytes = ((uint64_m)wrapper->num_channels) * ((uint64_m)wrapper->sample_rate) * 2;
+						if (avg_bytes > 0xFFFFFFFF) {
+							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						}
+						MU_WLEU32(fmt+8, avg_bytes);
+						// - wBlockAlign
+						uint32_m block_align = ((uint32_m)wrapper->num_channels) * 2;
+						if (block_align > 0xFFFFFFFF) {
+							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						}
+						MU_WLEU16(fmt+12, block_align);
+
+						// - wBitsPerSample
+						MU_WLEU16(fmt+14, 16);
+
+						// Write to file
+						muafInner_WriteToFile(file, wrapper->chunks.fmt, 16, fmt);
+						return MUAF_SUCCESS;
+					}
+
+					// MUAF_FORMAT_PCM_S24
+					muafResult muafWAVE_FmtPCMS24(muafInner_File* file, muWAVEWrapper* wrapper) {
+						// Fill out info
+						muByte fmt[16];
+
+						// - wFormatTag
+						MU_WLEU16(fmt, MU_WAVE_FORMAT_PCM);
+						// - wChannels
+						MU_WLEU16(fmt+2, wrapper->num_channels);
+						// - dwSamplesPerSec
+						MU_WLEU32(fmt+4, wrapper->sample_rate);
+						// - dwAvgBytesPerSec
+						uint64_m avg_bytes = ((uint64_m)wrapper->num_channels) * ((uint64_m)wrapper->sample_rate) * 3;
+						if (avg_bytes > 0xFFFFFFFF) {
+							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						}
+						MU_WLEU32(fmt+8, avg_bytes);
+						// - wBlockAlign
+						uint32_m block_align = ((uint32_m)wrapper->num_channels) * 3;
+						if (block_align > 0xFFFFFFFF) {
+							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						}
+						MU_WLEU16(fmt+12, block_align);
+
+						// - wBitsPerSample
+						MU_WLEU16(fmt+14, 24);
+
+						// Write to file
+						muafInner_WriteToFile(file, wrapper->chunks.fmt, 16, fmt);
+						return MUAF_SUCCESS;
+					}
+
+					// MUAF_FORMAT_PCM_S32
+					muafResult muafWAVE_FmtPCMS32(muafInner_File* file, muWAVEWrapper* wrapper) {
+						// Fill out info
+						muByte fmt[16];
+
+						// - wFormatTag
+						MU_WLEU16(fmt, MU_WAVE_FORMAT_PCM);
+						// - wChannels
+						MU_WLEU16(fmt+2, wrapper->num_channels);
+						// - dwSamplesPerSec
+						MU_WLEU32(fmt+4, wrapper->sample_rate);
+						// - dwAvgBytesPerSec
+						uint64_m avg_bytes = ((uint64_m)wrapper->num_channels) * ((uint64_m)wrapper->sample_rate) * 4;
+						if (avg_bytes > 0xFFFFFFFF) {
+							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						}
+						MU_WLEU32(fmt+8, avg_bytes);
+						// - wBlockAlign
+						uint32_m block_align = ((uint32_m)wrapper->num_channels) * 4;
+						if (block_align > 0xFFFFFFFF) {
+							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						}
+						MU_WLEU16(fmt+12, block_align);
+
+						// - wBitsPerSample
+						MU_WLEU16(fmt+14, 32);
+
+						// Write to file
+						muafInner_WriteToFile(file, wrapper->chunks.fmt, 16, fmt);
+						return MUAF_SUCCESS;
+					}
+
+					// MUAF_FORMAT_PCM_S64
+					muafResult muafWAVE_FmtPCMS64(muafInner_File* file, muWAVEWrapper* wrapper) {
+						// Fill out info
+						muByte fmt[16];
+
+						// - wFormatTag
+						MU_WLEU16(fmt, MU_WAVE_FORMAT_PCM);
+						// - wChannels
+						MU_WLEU16(fmt+2, wrapper->num_channels);
+						// - dwSamplesPerSec
+						MU_WLEU32(fmt+4, wrapper->sample_rate);
+						// - dwAvgBytesPerSec
+						uint64_m avg_bytes = ((uint64_m)wrapper->num_channels) * ((uint64_m)wrapper->sample_rate) * 8;
+						if (avg_bytes > 0xFFFFFFFF) {
+							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						}
+						MU_WLEU32(fmt+8, avg_bytes);
+						// - wBlockAlign
+						uint32_m block_align = ((uint32_m)wrapper->num_channels) * 8;
+						if (block_align > 0xFFFFFFFF) {
+							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						}
+						MU_WLEU16(fmt+12, block_align);
+
+						// - wBitsPerSample
+						MU_WLEU16(fmt+14, 64);
+
+						// Write to file
+						muafInner_WriteToFile(file, wrapper->chunks.fmt, 16, fmt);
+						return MUAF_SUCCESS;
+					}
+
+					// Writes fmt given PCM format to write it in
+					muafResult muafWAVE_FmtPCM(muafInner_File* file, muWAVEWrapper* wrapper) {
+						switch (wrapper->audio_format) {
+							default: return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT; break;
+							case MUAF_FORMAT_PCM_U8 : return muafWAVE_FmtPCMU8 (file, wrapper); break;
+							case MUAF_FORMAT_PCM_S16: return muafWAVE_FmtPCMS16(file, wrapper); break;
+							case MUAF_FORMAT_PCM_S24: return muafWAVE_FmtPCMS24(file, wrapper); break;
+							case MUAF_FORMAT_PCM_S32: return muafWAVE_FmtPCMS32(file, wrapper); break;
+							case MUAF_FORMAT_PCM_S64: return muafWAVE_FmtPCMS64(file, wrapper); break;
+						}
+					}
+
+				/* General wrapper writing */
+
+					// Fills out the information for the chunks of a WAVE wrapper
+					// Writes the ultimate file length
+					muafResult muafWAVE_FillChunks(muWAVEWrapper* wrapper, size_m* len) {
+						// Initialize all chunk data to 0
+						mu_memset(&wrapper->chunks, 0, sizeof(wrapper->chunks));
+
+						// Write fmt chunk after RIFF (4), ckSize (4), WAVE (4), ckID (4), and ckSize (4)
+						wrapper->chunks.fmt = 20;
+						// Set initial length to common-fields
+						wrapper->chunks.fmt_len = 14;
+
+						// Add to fmt length based on format (and calculate sample size)
+						uint64_m sample_size = muaf_audio_format_sample_size(wrapper->audio_format);
+						// - PCM
+						if (MUAF_FORMAT_IS_PCM(wrapper->audio_format)) {
+							wrapper->chunks.fmt_len += 2;
+							// (Sample size in the file, which differs from the type's size for 24-bit)
+							sample_size = muafWAVE_PCMBits(wrapper->audio_format) / 8;
+						}
+
+						// Write WAVE chunk after fmt chunk, accounting for padding and WAVE's ckID and ckSize
+						wrapper->chunks.wave = wrapper->chunks.fmt + wrapper->chunks.fmt_len + 8;
+						if (wrapper->chunks.wave % 2 != 0) {
+							wrapper->chunks.wave += 1;
+						}
+						// WAVE chunk length
+						wrapper->chunks.wave_len = wrapper->num_frames * sample_size * wrapper->num_channels;
+
+						// Write length
+						*len = ((size_m)wrapper->chunks.wave) + ((size_m)wrapper->chunks.wave_len);
+						if (*len % 2 != 0) {
+							*len += 1;
+						}
+
+						return MUAF_SUCCESS;
+					}
+
+					// Writes RIFF and WAVE wrapper for file
+					muafResult muafWAVE_WriteRIFFWrapper(muafInner_File* file) {
+						// RIFF wrapper (+ WAVE)
+						muByte wrapper[12] = {
+							// RIFF
+							0x52, 0x49, 0x46, 0x46,
+							// ckSize (set in a second)
+							0x00, 0x00, 0x00, 0x00,
+							// WAVE
+							0x57, 0x41, 0x56, 0x45
+						};
+
+						// Make sure file size is within u32 range, excluding RIFF and ckSize
+						if ((file->len - 8) > 0xFFFFFFFF) {
+							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						}
+						// Write ckSize
+						MU_WLEU32(wrapper+4, file->len - 8);
+
+						// Write data to file
+						muafInner_WriteToFile(file, 0, sizeof(wrapper), wrapper);
+
+						return MUAF_SUCCESS;
+					}
+
+					// Writes a given chunk header
+					void muafWAVE_WriteChunkHeader(muafInner_File* file, uint32_m index, uint32_m ck_id, uint32_m ck_len) {
+						// Don't do anything if chunk doesn't exist
+						if (index == 0) {
+							return;
+						}
+
+						// Setup chunk header
+						muByte header[8];
+						MU_WBEU32(header, ck_id);
+						MU_WLEU32(header+4, ck_len);
+
+						// Write chunk header to file
+						muafInner_WriteToFile(file, index-8, sizeof(header), header);
+					}
+
+					// Writes empty, initial chunk headers
+					void muafWAVE_InitChunks(muafInner_File* file, muWAVEWrapper* wrapper) {
+						muafWAVE_WriteChunkHeader(file, wrapper->chunks.fmt,        0x666D7420, wrapper->chunks.fmt_len);
+						muafWAVE_WriteChunkHeader(file, wrapper->chunks.wave,       0x64617461, wrapper->chunks.wave_len);
+						muafWAVE_WriteChunkHeader(file, wrapper->chunks.fact,       0x66616374, wrapper->chunks.fact_len);
+						muafWAVE_WriteChunkHeader(file, wrapper->chunks.cue,        0x63756520, wrapper->chunks.cue_len);
+						muafWAVE_WriteChunkHeader(file, wrapper->chunks.playlist,   0x706C7374, wrapper->chunks.playlist_len);
+						muafWAVE_WriteChunkHeader(file, wrapper->chunks.assoc_data, 0x4C495354, wrapper->chunks.assoc_data_len);
+					}
+
+					// Writes fmt based on audio format
+					muafResult muafWAVE_FmtWrite(muafInner_File* file, muWAVEWrapper* wrapper) {
+						// PCM
+						if (MUAF_FORMAT_IS_PCM(wrapper->audio_format)) {
+							return muafWAVE_FmtPCM(file, wrapper);
+						}
+						else {
+							return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+						}
+					}
+
+					// Creates WAVE file wrapper
+					MUDEF muafResult mu_create_WAVE_wrapper(const char* filename, muWAVEWrapper* wrapper) {
+						return mu_create_WAVE_wrapper_with_allocation(filename, wrapper, MUAF_WAVE_ALLOCATION_SEEK, 0);
+					}
+
+					// Creates WAVE file wrapper, allocating the file with the given strategy
+					MUDEF muafResult mu_create_WAVE_wrapper_with_allocation(const char* filename, muWAVEWrapper* wrapper, muWAVEAllocation allocation, muWAVEAllocation* used) {
+						// Initialize chunk info
+						size_m len;
+						muafResult res = muafWAVE_FillChunks(wrapper, &len);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+
+						// Allocate the file if needed
+						if (allocation == MUAF_WAVE_ALLOCATION_RESERVE || allocation == MUAF_WAVE_ALLOCATION_EXTEND) {
+							allocation = muafInner_AllocateFile(filename, len, allocation);
+						}
+						else if (allocation != MUAF_WAVE_ALLOCATION_NONE) {
+							allocation = MUAF_WAVE_ALLOCATION_SEEK;
+						}
+
+						// Create the file
+						muafInner_File file;
+						int create_res;
+						switch (allocation) {
+							// Already allocated; open it at its full length
+							default: {
+								create_res = muafInner_CreateFile(filename, &file, 0);
+								file.len = len;
+							} break;
+							case MUAF_WAVE_ALLOCATION_SEEK: create_res = muafInner_CreateFile(filename, &file, len); break;
+							case MUAF_WAVE_ALLOCATION_NONE: create_res = muafInner_CreateEmptyFile(filename, &file, len); break;
+						}
+						if (create_res != 0) {
+							return MUAF_FAILED_CREATE_FILE;
+						}
+						if (used) {
+							*used = allocation;
+						}
+
+						// Write RIFF and WAVE wrapper
+						res = muafWAVE_WriteRIFFWrapper(&file);
+						if (muaf_result_is_fatal(res)) {
+							muafInner_DeloadFile(&file);
+							return res;
+						}
+
+						// Write empty chunks
+						muafWAVE_InitChunks(&file, wrapper);
+
+						// Write fmt chunk
+						res = muafWAVE_FmtWrite(&file, wrapper);
+						if (muaf_result_is_fatal(res)) {
+							muafInner_DeloadFile(&file);
+							return res;
+						}
+
+						// Close file
+						muafInner_DeloadFile(&file);
+						return res;
+					}
+
+					// Destroys WAVE file wrapper
+					MUDEF void mu_free_WAVE_wrapper(muWAVEWrapper* wrapper) {
+						// Does nothing currently (sorry lol :P)
+						return; if (wrapper) {}
+					}
+
+				/* Retrieving WAVE wrapper */
+
+					// Creates WAVE wrapper based on other WAVE file
+					MUDEF muafResult mu_get_WAVE_wrapper_from_WAVE(muWAVEProfile* profile, muWAVEWrapper* wrapper) {
+						// Get audio format
+						wrapper->audio_format = mu_get_WAVE_audio_format(profile);
+						// Calculate frame count
+						wrapper->num_frames = profile->chunks.wave_len / profile->block_align;
+						// Number of channels
+						wrapper->num_channels = profile->channels;
+						// Sample rate
+						wrapper->sample_rate = profile->samples_per_sec;
+						return MUAF_SUCCESS;
+					}
+
+			/* Writing audio data */
+
+				/* PCM audio writing */
+
+					// Writes PCM data to WAVE file given inner file
+					muafResult muafWAVE_WritePCM(muafInner_File* file, muWAVEWrapper* wrapper, uint32_m beg_frame, uint32_m frame_len, muByte* data) {
+						// Get kernel for format
+						muafWAVE_EncodeKernel encode = muafWAVE_GetEncodeKernel(wrapper->audio_format);
+						if (!encode) {
+							return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+						}
+
+						// Convert in place into the beginning of data
+						size_m sample_count = ((size_m)frame_len) * wrapper->num_channels;
+						size_m raw_sample_size = muafWAVE_PCMBits(wrapper->audio_format) / 8;
+						encode(data, sample_count, data);
+
+						// Write data over
+						muafInner_WriteToFile(file, wrapper->chunks.wave + (((size_m)beg_frame) * raw_sample_size * wrapper->num_channels), sample_count * raw_sample_size, data);
+						return MUAF_SUCCESS;
+					}
+
+					// Writes WAVE PCM audio data
+					MUDEF muafResult mu_write_WAVE_PCM(const char* filename, muWAVEWrapper* wrapper, uint32_m beg_frame, uint32_m frame_len, void* data) {
+						// Open file
+						muafInner_File file;
+						if (muafInner_CreateFile(filename, &file, 0) != 0) {
+							return MUAF_FAILED_OPEN_FILE;
+						}
+
+						// Perform writing based on format
+						MUAF_BEGIN_PHASE(t, MUAF_PHASE_WAVE_WRITE_PCM);
+						muafResult res = muafWAVE_WritePCM(&file, wrapper, beg_frame, frame_len, (muByte*)data);
+						MUAF_END_PHASE(t, MUAF_PHASE_WAVE_WRITE_PCM);
+
+						// Close file and return
+						muafInner_DeloadFile(&file);
+						return res;
+					}
+
+				/* Writers */
+
+					// Struct representing a WAVE writer
+					struct muWAVEWriter {
+						// Positionally-writable file
+						muafInner_PFile file;
+						// Copied wrapper
+						muWAVEWrapper wrapper;
+						// Kernel converting samples, and size of a frame in the file
+						muafWAVE_EncodeKernel encode;
+						size_m block_align;
+						// Buffer of converted frames waiting to be written (0 if disabled)
+						muByte* buffer;
+						size_m buffer_cap;
+						size_m buffer_len;
+						// Frame the buffered frames begin at
+						uint32_m buffer_beg;
+						// Frames between checkpoints (0 if disabled)
+						uint32_m checkpoint_frames;
+						// Frames written since the last checkpoint
+						uint32_m unchecked_frames;
+						// End of the furthest frame written
+						uint32_m end_frame;
+					};
+
+					// Opens a WAVE writer
+					MUDEF muafResult mu_open_WAVE_writer(const char* filename, muWAVEWrapper* wrapper, muWAVEWriter** writer) {
+						// Make sure format is supported
+						muafWAVE_EncodeKernel encode = muafWAVE_GetEncodeKernel(wrapper->audio_format);
+						if (!encode) {
+							return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+						}
+
+						// Allocate writer
+						muWAVEWriter* w = (muWAVEWriter*)mu_malloc(sizeof(muWAVEWriter));
+						if (!w) {
+							return MUAF_FAILED_MALLOC;
+						}
+
+						// Open file
+						muafResult res = muafInner_OpenPFile(filename, MU_TRUE, &w->file);
+						if (muaf_result_is_fatal(res)) {
+							mu_free(w);
+							return res;
+						}
+
+						w->wrapper = *wrapper;
+						w->encode = encode;
+						w->block_align = (muafWAVE_PCMBits(wrapper->audio_format) / 8) * ((size_m)wrapper->num_channels);
+						w->buffer = 0;
+						w->buffer_cap = 0;
+						w->buffer_len = 0;
+						w->buffer_beg = 0;
+						w->checkpoint_frames = 0;
+						w->unchecked_frames = 0;
+						w->end_frame = 0;
+						*writer = w;
+						return MUAF_SUCCESS;
+					}
+
+					// Closes a WAVE writer
+					MUDEF void mu_close_WAVE_writer(muWAVEWriter* writer) {
+						// Write what's left in the buffer, and the last checkpoint
+						mu_flush_WAVE_writer(writer);
+						if (writer->checkpoint_frames != 0) {
+							mu_checkpoint_WAVE_writer(writer);
+						}
+
+						if (writer->buffer) {
+							mu_free(writer->buffer);
+						}
+						muafInner_ClosePFile(&writer->file);
+						mu_free(writer);
+					}
+
+					// Converts frames into a WAVE writer's buffer if they fit
+					// Returns if they were buffered
+					muBool muafWAVE_BufferFrames(muWAVEWriter* writer, uint32_m beg_frame, uint32_m frame_len, muByte* data) {
+						size_m len = ((size_m)frame_len) * writer->block_align;
+						// (Writes at least as big as the buffer gain nothing from it)
+						if (len >= writer->buffer_cap) {
+							return MU_FALSE;
+						}
+						// (Must directly follow what's already buffered, and fit)
+						if (writer->buffer_len != 0) {
+							size_m buffer_end = ((size_m)writer->buffer_beg) + (writer->buffer_len / writer->block_align);
+							if (beg_frame != buffer_end || len > writer->buffer_cap - writer->buffer_len) {
+								return MU_FALSE;
+							}
+						}
+						else {
+							writer->buffer_beg = beg_frame;
+						}
+
+						// Convert into the buffer
+						writer->encode(data, ((size_m)frame_len) * writer->wrapper.num_channels, writer->buffer + writer->buffer_len);
+						writer->buffer_len += len;
+						return MU_TRUE;
+					}
+
+					// Writes frames to a WAVE writer
+					MUDEF muafResult mu_write_WAVE_writer(muWAVEWriter* writer, uint32_m beg_frame, uint32_m frame_len, void* data) {
+						muafResult res = MUAF_SUCCESS;
+
+						// Buffer frames if possible
+						muBool buffered = MU_FALSE;
+						if (writer->buffer) {
+							buffered = muafWAVE_BufferFrames(writer, beg_frame, frame_len, (muByte*)data);
+							// (Flush and try again with an empty buffer if they didn't fit)
+							if (!buffered && writer->buffer_len != 0) {
+								res = mu_flush_WAVE_writer(writer);
+								if (muaf_result_is_fatal(res)) {
+									return res;
+								}
+								buffered = muafWAVE_BufferFrames(writer, beg_frame, frame_len, (muByte*)data);
+							}
+							// (Flush once full)
+							if (buffered && writer->buffer_len == writer->buffer_cap) {
+								res = mu_flush_WAVE_writer(writer);
+								if (muaf_result_is_fatal(res)) {
+									return res;
+								}
+							}
+						}
+
+						// Otherwise, convert in place into the beginning of data, and write it over
+						if (!buffered) {
+							MUAF_BEGIN_PHASE(t, MUAF_PHASE_WAVE_WRITE_PCM);
+							writer->encode((muByte*)data, ((size_m)frame_len) * writer->wrapper.num_channels, (muByte*)data);
+							res = muafInner_WritePFile(&writer->file, writer->wrapper.chunks.wave + (((size_m)beg_frame) * writer->block_align), ((size_m)frame_len) * writer->block_align, (muByte*)data);
+							MUAF_END_PHASE(t, MUAF_PHASE_WAVE_WRITE_PCM);
+							if (muaf_result_is_fatal(res)) {
+								return res;
+							}
+						}
+
+						// Keep track of what's been written
+						if (beg_frame + frame_len > writer->end_frame) {
+							writer->end_frame = beg_frame + frame_len;
+						}
+						if (writer->checkpoint_frames == 0) {
+							return res;
+						}
+						writer->unchecked_frames = (frame_len > 0xFFFFFFFF - writer->unchecked_frames) ? 0xFFFFFFFF : (writer->unchecked_frames + frame_len);
+
+						// Write a checkpoint if enough frames have been written since the last one
+						if (writer->unchecked_frames >= writer->checkpoint_frames) {
+							return mu_checkpoint_WAVE_writer(writer);
+						}
+						return res;
+					}
+
+				/* Buffers */
+
+					// Sets a WAVE writer's buffer
+					MUDEF muafResult mu_set_WAVE_writer_buffer(muWAVEWriter* writer, size_m buffer_size) {
+						// Write what's in the old buffer
+						muafResult res = mu_flush_WAVE_writer(writer);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+						if (writer->buffer) {
+							mu_free(writer->buffer);
+							writer->buffer = 0;
+							writer->buffer_cap = 0;
+						}
+
+						// Allocate new buffer (of whole frames)
+						buffer_size -= buffer_size % writer->block_align;
+						if (buffer_size == 0) {
+							return MUAF_SUCCESS;
+						}
+						writer->buffer = (muByte*)mu_malloc(buffer_size);
+						if (!writer->buffer) {
+							return MUAF_FAILED_MALLOC;
+						}
+						writer->buffer_cap = buffer_size;
+						return MUAF_SUCCESS;
+					}
+
+					// Writes a WAVE writer's buffer to the file
+					MUDEF muafResult mu_flush_WAVE_writer(muWAVEWriter* writer) {
+						if (writer->buffer_len == 0) {
+							return MUAF_SUCCESS;
+						}
+
+						MUAF_BEGIN_PHASE(t, MUAF_PHASE_WAVE_WRITE_PCM);
+						muafResult res = muafInner_WritePFile(&writer->file, writer->wrapper.chunks.wave + (((size_m)writer->buffer_beg) * writer->block_align), writer->buffer_len, writer->buffer);
+						MUAF_END_PHASE(t, MUAF_PHASE_WAVE_WRITE_PCM);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+						writer->buffer_len = 0;
+						return MUAF_SUCCESS;
+					}
+
+				/* Cache modes */
+
+					// Sets a WAVE writer's cache mode
+					MUDEF muafResult mu_set_WAVE_writer_cache(muWAVEWriter* writer, muafCacheMode mode, muafCacheMode* used) {
+						// Write buffered frames with the old cache mode
+						muafResult res = mu_flush_WAVE_writer(writer);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+
+						muafCacheMode cache = muafInner_SetPFileCache(&writer->file, mode);
+						if (used) {
+							*used = cache;
+						}
+						return MUAF_SUCCESS;
+					}
+
+				/* Checkpoints */
+
+					// Sets how often a WAVE writer writes checkpoints
+					MUDEF muafResult mu_set_WAVE_writer_checkpoints(muWAVEWriter* writer, uint32_m checkpoint_frames) {
+						writer->checkpoint_frames = checkpoint_frames;
+						if (checkpoint_frames == 0) {
+							return MUAF_SUCCESS;
+						}
+						return mu_checkpoint_WAVE_writer(writer);
+					}
+
+					// Writes a checkpoint for a WAVE writer
+					MUDEF muafResult mu_checkpoint_WAVE_writer(muWAVEWriter* writer) {
+						// Write buffered frames
+						muafResult res = mu_flush_WAVE_writer(writer);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+
+						// Make sure audio data is stored before the headers claim it
+						res = muafInner_SyncPFile(&writer->file);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+
+						// Rewrite wave-data's ckSize
+						size_m wave = writer->wrapper.chunks.wave;
+						size_m wave_len = ((size_m)writer->end_frame) * writer->block_align;
+						muByte ck_size[4];
+						MU_WLEU32(ck_size, (uint32_m)wave_len);
+						res = muafInner_WritePFile(&writer->file, wave - 4, 4, ck_size);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+
+						// Rewrite RIFF's ckSize (excluding RIFF and ckSize, including pad byte)
+						MU_WLEU32(ck_size, (uint32_m)(wave + wave_len + (wave_len % 2) - 8));
+						res = muafInner_WritePFile(&writer->file, 4, 4, ck_size);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+
+						// Make sure headers are stored
+						res = muafInner_SyncPFile(&writer->file);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+						writer->unchecked_frames = 0;
+						return MUAF_SUCCESS;
+					}
+
+				/* Recovery */
+
+					// Recovers a WAVE file's headers from its length
+					MUDEF muafResult mu_recover_WAVE(const char* filename, uint32_m* frames) {
+						// Open file
+						muafInner_File file;
+						if (muafInner_CreateFile(filename, &file, 0) != 0) {
+							return MUAF_FAILED_OPEN_FILE;
+						}
+
+						// Check RIFF and WAVE
+						muByte header[12];
+						if (file.len < 12) {
+							muafInner_DeloadFile(&file);
+							return MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION;
+						}
+						muafInner_LoadFromFile(&file, 0, 12, header);
+						if (MU_RBEU32(header) != 0x52494646 || MU_RBEU32(header+8) != 0x57415645) {
+							muafInner_DeloadFile(&file);
+							return MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION;
+						}
+
+						// Go through chunk headers until wave-data
+						size_m index = 12;
+						size_m block_align = 0;
+						while (MU_TRUE) {
+							if (file.len - index < 8) {
+								muafInner_DeloadFile(&file);
+								return MUAF_INVALID_WAVE_MISSING_WAVE_DATA;
+							}
+							muafInner_LoadFromFile(&file, index, 8, header);
+							uint32_m ck_id = MU_RBEU32(header);
+							size_m ck_len = MU_RLEU32(header+4);
+							index += 8;
+
+							// wave-data
+							if (ck_id == 0x64617461) {
+								break;
+							}
+							// fmt-ck (for wBlockAlign)
+							if (ck_id == 0x666D7420) {
+								if (ck_len < 14 || file.len - index < 14) {
+									muafInner_DeloadFile(&file);
+									return MUAF_INVALID_WAVE_FMT_LENGTH;
+								}
+								muByte fmt[14];
+								muafInner_LoadFromFile(&file, index, 14, fmt);
+								block_align = MU_RLEU16(fmt+12);
+							}
+
+							// Skip chunk (and its pad byte)
+							if (ck_len + (ck_len % 2) > file.len - index) {
+								muafInner_DeloadFile(&file);
+								return MUAF_INVALID_WAVE_MISSING_WAVE_DATA;
+							}
+							index += ck_len + (ck_len % 2);
+						}
+						if (block_align == 0) {
+							muafInner_DeloadFile(&file);
+							return MUAF_INVALID_WAVE_MISSING_FMT;
+						}
+
+						// Lower wave-data's length to the whole frames in the file
+						size_m wave_len = MU_RLEU32(header+4);
+						size_m file_wave_len = ((file.len - index) / block_align) * block_align;
+						if (wave_len > file_wave_len) {
+							wave_len = file_wave_len;
+							MU_WLEU32(header, (uint32_m)wave_len);
+							muafResult res = muafInner_WriteToFile(&file, index - 4, 4, header);
+							if (!muaf_result_is_fatal(res)) {
+								MU_WLEU32(header, (uint32_m)(index + wave_len + (wave_len % 2) - 8));
+								res = muafInner_WriteToFile(&file, 4, 4, header);
+							}
+
+							// Write pad byte if it's missing
+							if (!muaf_result_is_fatal(res) && wave_len % 2 != 0 && index + wave_len == file.len) {
+								header[0] = 0;
+								res = muafInner_WriteToFile(&file, index + wave_len, 1, header);
+							}
+							if (muaf_result_is_fatal(res)) {
+								muafInner_DeloadFile(&file);
+								return res;
+							}
+						}
+
+						if (frames) {
+							*frames = (uint32_m)(wave_len / block_align);
+						}
+						muafInner_DeloadFile(&file);
+						return MUAF_SUCCESS;
+					}
+
+		/* Converting */
+
+			/* Sample conversion */
+
+				// Returns a sample from data in the format's type as a signed value
+				int64_m muafWAVE_GetSample(muafAudioFormat format, muByte* data, size_m s) {
+					switch (format) {
+						default: return 0; break;
+						case MUAF_FORMAT_PCM_U8:  return ((int64_m)data[s]) - 128; break;
+						case MUAF_FORMAT_PCM_S16: return ((int16_m*)data)[s]; break;
+						case MUAF_FORMAT_PCM_S24: return ((int32_m*)data)[s]; break;
+						case MUAF_FORMAT_PCM_S32: return ((int32_m*)data)[s]; break;
+						case MUAF_FORMAT_PCM_S64: return ((int64_m*)data)[s]; break;
+					}
+				}
+
+				// Writes a signed sample as raw WAVE PCM data
+				void muafWAVE_EncodeSample(muafAudioFormat format, muByte* b, int64_m sample) {
+					switch (format) {
+						default: break;
+						case MUAF_FORMAT_PCM_U8:  b[0] = (uint8_m)(sample + 128); break;
+						case MUAF_FORMAT_PCM_S16: MU_WLES16(b, (int16_m)sample); break;
+						case MUAF_FORMAT_PCM_S24: MU_WLES24(b, (int32_m)sample); break;
+						case MUAF_FORMAT_PCM_S32: MU_WLES32(b, (int32_m)sample); break;
+						case MUAF_FORMAT_PCM_S64: MU_WLES64(b, sample); break;
+					}
+				}
+
+				// Generates a pseudo-random number for dither (xorshift64)
+				uint64_m muafWAVE_DitherRandom(uint64_m* state) {
+					uint64_m x = *state;
+					x ^= x << 13;
+					x ^= x >> 7;
+					x ^= x << 17;
+					*state = x;
+					return x;
+				}
+
+				// Changes the bit depth of a sample
+				// 'random' is 0 if no dither is used
+				int64_m muafWAVE_RequantizeSample(int64_m sample, uint8_m src_bits, uint8_m dst_bits, uint64_m* random) {
+					// Widening is exact
+					if (dst_bits >= src_bits) {
+						return sample * (((int64_m)1) << (dst_bits - src_bits));
+					}
+
+					// Split into the part that's kept and the part that's cut off
+					// (Done this way so that nothing overflows, even for 64-bit samples)
+					uint8_m shift = src_bits - dst_bits;
+					uint64_m mask = (((uint64_m)1) << shift) - 1;
+					int64_m kept = sample >> shift;
+					int64_m cut = (int64_m)(((uint64_m)sample) & mask);
+
+					// Round to nearest, with optional TPDF dither (+/- 1 LSB)
+					cut += ((int64_m)1) << (shift - 1);
+					if (random) {
+						cut += ((int64_m)(muafWAVE_DitherRandom(random) & mask)) + ((int64_m)(muafWAVE_DitherRandom(random) & mask)) - ((int64_m)mask);
+					}
+					kept += cut >> shift;
+
+					// Clamp to destination range
+					int64_m max = (int64_m)((((uint64_m)1) << (dst_bits - 1)) - 1);
+					if (kept > max) {
+						return max;
+					}
+					if (kept < -max - 1) {
+						return -max - 1;
+					}
+					return kept;
+				}
+
+			/* Conversion */
+
+				// Struct representing a WAVE conversion
+				struct muWAVEConversion {
+					// Source
+					muWAVEReader* reader;
+					muafAudioFormat src_format;
+					uint16_m src_channels;
+					// Destination
+					muafInner_PFile dst;
+					muafAudioFormat dst_format;
+					uint16_m dst_channels;
+					size_m dst_wave;
+					// (Raw sample size in the file)
+					size_m dst_sample_size;
+					// Source channel of each destination channel
+					uint16_m* channel_map;
+					muBool dither;
+					// Blocks
+					uint32_m num_frames;
+					size_m block_count;
+					// Next block to be claimed (atomic)
+					volatile size_m next_block;
+					// If any block failed (atomic)
+					volatile size_m failed;
+				};
+
+				// Creates a WAVE conversion
+				MUDEF muafResult mu_create_WAVE_conversion(const char* src_filename, muWAVEProfile* profile, const char* dst_filename, muWAVEWrapper* wrapper, const uint16_m* channel_map, muBool dither, muWAVEConversion** conversion) {
+					// Make sure formats are supported
+					muafAudioFormat src_format = mu_get_WAVE_audio_format(profile);
+					if (!MUAF_FORMAT_IS_PCM(src_format) || !muafWAVE_FormatSupport(src_format)
+						|| !MUAF_FORMAT_IS_PCM(wrapper->audio_format) || !muafWAVE_FormatSupport(wrapper->audio_format)
+					) {
+						return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+					}
+
+					// Make sure channel map is valid
+					if (wrapper->num_channels == 0) {
+						return MUAF_INVALID_WAVE_CONVERSION_CHANNEL;
+					}
+					for (uint16_m c = 0; c < wrapper->num_channels; ++c) {
+						uint16_m src_c = (channel_map) ? channel_map[c] : c;
+						if (src_c >= profile->channels) {
+							return MUAF_INVALID_WAVE_CONVERSION_CHANNEL;
+						}
+					}
+
+					// Allocate conversion and channel map
+					muWAVEConversion* c = (muWAVEConversion*)mu_malloc(sizeof(muWAVEConversion));
+					if (!c) {
+						return MUAF_FAILED_MALLOC;
+					}
+					c->channel_map = (uint16_m*)mu_malloc(sizeof(uint16_m) * wrapper->num_channels);
+					if (!c->channel_map) {
+						mu_free(c);
+						return MUAF_FAILED_MALLOC;
+					}
+					for (uint16_m ch = 0; ch < wrapper->num_channels; ++ch) {
+						c->channel_map[ch] = (channel_map) ? channel_map[ch] : ch;
+					}
+
+					// Open source
+					muafResult res = mu_open_WAVE_reader(src_filename, profile, &c->reader);
+					if (muaf_result_is_fatal(res)) {
+						mu_free(c->channel_map);
+						mu_free(c);
+						return res;
+					}
+
+					// Create destination
+					wrapper->num_frames = profile->chunks.wave_len / profile->block_align;
+					wrapper->sample_rate = profile->samples_per_sec;
+					res = mu_create_WAVE_wrapper(dst_filename, wrapper);
+					if (!muaf_result_is_fatal(res)) {
+						res = muafInner_OpenPFile(dst_filename, MU_TRUE, &c->dst);
+					}
+					if (muaf_result_is_fatal(res)) {
+						mu_close_WAVE_reader(c->reader);
+						mu_free(c->channel_map);
+						mu_free(c);
+						return res;
+					}
+
+					// Copy info
+					c->src_format = src_format;
+					c->src_channels = profile->channels;
+					c->dst_format = wrapper->audio_format;
+					c->dst_channels = wrapper->num_channels;
+					c->dst_wave = wrapper->chunks.wave;
+					c->dst_sample_size = muafWAVE_PCMBits(wrapper->audio_format) / 8;
+					c->dither = dither;
+					c->num_frames = wrapper->num_frames;
+					c->block_count = (((size_m)c->num_frames) + MUAF_WAVE_CONVERSION_BLOCK_SIZE - 1) / MUAF_WAVE_CONVERSION_BLOCK_SIZE;
+					c->next_block = 0;
+					c->failed = 0;
+
+					*conversion = c;
+					return MUAF_SUCCESS;
+				}
+
+				// Destroys a WAVE conversion
+				MUDEF void mu_destroy_WAVE_conversion(muWAVEConversion* conversion) {
+					muafInner_ClosePFile(&conversion->dst);
+					mu_close_WAVE_reader(conversion->reader);
+					mu_free(conversion->channel_map);
+					mu_free(conversion);
+				}
+
+				// Converts a block of frames into raw destination data
+				void muafWAVE_ConvertBlock(muWAVEConversion* c, size_m block, uint32_m frame_len, muByte* data, muByte* b_data) {
+					uint8_m src_bits = muafWAVE_PCMBits(c->src_format);
+					uint8_m dst_bits = muafWAVE_PCMBits(c->dst_format);
+
+					// Seed dither per block so that output doesn't depend on which thread converts what
+					// (Multiplier is odd and block+1 is never 0, so the seed is never 0)
+					uint64_m random = (((uint64_m)block) + 1) * 0x9E3779B97F4A7C15ULL;
+					uint64_m* dither_random = (c->dither && dst_bits < src_bits) ? &random : 0;
+
+					for (uint32_m f = 0; f < frame_len; ++f) {
+						size_m src_frame = ((size_m)f) * c->src_channels;
+						muByte* dst_frame = b_data + (((size_m)f) * c->dst_channels * c->dst_sample_size);
+						for (uint16_m ch = 0; ch < c->dst_channels; ++ch) {
+							int64_m sample = muafWAVE_GetSample(c->src_format, data, src_frame + c->channel_map[ch]);
+							sample = muafWAVE_RequantizeSample(sample, src_bits, dst_bits, dither_random);
+							muafWAVE_EncodeSample(c->dst_format, dst_frame + (ch * c->dst_sample_size), sample);
+						}
+					}
+				}
+
+				// Processes blocks of a WAVE conversion until none are left
+				MUDEF muafResult mu_process_WAVE_conversion(muWAVEConversion* conversion, uint32_m* blocks) {
+					MU_SET_RESULT(blocks, 0)
+
+					// Allocate one block of source and destination data
+					size_m data_len = ((size_m)MUAF_WAVE_CONVERSION_BLOCK_SIZE) * conversion->src_channels * muaf_audio_format_sample_size(conversion->src_format);
+					size_m b_data_len = ((size_m)MUAF_WAVE_CONVERSION_BLOCK_SIZE) * conversion->dst_channels * conversion->dst_sample_size;
+					muByte* data = (muByte*)mu_malloc(data_len + b_data_len);
+					if (!data) {
+						MUAF_ATOMIC_STORE(&conversion->failed, 1);
+						return MUAF_FAILED_MALLOC;
+					}
+					muByte* b_data = data + data_len;
+
+					// Claim and convert blocks
+					muafResult res = MUAF_SUCCESS;
+					uint32_m converted = 0;
+					while (!MUAF_ATOMIC_LOAD(&conversion->failed)) {
+						size_m block = MUAF_ATOMIC_ADD(&conversion->next_block, 1);
+						if (block >= conversion->block_count) {
+							break;
+						}
+
+						// Calculate frame range
+						uint32_m beg_frame = (uint32_m)(block * MUAF_WAVE_CONVERSION_BLOCK_SIZE);
+						uint32_m frame_len = conversion->num_frames - beg_frame;
+						if (frame_len > MUAF_WAVE_CONVERSION_BLOCK_SIZE) {
+							frame_len = MUAF_WAVE_CONVERSION_BLOCK_SIZE;
+						}
+
+						// Read
+						res = mu_read_WAVE_reader(conversion->reader, beg_frame, frame_len, data);
+						if (muaf_result_is_fatal(res)) {
+							MUAF_ATOMIC_STORE(&conversion->failed, 1);
+							break;
+						}
+
+						// Convert
+						muafWAVE_ConvertBlock(conversion, block, frame_len, data, b_data);
+
+						// Write
+						size_m dst_frame_size = ((size_m)conversion->dst_channels) * conversion->dst_sample_size;
+						res = muafInner_WritePFile(&conversion->dst,
+							conversion->dst_wave + (((size_m)beg_frame) * dst_frame_size),
+							((size_m)frame_len) * dst_frame_size, b_data
+						);
+						if (muaf_result_is_fatal(res)) {
+							MUAF_ATOMIC_STORE(&conversion->failed, 1);
+							break;
+						}
+
+						++converted;
+					}
+
+					mu_free(data);
+					MU_SET_RESULT(blocks, converted)
+					return res;
+				}
+
+		/* Splicing */
+
+			// Splices WAVE files
+			MUDEF muafResult mu_splice_WAVE(size_m segment_count, muWAVESegment* segments, const char* dst_filename) {
+				if (segment_count == 0) {
+					return MUAF_INVALID_WAVE_SPLICE_FORMAT;
+				}
+
+				// Make sure every file matches
+				muWAVEProfile* first = segments[0].profile;
+				muafAudioFormat format = mu_get_WAVE_audio_format(first);
+				if (!MUAF_FORMAT_IS_PCM(format) || !muafWAVE_FormatSupport(format)) {
+					return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+				}
+				uint64_m num_frames = 0;
+				for (size_m s = 0; s < segment_count; ++s) {
+					muWAVEProfile* profile = segments[s].profile;
+					if (mu_get_WAVE_audio_format(profile) != format || profile->channels != first->channels || profile->samples_per_sec != first->samples_per_sec) {
+						return MUAF_INVALID_WAVE_SPLICE_FORMAT;
+					}
+					// (Frame range must be within the file's audio data)
+					if (((uint64_m)segments[s].beg_frame) + segments[s].frame_len > (uint64_m)(profile->chunks.wave_len / profile->block_align)) {
+						return MUAF_INVALID_WAVE_SPLICE_FORMAT;
+					}
+					num_frames += segments[s].frame_len;
+				}
+				if (num_frames > 0xFFFFFFFF) {
+					return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+				}
+
+				// Create destination
+				muWAVEWrapper wrapper;
+				wrapper.audio_format = format;
+				wrapper.num_frames = (uint32_m)num_frames;
+				wrapper.num_channels = first->channels;
+				wrapper.sample_rate = first->samples_per_sec;
+				muafResult res = mu_create_WAVE_wrapper(dst_filename, &wrapper);
+				if (muaf_result_is_fatal(res)) {
+					return res;
+				}
+				size_m dst_index = wrapper.chunks.wave;
+				mu_free_WAVE_wrapper(&wrapper);
+				muafInner_PFile dst;
+				res = muafInner_OpenPFile(dst_filename, MU_TRUE, &dst);
+				if (muaf_result_is_fatal(res)) {
+					mu_remove(dst_filename);
+					return res;
+				}
+
+				// Copy raw data of each segment
+				size_m block_align = first->block_align;
+				for (size_m s = 0; s < segment_count; ++s) {
+					muWAVESegment* seg = &segments[s];
+					size_m len = ((size_m)seg->frame_len) * block_align;
+					if (len == 0) {
+						continue;
+					}
+
+					muafInner_PFile src;
+					res = muafInner_OpenPFile(seg->filename, MU_FALSE, &src);
+					if (muaf_result_is_fatal(res)) {
+						break;
+					}
+					res = muafInner_CopyPFile(&src, seg->profile->chunks.wave + (((size_m)seg->beg_frame) * block_align), &dst, dst_index, len);
+					muafInner_ClosePFile(&src);
+					if (muaf_result_is_fatal(res)) {
+						break;
+					}
+					dst_index += len;
+				}
+
+				// Don't leave behind a file whose audio data was never copied
+				muafInner_ClosePFile(&dst);
+				if (muaf_result_is_fatal(res)) {
+					mu_remove(dst_filename);
+				}
+				return res;
+			}
+
+		/* Resampling */
+
+			// Stores a signed sample in an audio format's corresponding type
+			void muafWAVE_SetSample(muafAudioFormat format, muByte* data, size_m s, int64_m sample) {
+				switch (format) {
+					default: break;
+					case MUAF_FORMAT_PCM_U8:  data[s] = (uint8_m)(sample + 128); break;
+					case MUAF_FORMAT_PCM_S16: ((int16_m*)data)[s] = (int16_m)sample; break;
+					case MUAF_FORMAT_PCM_S24: ((int32_m*)data)[s] = (int32_m)sample; break;
+					case MUAF_FORMAT_PCM_S32: ((int32_m*)data)[s] = (int32_m)sample; break;
+					case MUAF_FORMAT_PCM_S64: ((int64_m*)data)[s] = sample; break;
+				}
+			}
+
+			// Reads resampled frames from a WAVE reader
+			MUDEF muafResult mu_read_WAVE_reader_resampled(muWAVEReader* reader, muResampleFilter* filter, uint32_m beg_frame, uint32_m frame_len, void* data) {
+				if (filter->src_rate != reader->sample_rate) {
+					return MUAF_INVALID_RESAMPLE_RATE;
+				}
+				if (frame_len == 0) {
+					return MUAF_SUCCESS;
+				}
+
+				// Allocate the largest window that a block can need
+				int64_m src_beg;
+				size_m max_len;
+				uint32_m block_len = (frame_len < MUAF_RESAMPLE_BLOCK_SIZE) ? frame_len : MUAF_RESAMPLE_BLOCK_SIZE;
+				muafInner_ResampleWindow(filter, 0, block_len, &src_beg, &max_len);
+				// (Window can land one source frame further on later blocks)
+				max_len += 1;
+
+				// - Decoded source frames
+				muByte* src_data = (muByte*)mu_malloc(max_len * reader->channels * reader->sample_size);
+				if (!src_data) {
+					return MUAF_FAILED_MALLOC;
+				}
+				// - Source frames of each channel as doubles
+				double* src = (double*)mu_malloc(sizeof(double) * max_len * reader->channels);
+				if (!src) {
+					mu_free(src_data);
+					return MUAF_FAILED_MALLOC;
+				}
+
+				uint8_m bits = muafWAVE_PCMBits(reader->format);
+				muafResult res = MUAF_SUCCESS;
+				for (uint32_m beg = 0; beg < frame_len; beg += block_len) {
+					uint32_m len = ((frame_len - beg) < block_len) ? (frame_len - beg) : block_len;
+					uint32_m dst_beg = beg_frame + beg;
+
+					// Find source window of this block
+					size_m src_len;
+					muafInner_ResampleWindow(filter, dst_beg, len, &src_beg, &src_len);
+
+					// Clip window to the audio data; the rest is silence
+					int64_m read_beg = (src_beg < 0) ? 0 : src_beg;
+					int64_m read_end = src_beg + (int64_m)src_len;
+					if (read_end > (int64_m)reader->num_frames) {
+						read_end = reader->num_frames;
+					}
+					mu_memset(src, 0, sizeof(double) * src_len * reader->channels);
+
+					if (read_end > read_beg) {
+						uint32_m read_len = (uint32_m)(read_end - read_beg);
+						res = mu_read_WAVE_reader(reader, (uint32_m)read_beg, read_len, src_data);
+						if (muaf_result_is_fatal(res)) {
+							break;
+						}
+
+						// Deinterleave into doubles
+						size_m offset = (size_m)(read_beg - src_beg);
+						for (uint16_m ch = 0; ch < reader->channels; ++ch) {
+							double* ch_src = src + (ch * src_len) + offset;
+							for (uint32_m f = 0; f < read_len; ++f) {
+								ch_src[f] = (double)muafWAVE_GetSample(reader->format, src_data, (((size_m)f) * reader->channels) + ch);
+							}
+						}
+					}
+
+					// Calculate destination frames
+					for (uint16_m ch = 0; ch < reader->channels; ++ch) {
+						double* ch_src = src + (ch * src_len);
+						for (uint32_m f = 0; f < len; ++f) {
+							double v = muafInner_ResampleFrame(filter, ch_src, src_beg, dst_beg + f);
+							muafWAVE_SetSample(reader->format, (muByte*)data, ((((size_m)beg) + f) * reader->channels) + ch, muafInner_ResampleQuantize(v, bits));
+						}
+					}
+				}
+
+				mu_free(src);
+				mu_free(src_data);
+				return res;
+			}
+
+			// Reads resampled frames from a WAVE file
+			MUDEF muafResult mu_read_WAVE_PCM_resampled(const char* filename, muWAVEProfile* profile, muResampleFilter* filter, uint32_m beg_frame, uint32_m frame_len, void* data) {
+				if (filter->src_rate != profile->samples_per_sec) {
+					return MUAF_INVALID_RESAMPLE_RATE;
+				}
+
+				muWAVEReader* reader;
+				muafResult res = mu_open_WAVE_reader(filename, profile, &reader);
+				if (muaf_result_is_fatal(res)) {
+					return res;
+				}
+
+				res = mu_read_WAVE_reader_resampled(reader, filter, beg_frame, frame_len, data);
+				mu_close_WAVE_reader(reader);
+				return res;
+			}
+
+		/* Silence scanning */
+
+			// Checks whether any sample within a range is beyond a threshold
+			// (No early exit, so that the compiler can vectorize it)
+			muBool muafWAVE_AnyLoud(muafAudioFormat format, muByte* data, size_m beg, size_m end, int64_m threshold) {
+				int loud = 0;
+				switch (format) {
+					default: break;
+					case MUAF_FORMAT_PCM_U8: {
+						for (size_m s = beg; s < end; ++s) {
+							int64_m v = ((int64_m)data[s]) - 128;
+							loud |= (v > threshold) | (v < -threshold);
+						}
+					} break;
+					case MUAF_FORMAT_PCM_S16: {
+						int16_m* d = (int16_m*)data;
+						for (size_m s = beg; s < end; ++s) {
+							loud |= (d[s] > threshold) | (d[s] < -threshold);
+						}
+					} break;
+					case MUAF_FORMAT_PCM_S24: case MUAF_FORMAT_PCM_S32: {
+						int32_m* d = (int32_m*)data;
+						for (size_m s = beg; s < end; ++s) {
+							loud |= (d[s] > threshold) | (d[s] < -threshold);
+						}
+					} break;
+					case MUAF_FORMAT_PCM_S64: {
+						int64_m* d = (int64_m*)data;
+						for (size_m s = beg; s < end; ++s) {
+							loud |= (d[s] > threshold) | (d[s] < -threshold);
+						}
+					} break;
+				}
+				return loud ? MU_TRUE : MU_FALSE;
+			}
+
+			// Amount of frames checked at once before narrowing down to a frame
+			#define MUAF_WAVE_SCAN_RUN 64
+
+			// Finds the first frame that isn't silent (returns frame_count if none)
+			uint32_m muafWAVE_FirstLoudFrame(muafAudioFormat format, muByte* data, uint32_m frame_count, uint16_m channels, int64_m threshold) {
+				for (uint32_m beg = 0; beg < frame_count; beg += MUAF_WAVE_SCAN_RUN) {
+					uint32_m end = ((frame_count - beg) < MUAF_WAVE_SCAN_RUN) ? frame_count : (beg + MUAF_WAVE_SCAN_RUN);
+					if (!muafWAVE_AnyLoud(format, data, ((size_m)beg) * channels, ((size_m)end) * channels, threshold)) {
+						continue;
+					}
+					for (uint32_m f = beg; f < end; ++f) {
+						if (muafWAVE_AnyLoud(format, data, ((size_m)f) * channels, (((size_m)f) + 1) * channels, threshold)) {
+							return f;
+						}
+					}
+				}
+				return frame_count;
+			}
+
+			// Finds the last frame that isn't silent (returns frame_count if none)
+			uint32_m muafWAVE_LastLoudFrame(muafAudioFormat format, muByte* data, uint32_m frame_count, uint16_m channels, int64_m threshold) {
+				for (uint32_m end = frame_count; end > 0; ) {
+					uint32_m beg = (end < MUAF_WAVE_SCAN_RUN) ? 0 : (end - MUAF_WAVE_SCAN_RUN);
+					if (muafWAVE_AnyLoud(format, data, ((size_m)beg) * channels, ((size_m)end) * channels, threshold)) {
+						for (uint32_m f = end; f > beg; --f) {
+							if (muafWAVE_AnyLoud(format, data, ((size_m)f - 1) * channels, ((size_m)f) * channels, threshold)) {
+								return f - 1;
+							}
+						}
+					}
+					end = beg;
+				}
+				return frame_count;
+			}
+
+			// Scans silence of a WAVE file
+			MUDEF muafResult mu_scan_WAVE_silence(const char* filename, muWAVEProfile* profile, double threshold, muWAVESilence* silence, double* dc_offsets) {
+				// Open reader
+				muWAVEReader* reader;
+				muafResult res = mu_open_WAVE_reader(filename, profile, &reader);
+				if (muaf_result_is_fatal(res)) {
+					return res;
+				}
+				uint32_m num_frames = reader->num_frames;
+				uint16_m channels = reader->channels;
+
+				// Allocate block
+				uint32_m block_frames = (uint32_m)(MUAF_WAVE_SCAN_BLOCK_SIZE / reader->block_align);
+				if (block_frames == 0) {
+					block_frames = 1;
+				}
+				muByte* block = (muByte*)mu_malloc(((size_m)block_frames) * channels * reader->sample_size);
+				if (!block) {
+					mu_close_WAVE_reader(reader);
+					return MUAF_FAILED_MALLOC;
+				}
+
+				// Scale threshold to samples
+				double full = (double)(((uint64_m)1) << (muafWAVE_PCMBits(reader->format) - 1));
+				int64_m t = 0;
+				if (threshold * full >= 9.2e18) {
+					t = (int64_m)(((uint64_m)1 << 63) - 1);
+				}
+				else if (threshold > 0.0) {
+					t = (int64_m)(threshold * full);
+				}
+
+				uint32_m first = num_frames;
+				uint32_m last = num_frames;
+
+				// Scan from both ends
+				if (!dc_offsets) {
+					// - Forward until something isn't silent
+					for (uint32_m beg = 0; beg < num_frames && first == num_frames; ) {
+						uint32_m len = ((num_frames - beg) < block_frames) ? (num_frames - beg) : block_frames;
+						res = mu_read_WAVE_reader(reader, beg, len, block);
+						if (muaf_result_is_fatal(res)) {
+							break;
+						}
+						uint32_m f = muafWAVE_FirstLoudFrame(reader->format, block, len, channels, t);
+						if (f != len) {
+							first = beg + f;
+						}
+						beg += len;
+					}
+
+					// - Backward until something isn't silent
+					// (Always found by the time the first loud frame is reached)
+					for (uint32_m end = num_frames; !muaf_result_is_fatal(res) && end > first; ) {
+						uint32_m beg = ((end - first) < block_frames) ? first : (end - block_frames);
+						res = mu_read_WAVE_reader(reader, beg, end - beg, block);
+						if (muaf_result_is_fatal(res)) {
+							break;
+						}
+						uint32_m f = muafWAVE_LastLoudFrame(reader->format, block, end - beg, channels, t);
+						if (f != end - beg) {
+							last = beg + f;
+							break;
+						}
+						end = beg;
+					}
+				}
+
+				// Scan everything for DC offset
+				else {
+					for (uint16_m ch = 0; ch < channels; ++ch) {
+						dc_offsets[ch] = 0.0;
+					}
+					for (uint32_m beg = 0; beg < num_frames; ) {
+						uint32_m len = ((num_frames - beg) < block_frames) ? (num_frames - beg) : block_frames;
+						res = mu_read_WAVE_reader(reader, beg, len, block);
+						if (muaf_result_is_fatal(res)) {
+							break;
+						}
+
+						// Boundaries
+						if (first == num_frames) {
+							uint32_m f = muafWAVE_FirstLoudFrame(reader->format, block, len, channels, t);
+							if (f != len) {
+								first = beg + f;
+							}
+						}
+						uint32_m f = muafWAVE_LastLoudFrame(reader->format, block, len, channels, t);
+						if (f != len) {
+							last = beg + f;
+						}
+
+						// Sum of each channel
+						for (uint32_m fr = 0; fr < len; ++fr) {
+							for (uint16_m ch = 0; ch < channels; ++ch) {
+								dc_offsets[ch] += (double)muafWAVE_GetSample(reader->format, block, (((size_m)fr) * channels) + ch);
+							}
+						}
+						beg += len;
+					}
+					for (uint16_m ch = 0; ch < channels; ++ch) {
+						dc_offsets[ch] = (num_frames == 0) ? 0.0 : (dc_offsets[ch] / ((double)num_frames * full));
+					}
+				}
+
+				// Fill in silence
+				if (!muaf_result_is_fatal(res)) {
+					silence->silent = (first == num_frames) ? MU_TRUE : MU_FALSE;
+					silence->leading = first;
+					silence->trailing = (silence->silent) ? num_frames : (num_frames - last - 1);
+				}
+
+				mu_free(block);
+				mu_close_WAVE_reader(reader);
+				return res;
+			}
+
+	/* FLAC */
+
+		/* Enum/Misc. functions */
+
+			// Returns whether or not given file is FLAC
+			muBool muafFLAC_IsFLAC(muafInner_File* file) {
+				// Minimum length check
+				// Includes fLaC (4) and entire streaminfo metadata block (4 byte header + 34 descriptive bytes)
+				if (file->len < 42) {
+					return MU_FALSE;
+				}
+
+				// Load first 5 bytes
+				muByte data[5];
+				muafInner_LoadFromFile(file, 0, 5, data);
+
+				// Check for fLaC
+				if (MU_RBEU32(data) != 0x664C6143) {
+					return MU_FALSE;
+				}
+				// Check for first metadata block being streaminfo
+				if ((data[4] & 0x7F) != 0) {
+					return MU_FALSE;
+				}
+
+				// Has fLaC and streaminfo metadata block, so likely FLAC.
+				return MU_TRUE;
+			}
+
+			// Returns FLAC support for given audio formats
+			muBool muafFLAC_FormatSupport(muafAudioFormat format) {
+				// Perform based on audio format
+				switch (format) {
+					// Unknown
+					default: return MU_FALSE; break;
+
+					// Supported PCM
+					case MUAF_FORMAT_PCM_S8:  case MUAF_FORMAT_PCM_S16:
+					case MUAF_FORMAT_PCM_S24: case MUAF_FORMAT_PCM_S32:
+						return MU_TRUE;
+					break;
+				}
+			}
+
+		/* Profiling */
+
+			// Reads information from the streaminfo metadata block
+			// Streaminfo's existence and its min. length should already be confirmed (muafFLAC_IsFLAC)
+			muafResult muafFLAC_ProcessStreaminfo(muafInner_File* file, muFLACProfile* profile, muBool* more) {
+				// Read streaminfo block (including header)
+				muByte data[38];
+				muafInner_LoadFromFile(file, 4, 38, data);
+
+				// Read if there's more metadata blocks after this
+				*more = (data[0] & 0x80) == 0;
+
+				// Read and confirm streaminfo's listed length
+				if (MU_RBEU24(data+1) != 34) {
+					return MUAF_INVALID_FLAC_STREAMINFO_LENGTH;
+				}
+
+				// Read and confirm min. block size
+				profile->min_block_size = MU_RBEU16(data+4);
+				if (profile->min_block_size < 16) {
+					return MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_RANGE;
+				}
+				// Read and confirm max. block size
+				profile->max_block_size = MU_RBEU16(data+6);
+				if (profile->max_block_size < 16) {
+					return MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_RANGE;
+				}
+				if (profile->max_block_size < profile->min_block_size) {
+					return MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_MIN_MAX;
+				}
+
+				// Read min. frame size
+				profile->min_frame_size = MU_RBEU24(data+8);
+				// Read and confirm max. frame size
+				profile->max_frame_size = MU_RBEU24(data+11);
+				if (profile->min_frame_size != 0 && profile->max_frame_size != 0) {
+					if (profile->max_frame_size < profile->min_frame_size) {
+						return MUAF_INVALID_FLAC_STREAMINFO_FRAME_SIZE_MIN_MAX;
+					}
+				}
+
+				// Read sample rate (b=14, l=20)
+				profile->sample_rate = (MU_RBEU24(data+14) & 0xFFFFF0) >> 4;
+				// Interpret sample rate
+				profile->contains_audio = profile->sample_rate != 0;
+
+				// Read number of channels (b=16, o=4, l=3)
+				profile->num_channels = ((*(data+16) & 0xE) >> 0x1) + 1;
+
+				// Read and confirm bits per sample (b=16, o=7, l=5)
+				profile->bits_per_sample = ((MU_RBEU16(data+16) & 0x1F0) >> 4) + 1;
+				if (profile->bits_per_sample < 4) {
+					return MUAF_INVALID_FLAC_STREAMINFO_BITS_PER_SAMPLE;
+				}
+
+				// Read and confirm interchannel sample count (b=17, o=4, l=36)
+				profile->num_samples = (MU_RBEU64(data+17) & 0xFFFFFFFFF000000) >> 24;
+				if (
+					( profile->contains_audio && profile->num_samples == 0) || 
+					(!profile->contains_audio && profile->num_samples != 0)) {
+					return MUAF_INVALID_FLAC_STREAMINFO_SAMPLE_COUNT;
+				}
+
+				// Read low and high bytes of checksum (b=22, l=128)
+				profile->high_checksum = MU_RBEU64(data+22);
+				profile->low_checksum = MU_RBEU64(data+30);
+				return MUAF_SUCCESS;
+			}
+
+			// Returns if the given metadata block type has occurred before
+			muBool muafFLAC_HasMetadataBlockTypeOccurred(muFLACProfile* profile, uint8_m block_type) {
+				// Loop through each metadata block
+				for (size_m i = 0; i < profile->num_metadata_blocks; ++i) {
+					// If they match, return true
+					if (profile->metadata_blocks[i].block_type == block_type) {
+						return MU_TRUE;
+					}
+				}
+				// No matches, return false
+				return MU_FALSE;
+			}
+
+			// Processes an individual metadata block
+			// Before calling, confirm:
+			// * there should be a metadata block at the given index.
+			// Fills in given metadata block
+			muafResult muafFLAC_ProcessMetadataBlock(muafInner_File* file, muFLACProfile* profile, muFLACMetadataBlock* block, size_m i, muBool* more) {
+				// Ensure length for header
+				if (file->len < i+4) {
+					return MUAF_INVALID_FLAC_METADATA_BLOCK_LENGTH;
+				}
+				// Read header
+				muByte header[4];
+				muafInner_LoadFromFile(file, i, 4, header);
 
-				// Load first 12 bytes
-				muByte data[12];
-				muafInner_LoadFromFile(file, 0, 12, data);
+				// Indicate if there's more based on first bit
+				*more = (header[0] & 0x80) == 0;
+
+				// Identify and verify metadata block type
+				block->block_type = header[0] & 0x7F;
+				switch (block->block_type) {
+					default: break;
+
+					// Forbidden value
+					case 127: return MUAF_INVALID_FLAC_METADATA_BLOCK_TYPE; break;
+
+					// Duplicate streaminfo
+					case 0: return MUAF_INVALID_FLAC_DUPLICATE_STREAMINFO; break;
+
+					// Seek table
+					case MU_FLAC_METADATA_SEEK_TABLE: {
+						// Verify no duplicates
+						if (muafFLAC_HasMetadataBlockTypeOccurred(profile, block->block_type)) {
+							return MUAF_INVALID_FLAC_DUPLICATE_SEEK_TABLE;
+						}
+					} break;
+
+					// Vorbis comment
+					case MU_FLAC_METADATA_VORBIS_COMMENT: {
+						// Verify no duplicates
+						if (muafFLAC_HasMetadataBlockTypeOccurred(profile, block->block_type)) {
+							return MUAF_INVALID_FLAC_DUPLICATE_VORBIS_COMMENT;
+						}
+					} break;
+				}
+
+				// Read and verify block length
+				block->length = MU_RBEU24(header+1);
+				if (file->len < i+4 + ((size_m)block->length)) {
+					return MUAF_INVALID_FLAC_METADATA_BLOCK_LENGTH;
+				}
+				// Set block index
+				block->index = i + 4;
+
+				return MUAF_SUCCESS;
+			}
+
+			// Processes all metadata blocks
+			// Before calling, confirm:
+			// * there should be at least one metadata block after the initial streaminfo.
+			muafResult muafFLAC_ProcessMetadata(muafInner_File* file, muFLACProfile* profile, const muafAllocator* allocator) {
+				// Initialize allocated metadata block array
+				size_m alloc_len = 4;
+				profile->metadata_blocks = (muFLACMetadataBlock*)muafInner_Alloc(allocator, sizeof(muFLACMetadataBlock) * alloc_len);
+				if (!profile->metadata_blocks) {
+					return MUAF_FAILED_MALLOC;
+				}
+
+				// Initialize file index at 42, right after streaminfo
+				size_m i = 42;
+				// Holder for if there's more metadata:
+				muBool more = MU_TRUE;
+				// Holder for result:
+				muafResult res = MUAF_SUCCESS;
+
+				// Loop through each metadata block
+				while (more) {
+					// If we've exceeded the allocated length, attempt to reallocate
+					// with double the amount from before
+					if (profile->num_metadata_blocks+1 > alloc_len) {
+						alloc_len *= 2;
+						muFLACMetadataBlock* new_blocks = (muFLACMetadataBlock*)muafInner_Realloc(
+							allocator, profile->metadata_blocks,
+							sizeof(muFLACMetadataBlock) * alloc_len
+						);
+						if (new_blocks == 0) {
+							// (Gets freed, don't worry)
+							return MUAF_FAILED_REALLOC;
+						}
+						profile->metadata_blocks = new_blocks;
+					}
+
+					// Process this metadata block
+					res = muafFLAC_ProcessMetadataBlock(
+						file, profile,
+						&profile->metadata_blocks[profile->num_metadata_blocks],
+						i, &more
+					);
+					if (muaf_result_is_fatal(res)) {
+						return res;
+					}
+
+					// Increment index based on metadata block length (including header)
+					i += 4 + profile->metadata_blocks[profile->num_metadata_blocks].length;
+					// Increment metadata block length
+					++profile->num_metadata_blocks;
+				}
+
+				return res;
+			}
+
+			// Gets FLAC profile given inner file
+			// Call muafFLAC_IsFLAC BEFORE this!!
+			muafResult muafFLAC_GetProfile(muafInner_File* file, muFLACProfile* profile, const muafAllocator* allocator) {
+				// Zero-out profile memory
+				mu_memset(profile, 0, sizeof(muFLACProfile));
+
+				// Get streaminfo
+				muBool more;
+				MUAF_BEGIN_PHASE(streaminfo_t, MUAF_PHASE_FLAC_STREAMINFO);
+				muafResult res = muafFLAC_ProcessStreaminfo(file, profile, &more);
+				MUAF_END_PHASE(streaminfo_t, MUAF_PHASE_FLAC_STREAMINFO);
+				if (muaf_result_is_fatal(res)) {
+					mu_free_FLAC_profile_with_allocator(profile, allocator);
+					return res;
+				}
+
+				// If there's more metadata blocks after streaminfo, process them
+				if (more) {
+					MUAF_BEGIN_PHASE(metadata_t, MUAF_PHASE_FLAC_METADATA);
+					res = muafFLAC_ProcessMetadata(file, profile, allocator);
+					MUAF_END_PHASE(metadata_t, MUAF_PHASE_FLAC_METADATA);
+					if (muaf_result_is_fatal(res)) {
+						mu_free_FLAC_profile_with_allocator(profile, allocator);
+						return res;
+					}
+				}
+
+				return res;
+			}
+
+			// Gets FLAC profile
+			MUDEF muafResult mu_get_FLAC_profile(const char* filename, muFLACProfile* profile) {
+				return mu_get_FLAC_profile_with_allocator(filename, profile, 0);
+			}
+
+			// Gets FLAC profile with allocator
+			MUDEF muafResult mu_get_FLAC_profile_with_allocator(const char* filename, muFLACProfile* profile, const muafAllocator* allocator) {
+				// Open file and read header prefix
+				muafInner_File file;
+				muByte prefix[MUAF_HEADER_PREFIX_SIZE];
+				if (muafInner_LoadFilePrefix(filename, &file, prefix, sizeof(prefix)) != 0) {
+					return MUAF_FAILED_OPEN_FILE;
+				}
+
+				// Make sure it's FLAC
+				if (!muafFLAC_IsFLAC(&file)) {
+					muafInner_DeloadFile(&file);
+					return MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION;
+				}
+
+				// Get profile
+				muafResult res = muafFLAC_GetProfile(&file, profile, allocator);
+
+				// Close file and return
+				muafInner_DeloadFile(&file);
+				return res;
+			}
+
+			// Frees FLAC profile
+			MUDEF void mu_free_FLAC_profile(muFLACProfile* profile) {
+				mu_free_FLAC_profile_with_allocator(profile, 0);
+			}
+
+			// Frees FLAC profile with allocator
+			MUDEF void mu_free_FLAC_profile_with_allocator(muFLACProfile* profile, const muafAllocator* allocator) {
+				// Free metadata blocks if they exist
+				if (profile->metadata_blocks != 0) {
+					muafInner_Free(allocator, profile->metadata_blocks);
+				}
+			}
+
+		/* Audio data */
+
+			/* CRC */
+
+				// Calculates CRC-8 (polynomial 0x07) of data
+				uint8_m muafFLAC_CRC8(muByte* data, size_m len) {
+					uint8_m crc = 0;
+					for (size_m i = 0; i < len; ++i) {
+						crc ^= data[i];
+						for (uint8_m b = 0; b < 8; ++b) {
+							crc = (crc & 0x80) ? (uint8_m)((crc << 1) ^ 0x07) : (uint8_m)(crc << 1);
+						}
+					}
+					return crc;
+				}
+
+				// Fills a table for calculating CRC-16 (polynomial 0x8005) byte-by-byte
+				void muafFLAC_CRC16Table(uint16_m table[256]) {
+					for (uint16_m i = 0; i < 256; ++i) {
+						uint16_m crc = (uint16_m)(i << 8);
+						for (uint8_m b = 0; b < 8; ++b) {
+							crc = (crc & 0x8000) ? (uint16_m)((crc << 1) ^ 0x8005) : (uint16_m)(crc << 1);
+						}
+						table[i] = crc;
+					}
+				}
+
+				// Calculates CRC-16 of data given table
+				uint16_m muafFLAC_CRC16(uint16_m table[256], muByte* data, size_m len) {
+					uint16_m crc = 0;
+					for (size_m i = 0; i < len; ++i) {
+						crc = (uint16_m)((crc << 8) ^ table[(crc >> 8) ^ data[i]]);
+					}
+					return crc;
+				}
+
+			/* Bit reading */
+
+				// Struct representing a buffered bit reader over a file
+				struct muafFLAC_BitReader {
+					muafInner_File* file;
+					// Index of the next byte in the file to be buffered
+					size_m file_index;
+					// Buffer (followed by 8 bytes of zero padding)
+					muByte* buf;
+					size_m cap;
+					// Amount of valid bytes in buffer
+					size_m len;
+					// Bit position in buffer
+					size_m bit;
+					// Byte position in buffer that must be kept when refilling (start of current frame)
+					size_m mark;
+					// If any read went past the end of the file
+					muBool error;
+				};
+				typedef struct muafFLAC_BitReader muafFLAC_BitReader;
+
+				// Initializes a bit reader at the given file index
+				muafResult muafFLAC_InitBitReader(muafFLAC_BitReader* r, muafInner_File* file, size_m index) {
+					r->buf = (muByte*)mu_malloc(MUAF_FLAC_READ_BUFFER_SIZE + 8);
+					if (!r->buf) {
+						return MUAF_FAILED_MALLOC;
+					}
+					r->file = file;
+					r->file_index = index;
+					r->cap = MUAF_FLAC_READ_BUFFER_SIZE;
+					r->len = 0;
+					r->bit = 0;
+					r->mark = 0;
+					r->error = MU_FALSE;
+					mu_memset(r->buf, 0, 8);
+					return MUAF_SUCCESS;
+				}
+
+				// Frees a bit reader's buffer
+				void muafFLAC_FreeBitReader(muafFLAC_BitReader* r) {
+					mu_free(r->buf);
+				}
+
+				// Refills a bit reader's buffer so that at least 'bytes' bytes are available past the current position
+				// Returns if there were enough bytes left in the file
+				muBool muafFLAC_Refill(muafFLAC_BitReader* r, size_m bytes) {
+					// Drop everything before the mark
+					if (r->mark != 0) {
+						size_m keep = r->len - r->mark;
+						for (size_m i = 0; i < keep; ++i) {
+							r->buf[i] = r->buf[r->mark + i];
+						}
+						r->len = keep;
+						r->bit -= r->mark * 8;
+						r->mark = 0;
+					}
+
+					// Grow buffer if what's needed doesn't fit
+					size_m needed = (r->bit / 8) + bytes;
+					if (needed > r->cap) {
+						size_m new_cap = r->cap * 2;
+						if (new_cap < needed) {
+							new_cap = needed;
+						}
+						muByte* new_buf = (muByte*)mu_realloc(r->buf, new_cap + 8);
+						if (!new_buf) {
+							return MU_FALSE;
+						}
+						r->buf = new_buf;
+						r->cap = new_cap;
+					}
+
+					// Read as much as fits
+					size_m read_len = r->cap - r->len;
+					if (read_len > r->file->len - r->file_index) {
+						read_len = r->file->len - r->file_index;
+					}
+					muafInner_LoadFromFile(r->file, r->file_index, read_len, r->buf + r->len);
+					r->file_index += read_len;
+					r->len += read_len;
+					mu_memset(r->buf + r->len, 0, 8);
+
+					return r->len >= needed;
+				}
+
+				// Makes sure that the given amount of bits are available
+				muBool muafFLAC_Available(muafFLAC_BitReader* r, size_m bits) {
+					if (r->bit + bits <= r->len * 8) {
+						return MU_TRUE;
+					}
+					if (muafFLAC_Refill(r, 8 + (bits / 8)) || r->bit + bits <= r->len * 8) {
+						return MU_TRUE;
+					}
+					r->error = MU_TRUE;
+					return MU_FALSE;
+				}
+
+				// Reads up to 32 bits as an unsigned value
+				uint32_m muafFLAC_ReadBits(muafFLAC_BitReader* r, uint8_m n) {
+					if (n == 0 || !muafFLAC_Available(r, n)) {
+						return 0;
+					}
+					// (Up to 39 bits are needed from the 8 loaded, and the buffer is padded)
+					uint64_m v = MU_RBEU64(r->buf + (r->bit / 8)) << (r->bit & 7);
+					r->bit += n;
+					return (uint32_m)(v >> (64 - n));
+				}
+
+				// Reads up to 33 bits as a signed value
+				int64_m muafFLAC_ReadSigned(muafFLAC_BitReader* r, uint8_m n) {
+					if (n == 0) {
+						return 0;
+					}
+					uint64_m v;
+					if (n > 32) {
+						v = ((uint64_m)muafFLAC_ReadBits(r, n - 32)) << 32;
+						v |= muafFLAC_ReadBits(r, 32);
+					} else {
+						v = muafFLAC_ReadBits(r, n);
+					}
+					// Sign-extend
+					if (v & (((uint64_m)1) << (n - 1))) {
+						return ((int64_m)v) - (int64_m)(((uint64_m)1) << n);
+					}
+					return (int64_m)v;
+				}
+
+				// Reads a unary-coded value (amount of 0 bits before a 1 bit)
+				uint64_m muafFLAC_ReadUnary(muafFLAC_BitReader* r) {
+					uint64_m count = 0;
+					while (muafFLAC_Available(r, 1)) {
+						// Look at up to 57 bits at once
+						size_m avail = (r->len * 8) - r->bit;
+						if (avail > 57) {
+							avail = 57;
+						}
+						uint64_m v = MU_RBEU64(r->buf + (r->bit / 8)) << (r->bit & 7);
+						v &= ~(uint64_m)0 << (64 - avail);
+
+						// All zero; keep going
+						if (v == 0) {
+							count += avail;
+							r->bit += avail;
+							continue;
+						}
+
+						// Count leading zeros
+						uint8_m zeros = 0;
+						while ((v & 0xFF00000000000000) == 0) {
+							v <<= 8;
+							zeros += 8;
+						}
+						while ((v & 0x8000000000000000) == 0) {
+							v <<= 1;
+							zeros += 1;
+						}
+						r->bit += zeros + 1;
+						return count + zeros;
+					}
+					return 0;
+				}
+
+				// Skips to the next byte boundary
+				void muafFLAC_AlignBits(muafFLAC_BitReader* r) {
+					r->bit = (r->bit + 7) & ~((size_m)7);
+				}
+
+			/* Decoding */
+
+				// Struct representing the state of decoding FLAC frames
+				struct muafFLAC_Decoder {
+					muafFLAC_BitReader r;
+					muFLACProfile* profile;
+					// Decoded samples of one block, one channel after the other
+					int64_m* samples;
+					uint16_m crc16[256];
+				};
+				typedef struct muafFLAC_Decoder muafFLAC_Decoder;
+
+				// Decodes a residual, storing it in samples after the warm-up samples
+				muafResult muafFLAC_DecodeResidual(muafFLAC_Decoder* d, int64_m* samples, uint32_m block_size, uint8_m order) {
+					// Coding method
+					uint8_m method = (uint8_m)muafFLAC_ReadBits(&d->r, 2);
+					if (method > 1) {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
+					uint8_m param_bits = (method == 0) ? 4 : 5;
+					uint8_m escape = (method == 0) ? 15 : 31;
+
+					// Partitions
+					uint8_m partition_order = (uint8_m)muafFLAC_ReadBits(&d->r, 4);
+					uint32_m partition_len = block_size >> partition_order;
+					if ((partition_len << partition_order) != block_size || partition_len < order) {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
+
+					uint32_m s = order;
+					for (uint32_m p = 0; p < (((uint32_m)1) << partition_order); ++p) {
+						uint8_m param = (uint8_m)muafFLAC_ReadBits(&d->r, param_bits);
+						uint32_m end = (p + 1) * partition_len;
+
+						// Escaped; values stored directly
+						if (param == escape) {
+							uint8_m bits = (uint8_m)muafFLAC_ReadBits(&d->r, 5);
+							for (; s < end; ++s) {
+								samples[s] = muafFLAC_ReadSigned(&d->r, bits);
+							}
+						}
+						// Rice-coded
+						else {
+							for (; s < end; ++s) {
+								// (Quotient is read before remainder)
+								uint64_m u = muafFLAC_ReadUnary(&d->r);
+								u = (u << param) | muafFLAC_ReadBits(&d->r, param);
+								samples[s] = (int64_m)(u >> 1) ^ -((int64_m)(u & 1));
+							}
+						}
+
+						if (d->r.error) {
+							return MUAF_INVALID_FLAC_FRAME;
+						}
+					}
+					return MUAF_SUCCESS;
+				}
+
+				// Decodes a subframe
+				muafResult muafFLAC_DecodeSubframe(muafFLAC_Decoder* d, int64_m* samples, uint32_m block_size, uint8_m bps) {
+					// Zero bit padding
+					if (muafFLAC_ReadBits(&d->r, 1) != 0) {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
+					// Subframe type
+					uint8_m type = (uint8_m)muafFLAC_ReadBits(&d->r, 6);
+					// Wasted bits
+					uint8_m wasted = 0;
+					if (muafFLAC_ReadBits(&d->r, 1)) {
+						uint64_m w = muafFLAC_ReadUnary(&d->r) + 1;
+						if (w >= bps) {
+							return MUAF_INVALID_FLAC_FRAME;
+						}
+						wasted = (uint8_m)w;
+						bps -= wasted;
+					}
+
+					// Constant
+					if (type == 0) {
+						int64_m v = muafFLAC_ReadSigned(&d->r, bps);
+						for (uint32_m s = 0; s < block_size; ++s) {
+							samples[s] = v;
+						}
+					}
+					// Verbatim
+					else if (type == 1) {
+						for (uint32_m s = 0; s < block_size; ++s) {
+							samples[s] = muafFLAC_ReadSigned(&d->r, bps);
+						}
+					}
+					// Fixed prediction
+					else if (type >= 8 && type <= 12) {
+						uint8_m order = type - 8;
+						if (order > block_size) {
+							return MUAF_INVALID_FLAC_FRAME;
+						}
+						for (uint8_m s = 0; s < order; ++s) {
+							samples[s] = muafFLAC_ReadSigned(&d->r, bps);
+						}
+						muafResult res = muafFLAC_DecodeResidual(d, samples, block_size, order);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+
+						// Predict
+						switch (order) {
+							default: break;
+							case 1: for (uint32_m s = 1; s < block_size; ++s) {
+								samples[s] += samples[s-1];
+							} break;
+							case 2: for (uint32_m s = 2; s < block_size; ++s) {
+								samples[s] += 2*samples[s-1] - samples[s-2];
+							} break;
+							case 3: for (uint32_m s = 3; s < block_size; ++s) {
+								samples[s] += 3*samples[s-1] - 3*samples[s-2] + samples[s-3];
+							} break;
+							case 4: for (uint32_m s = 4; s < block_size; ++s) {
+								samples[s] += 4*samples[s-1] - 6*samples[s-2] + 4*samples[s-3] - samples[s-4];
+							} break;
+						}
+					}
+					// Linear prediction
+					else if (type >= 32) {
+						uint8_m order = type - 31;
+						if (order > block_size) {
+							return MUAF_INVALID_FLAC_FRAME;
+						}
+						for (uint8_m s = 0; s < order; ++s) {
+							samples[s] = muafFLAC_ReadSigned(&d->r, bps);
+						}
+
+						// Coefficient precision and shift
+						uint8_m precision = (uint8_m)muafFLAC_ReadBits(&d->r, 4);
+						if (precision == 15) {
+							return MUAF_INVALID_FLAC_FRAME;
+						}
+						precision += 1;
+						int64_m shift = muafFLAC_ReadSigned(&d->r, 5);
+						if (shift < 0) {
+							return MUAF_INVALID_FLAC_FRAME;
+						}
+
+						// Coefficients
+						int64_m coefs[32];
+						for (uint8_m c = 0; c < order; ++c) {
+							coefs[c] = muafFLAC_ReadSigned(&d->r, precision);
+						}
+
+						muafResult res = muafFLAC_DecodeResidual(d, samples, block_size, order);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+
+						// Predict
+						for (uint32_m s = order; s < block_size; ++s) {
+							int64_m sum = 0;
+							for (uint8_m c = 0; c < order; ++c) {
+								sum += coefs[c] * samples[s - 1 - c];
+							}
+							samples[s] += sum >> shift;
+						}
+					}
+					// Reserved
+					else {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
 
-				// Check for RIFF
-				if (MU_RBEU32(data) != 0x52494646) {
-					return MU_FALSE;
-				}
-				// Skip size and check for WAVE
-				if (MU_RBEU32(data+8) != 0x57415645) {
-					return MU_FALSE;
+					if (d->r.error) {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
+
+					// Restore wasted bits
+					if (wasted != 0) {
+						for (uint32_m s = 0; s < block_size; ++s) {
+							samples[s] *= ((int64_m)1) << wasted;
+						}
+					}
+					return MUAF_SUCCESS;
 				}
 
-				// Has RIFF and WAVE, so likely WAVE.
-				return MU_TRUE;
-			}
+				// Decodes the next frame into the decoder's samples
+				muafResult muafFLAC_DecodeFrame(muafFLAC_Decoder* d, uint32_m* block_size) {
+					muafFLAC_BitReader* r = &d->r;
+					muFLACProfile* profile = d->profile;
 
-			// Returns WAVE support for given audio formats
-			muBool muafWAVE_FormatSupport(muafAudioFormat format) {
-				// Perform based on audio format
-				switch (format) {
-					// Unknown
-					default: return MU_FALSE; break;
+					// Keep frame in buffer for CRC
+					r->mark = r->bit / 8;
 
-					// Supported PCM
-					case MUAF_FORMAT_PCM_U8:  case MUAF_FORMAT_PCM_S16:
-					case MUAF_FORMAT_PCM_S24: case MUAF_FORMAT_PCM_S32:
-					case MUAF_FORMAT_PCM_S64:
-						return MU_TRUE;
-					break;
-				}
-			}
+					// Sync code + reserved bit
+					if (muafFLAC_ReadBits(r, 15) != 0x7FFC) {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
+					// Blocking strategy (not needed for decoding)
+					muafFLAC_ReadBits(r, 1);
+
+					uint8_m block_size_bits = (uint8_m)muafFLAC_ReadBits(r, 4);
+					uint8_m sample_rate_bits = (uint8_m)muafFLAC_ReadBits(r, 4);
+					uint8_m channel_bits = (uint8_m)muafFLAC_ReadBits(r, 4);
+					uint8_m bit_depth_bits = (uint8_m)muafFLAC_ReadBits(r, 3);
+					if (muafFLAC_ReadBits(r, 1) != 0) {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
 
-		/* Profiling */
+					// Coded number (frame or sample number; not needed for decoding)
+					uint8_m coded = (uint8_m)muafFLAC_ReadBits(r, 8);
+					if (coded & 0x80) {
+						uint8_m extra = 0;
+						while (coded & (0x40 >> extra)) {
+							++extra;
+						}
+						if (extra == 0 || extra > 6) {
+							return MUAF_INVALID_FLAC_FRAME;
+						}
+						for (uint8_m i = 0; i < extra; ++i) {
+							if ((muafFLAC_ReadBits(r, 8) & 0xC0) != 0x80) {
+								return MUAF_INVALID_FLAC_FRAME;
+							}
+						}
+					}
 
-			// Gets chunk information about WAVE file
-			// Does check for required chunks
-			muafResult muafWAVE_GetChunks(muafInner_File* file, muWAVEProfile* profile) {
-				// Start after RIFF, ckSize, and WAVE
-				size_m beg_i = 12;
-				// Loop through each chunk
-				while (MU_TRUE) {
-					// Account for pad byte
-					if (beg_i % 2 != 0) {
-						beg_i += 1;
+					// Block size
+					switch (block_size_bits) {
+						default: *block_size = ((uint32_m)256) << (block_size_bits - 8); break;
+						case 0: return MUAF_INVALID_FLAC_FRAME; break;
+						case 1: *block_size = 192; break;
+						case 2: case 3: case 4: case 5: *block_size = ((uint32_m)576) << (block_size_bits - 2); break;
+						case 6: *block_size = muafFLAC_ReadBits(r, 8) + 1; break;
+						case 7: *block_size = muafFLAC_ReadBits(r, 16) + 1; break;
+					}
+					if (*block_size > profile->max_block_size) {
+						return MUAF_INVALID_FLAC_FRAME;
 					}
 
-					// Break out of loop if we're at end of file now
-					// + ensure length for ckID and ckSize
-					if (beg_i >= file->len || file->len-beg_i < 8) {
-						break;
+					// Sample rate (not needed for decoding)
+					switch (sample_rate_bits) {
+						default: break;
+						case 12: muafFLAC_ReadBits(r, 8); break;
+						case 13: case 14: muafFLAC_ReadBits(r, 16); break;
+						case 15: return MUAF_INVALID_FLAC_FRAME; break;
 					}
 
-					// Get data for ckID and ckSize
-					muByte ck_data[8];
-					muafInner_LoadFromFile(file, beg_i, 8, ck_data);
+					// Bit depth
+					uint8_m bps;
+					switch (bit_depth_bits) {
+						default: return MUAF_INVALID_FLAC_FRAME; break;
+						case 0: bps = profile->bits_per_sample; break;
+						case 1: bps = 8; break;
+						case 2: bps = 12; break;
+						case 4: bps = 16; break;
+						case 5: bps = 20; break;
+						case 6: bps = 24; break;
+						case 7: bps = 32; break;
+					}
+					if (bps != profile->bits_per_sample) {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
 
-					// Read ID and length
-					uint32_m ck_id = MU_RBEU32(ck_data);
-					uint32_m len = MU_RLEU32(ck_data+4);
-					// Verify length
-					if (beg_i + 8 + len > file->len) {
-						return MUAF_INVALID_WAVE_CHUNK_LENGTH_FOR_FILE;
+					// Channels
+					uint8_m channels = (channel_bits < 8) ? (channel_bits + 1) : 2;
+					if (channel_bits > 10 || channels != profile->num_channels) {
+						return MUAF_INVALID_FLAC_FRAME;
 					}
 
-					size_m* pid = 0;
-					uint32_m* plen = 0;
-					switch (ck_id) {
+					// Header CRC
+					// (Calculated before the CRC is read, since reading can move the buffer)
+					if (r->error) {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
+					uint8_m header_crc = muafFLAC_CRC8(r->buf + r->mark, (r->bit / 8) - r->mark);
+					if (header_crc != (uint8_m)muafFLAC_ReadBits(r, 8) || r->error) {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
+
+					// Subframes
+					for (uint8_m ch = 0; ch < channels; ++ch) {
+						// (Side channels have an extra bit)
+						uint8_m sub_bps = bps;
+						if ((channel_bits == 8 && ch == 1) || (channel_bits == 9 && ch == 0) || (channel_bits == 10 && ch == 1)) {
+							sub_bps += 1;
+						}
+						muafResult res = muafFLAC_DecodeSubframe(d, d->samples + (((size_m)ch) * profile->max_block_size), *block_size, sub_bps);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+					}
+
+					// Footer CRC
+					// (Refilling moves the frame to the start of the buffer, but the mark follows it)
+					muafFLAC_AlignBits(r);
+					uint16_m crc = muafFLAC_CRC16(d->crc16, r->buf + r->mark, (r->bit / 8) - r->mark);
+					if (crc != (uint16_m)muafFLAC_ReadBits(r, 16) || r->error) {
+						return MUAF_INVALID_FLAC_FRAME;
+					}
+
+					// Undo stereo decorrelation
+					int64_m* a = d->samples;
+					int64_m* b = d->samples + profile->max_block_size;
+					switch (channel_bits) {
 						default: break;
-						// fmt
-						case 0x666D7420: {
-							pid = &profile->chunks.fmt;
-							plen = &profile->chunks.fmt_len;
-						} break;
-						// wave
-						case 0x64617461: {
-							pid = &profile->chunks.wave;
-							plen = &profile->chunks.wave_len;
-						} break;
-						// fact
-						case 0x66616374: {
-							pid = &profile->chunks.fact;
-							plen = &profile->chunks.fact_len;
-						} break;
-						// cue
-						case 0x63756520: {
-							pid = &profile->chunks.cue;
-							plen = &profile->chunks.cue_len;
+						// Left/side
+						case 8: for (uint32_m s = 0; s < *block_size; ++s) {
+							b[s] = a[s] - b[s];
 						} break;
-						// playlist
-						case 0x706C7374: {
-							pid = &profile->chunks.playlist;
-							plen = &profile->chunks.playlist_len;
+						// Side/right
+						case 9: for (uint32_m s = 0; s < *block_size; ++s) {
+							a[s] += b[s];
 						} break;
-						// LIST
-						case 0x4C495354: {
-							// Read list type
-							if (len > 4) {
-								muByte list_type[4];
-								muafInner_LoadFromFile(file, beg_i+8, 4, list_type);
-								uint32_m ulist_type = MU_RBEU32(list_type);
-								switch (ulist_type) {
-									default: break;
-									// assoc-data
-									case 0x6164746C: {
-										pid = &profile->chunks.assoc_data;
-										plen = &profile->chunks.assoc_data_len;
-									} break;
-								}
-							}
+						// Mid/side
+						case 10: for (uint32_m s = 0; s < *block_size; ++s) {
+							int64_m mid = (a[s] * 2) | (b[s] & 1);
+							a[s] = (mid + b[s]) >> 1;
+							b[s] = (mid - b[s]) >> 1;
 						} break;
 					}
 
-					// Record ID and length if necessary
-					if (pid && plen) {
-						*pid = beg_i + 8;
-						*plen = len;
-					}
-					// Move to next chunk
-					beg_i += 8 + len;
+					return MUAF_SUCCESS;
 				}
 
-				// Make sure fmt and wave data have been defined
-				if (!profile->chunks.fmt) {
-					return MUAF_INVALID_WAVE_MISSING_FMT;
-				}
-				if (!profile->chunks.wave) {
-					return MUAF_INVALID_WAVE_MISSING_WAVE_DATA;
+				// Returns the index of the first frame in a FLAC file
+				size_m muafFLAC_AudioIndex(muFLACProfile* profile) {
+					if (profile->num_metadata_blocks == 0) {
+						return 42;
+					}
+					muFLACMetadataBlock* last = &profile->metadata_blocks[profile->num_metadata_blocks - 1];
+					return last->index + last->length;
 				}
 
-				return MUAF_SUCCESS;
-			}
+			/* Bit writing */
 
-			// Gets fmt WAVE PCM info
-			muafResult muafWAVE_GetFmtPCMInfo(muafInner_File* file, muWAVEProfile* profile) {
-				// Ensure extra length
-				if (profile->chunks.fmt_len < 14+2) {
-					return MUAF_INVALID_WAVE_FMT_LENGTH;
-				}
-				// Read PCM-format-specific data
-				muByte pcm_format_spec[2];
-				muafInner_LoadFromFile(file, profile->chunks.fmt+14, 2, pcm_format_spec);
+				// Struct representing a bit writer into a buffer
+				struct muafFLAC_BitWriter {
+					muByte* buf;
+					// Amount of bytes written to buffer
+					size_m len;
+					// Bits not yet written to buffer (the lowest 'acc_bits' bits)
+					uint64_m acc;
+					uint8_m acc_bits;
+				};
+				typedef struct muafFLAC_BitWriter muafFLAC_BitWriter;
 
-				// Allocate struct
-				profile->specific_fields.wave_pcm = (muWAVEPCM*)mu_malloc(sizeof(muWAVEPCM));
-				if (!profile->specific_fields.wave_pcm) {
-					return MUAF_FAILED_MALLOC;
+				// Writes up to 32 bits
+				void muafFLAC_WriteBits(muafFLAC_BitWriter* w, uint32_m v, uint8_m n) {
+					if (n == 0) {
+						return;
+					}
+					// Move whole bytes to buffer
+					while (w->acc_bits >= 8) {
+						w->acc_bits -= 8;
+						w->buf[w->len++] = (muByte)(w->acc >> w->acc_bits);
+					}
+					w->acc = (w->acc << n) | (((uint64_m)v) & ((((uint64_m)1) << n) - 1));
+					w->acc_bits += n;
 				}
 
-				// Read bits per sample
-				profile->specific_fields.wave_pcm->bits_per_sample = MU_RLEU16(pcm_format_spec);
-				// - Verify it doesn't equal 0
-				if (profile->specific_fields.wave_pcm->bits_per_sample == 0) {
-					return MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE;
-				}
-				// - Verify it's divisible by 8
-				if (profile->specific_fields.wave_pcm->bits_per_sample % 8 != 0) {
-					return MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE;
-				}
-				// - Verify it works with wBlockAlign
-				if (((uint64_m)profile->channels) * (((uint64_m)profile->specific_fields.wave_pcm->bits_per_sample) / 8) != profile->block_align) {
-					return MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE;
+				// Writes a signed value in up to 32 bits
+				void muafFLAC_WriteSigned(muafFLAC_BitWriter* w, int64_m v, uint8_m n) {
+					muafFLAC_WriteBits(w, (uint32_m)(uint64_m)v, n);
 				}
-				// - Verify it works with wave data length
-				if (profile->chunks.wave_len % (profile->specific_fields.wave_pcm->bits_per_sample / 8) != 0) {
-					return MUAF_INVALID_WAVE_FMT_PCM_BITS_PER_SAMPLE;
-				}
-
-				return MUAF_SUCCESS;
-			}
 
-			// Gets fmt information from WAVE file
-			// Chunks need to be loaded before this
-			muafResult muafWAVE_GetFmtInfo(muafInner_File* file, muWAVEProfile* profile) {
-				// Ensure minimum fmt length
-				if (profile->chunks.fmt_len < 14) {
-					return MUAF_INVALID_WAVE_FMT_LENGTH;
+				// Writes a zigzagged value Rice-coded with the given parameter
+				void muafFLAC_WriteRice(muafFLAC_BitWriter* w, uint64_m u, uint8_m param) {
+					uint64_m q = u >> param;
+					uint32_m low = (uint32_m)(u & ((((uint64_m)1) << param) - 1));
+					// Write all at once if possible
+					if (q + 1 + param <= 32) {
+						muafFLAC_WriteBits(w, (((uint32_m)1) << param) | low, (uint8_m)(q + 1 + param));
+						return;
+					}
+					// Unary quotient, then remainder
+					while (q >= 32) {
+						muafFLAC_WriteBits(w, 0, 32);
+						q -= 32;
+					}
+					muafFLAC_WriteBits(w, 1, (uint8_m)(q + 1));
+					muafFLAC_WriteBits(w, low, param);
 				}
 
-				// Read fmt-ck's common-fields
-				muByte fmt_common_fields[14];
-				muafInner_LoadFromFile(file, profile->chunks.fmt, 14, fmt_common_fields);
+				// Pads to the next byte boundary and moves all bits to buffer
+				void muafFLAC_FlushBits(muafFLAC_BitWriter* w) {
+					muafFLAC_WriteBits(w, 0, (8 - (w->acc_bits & 7)) & 7);
+					while (w->acc_bits >= 8) {
+						w->acc_bits -= 8;
+						w->buf[w->len++] = (muByte)(w->acc >> w->acc_bits);
+					}
+				}
 
-				// Read values
-				profile->format_tag = MU_RLEU16(fmt_common_fields);
+			/* Encoding */
+
+				// Struct representing how a subframe is going to be encoded
+				struct muafFLAC_SubframePlan {
+					// 0 = constant, 1 = verbatim, 2 = fixed prediction
+					uint8_m type;
+					uint8_m order;
+					uint8_m partition_order;
+					// Rice parameter of each partition
+					uint8_m params[256];
+					// Size of subframe in bits
+					uint64_m bits;
+				};
+				typedef struct muafFLAC_SubframePlan muafFLAC_SubframePlan;
+
+				// Struct representing the state of encoding FLAC frames
+				struct muafFLAC_Encoder {
+					uint16_m channels;
+					uint8_m bps;
+					uint32_m block_size;
+					// Samples of one block, one channel after the other
+					int64_m* samples;
+					// Mid and side channels of one block
+					int64_m* mid;
+					int64_m* side;
+					// Zigzagged residual of one channel
+					uint64_m* residual;
+					// Residual sums of each partition
+					uint64_m sums[256];
+					// Plans for each channel (or left, right, mid, side)
+					muafFLAC_SubframePlan plans[8];
+					muafFLAC_BitWriter w;
+					uint16_m crc16[256];
+				};
+				typedef struct muafFLAC_Encoder muafFLAC_Encoder;
+
+				// Allocates encoder buffers
+				muafResult muafFLAC_InitEncoder(muafFLAC_Encoder* e, uint16_m channels, uint8_m bps, uint32_m block_size) {
+					e->channels = channels;
+					e->bps = bps;
+					e->block_size = block_size;
+
+					// Largest possible frame: header, verbatim subframes (with a side channel's extra bit), and footer
+					size_m frame_cap = 32 + (((size_m)channels) * (3 + ((((size_m)block_size) * (bps + 1)) + 7) / 8));
+
+					e->samples = (int64_m*)mu_malloc(sizeof(int64_m) * ((size_m)block_size) * (channels + 2));
+					e->residual = (uint64_m*)mu_malloc(sizeof(uint64_m) * ((size_m)block_size));
+					e->w.buf = (muByte*)mu_malloc(frame_cap);
+					if (!e->samples || !e->residual || !e->w.buf) {
+						if (e->samples) mu_free(e->samples);
+						if (e->residual) mu_free(e->residual);
+						if (e->w.buf) mu_free(e->w.buf);
+						return MUAF_FAILED_MALLOC;
+					}
+					e->mid = e->samples + (((size_m)block_size) * channels);
+					e->side = e->mid + block_size;
 
-				profile->channels = MU_RLEU16(fmt_common_fields + 2);
-				if (profile->channels == 0) {
-					return MUAF_INVALID_WAVE_FMT_CHANNELS;
+					muafFLAC_CRC16Table(e->crc16);
+					return MUAF_SUCCESS;
 				}
 
-				profile->samples_per_sec = MU_RLEU32(fmt_common_fields + 4);
-				if (profile->samples_per_sec == 0) {
-					return MUAF_INVALID_WAVE_FMT_SAMPLES_PER_SEC;
+				// Frees encoder buffers
+				void muafFLAC_FreeEncoder(muafFLAC_Encoder* e) {
+					mu_free(e->samples);
+					mu_free(e->residual);
+					mu_free(e->w.buf);
 				}
 
-				// Make sure to verify these values if muaf ever uses them!
-				profile->avg_bytes_per_sec = MU_RLEU32(fmt_common_fields + 8);
-				profile->block_align = MU_RLEU16(fmt_common_fields + 12);
-
-				// Allocate and read any format specific fields
-				switch (profile->format_tag) {
-					default: break;
-					// WAVE PCM
-					case MU_WAVE_FORMAT_PCM: {
-						muafResult res = muafWAVE_GetFmtPCMInfo(file, profile);
-						if (muaf_result_is_fatal(res)) {
-							return res;
+				// Calculates the zigzagged residual of fixed prediction
+				// Returns false if the residual doesn't fit in 32 bits
+				muBool muafFLAC_FixedResidual(int64_m* x, uint32_m n, uint8_m order, uint64_m* u) {
+					for (uint32_m s = order; s < n; ++s) {
+						int64_m r;
+						switch (order) {
+							default: r = x[s]; break;
+							case 1: r = x[s] - x[s-1]; break;
+							case 2: r = x[s] - 2*x[s-1] + x[s-2]; break;
+							case 3: r = x[s] - 3*x[s-1] + 3*x[s-2] - x[s-3]; break;
+							case 4: r = x[s] - 4*x[s-1] + 6*x[s-2] - 4*x[s-3] + x[s-4]; break;
 						}
-					} break;
-				}
-
-				return MUAF_SUCCESS;
-			}
-
-			// Handles ckSize in case it's shorter than the file length
-			// Call muafWAVE_IsWAVE BEFORE this!!
-			void muafWAVE_HandleCkSize(muafInner_File* file) {
-				// Read ckSize
-				muByte data[4];
-				muafInner_LoadFromFile(file, 4, 4, data);
-				size_m ck_size = MU_RLEU32(data) + 8;
-				if (ck_size < file->len) {
-					file->len = ck_size;
+						if (r > 2147483647 || r < -((int64_m)2147483647) - 1) {
+							return MU_FALSE;
+						}
+						u[s] = (r >= 0) ? (((uint64_m)r) * 2) : ((((uint64_m)(-r)) * 2) - 1);
+					}
+					return MU_TRUE;
 				}
-			}
 
-			// Gets WAVE profile
-			MUDEF muafResult mu_get_WAVE_profile(const char* filename, muWAVEProfile* profile) {
-				// Open file
-				muafInner_File file;
-				if (muafInner_LoadFile(filename, &file) != 0) {
-					return MUAF_FAILED_OPEN_FILE;
-				}
-				
-				// Make sure it's WAVE
-				if (!muafWAVE_IsWAVE(&file)) {
-					muafInner_DeloadFile(&file);
-					return MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION;
+				// Returns the Rice parameter with the lowest estimated cost for a partition
+				uint8_m muafFLAC_RiceParam(uint32_m count, uint64_m sum) {
+					// Cost is estimated as count*(k+1) + sum>>k, which decreases then increases
+					uint8_m k = 0;
+					while (k < 30 && (((uint64_m)count) + (sum >> (k + 1))) < (sum >> k)) {
+						++k;
+					}
+					return k;
 				}
-				// Correct file length based on ckSize
-				muafWAVE_HandleCkSize(&file);
-
-				// Zero-out profile memory
-				mu_memset(profile, 0, sizeof(muWAVEProfile));
 
-				// Get chunk information
-				muafResult res = muafWAVE_GetChunks(&file, profile);
-				if (muaf_result_is_fatal(res)) {
-					muafInner_DeloadFile(&file);
-					return res;
-				}
-				// Get fmt information
-				res = muafWAVE_GetFmtInfo(&file, profile);
-				if (muaf_result_is_fatal(res)) {
-					muafInner_DeloadFile(&file);
-					mu_free_WAVE_profile(profile);
-					return res;
-				}
+				// Picks the partition order and Rice parameters for a residual
+				// Returns the exact size of the residual coding in bits
+				uint64_m muafFLAC_PlanRice(muafFLAC_Encoder* e, uint64_m* u, uint32_m n, uint8_m order, muafFLAC_SubframePlan* plan) {
+					// Find highest usable partition order
+					uint8_m max_order = 0;
+					while (max_order < 8 && ((n >> (max_order + 1)) << (max_order + 1)) == n && (n >> (max_order + 1)) >= order) {
+						++max_order;
+					}
 
-				// Close file
-				muafInner_DeloadFile(&file);
-				return res;
-			}
+					// Sum each partition at the highest order
+					uint32_m len = n >> max_order;
+					for (uint32_m p = 0; p < (((uint32_m)1) << max_order); ++p) {
+						uint64_m sum = 0;
+						uint32_m end = (p + 1) * len;
+						for (uint32_m s = (p == 0) ? order : p * len; s < end; ++s) {
+							sum += u[s];
+						}
+						e->sums[p] = sum;
+					}
 
-			// Frees memory for WAVE profile
-			MUDEF void mu_free_WAVE_profile(muWAVEProfile* profile) {
-				// Free format specific fields if it exists
-				// Any member will do for this check due to overlapping union memory
-				if (profile->specific_fields.wave_pcm != 0) {
-					mu_free(profile->specific_fields.wave_pcm);
-				}
-			}
+					// Estimate each partition order, merging sums on the way down
+					uint64_m best = ~(uint64_m)0;
+					for (uint8_m po = max_order + 1; po-- > 0;) {
+						uint32_m parts = ((uint32_m)1) << po;
+						len = n >> po;
+						uint8_m params[256];
+						uint64_m bits = 6;
+						uint8_m max_param = 0;
+						for (uint32_m p = 0; p < parts; ++p) {
+							uint32_m count = len - ((p == 0) ? order : 0);
+							params[p] = muafFLAC_RiceParam(count, e->sums[p]);
+							if (params[p] > max_param) {
+								max_param = params[p];
+							}
+							bits += (((uint64_m)count) * (params[p] + 1)) + (e->sums[p] >> params[p]);
+						}
+						bits += ((uint64_m)parts) * ((max_param > 14) ? 5 : 4);
 
-		/* Reading */
+						if (bits < best) {
+							best = bits;
+							plan->partition_order = po;
+							mu_memcpy(plan->params, params, parts);
+						}
 
-			/* PCM reading */
+						// Merge sums for the next order down
+						for (uint32_m p = 0; p < parts / 2; ++p) {
+							e->sums[p] = e->sums[p*2] + e->sums[p*2 + 1];
+						}
+					}
 
-				// MUAF_FORMAT_PCM_U8
-				muafResult muafWAVE_ReadPCMU8(muafInner_File* file, muWAVEProfile* profile, uint32_m beg_frame, uint32_m frame_len, uint8_m* data) {
-					// Read data from file
-					muafInner_LoadFromFile(file, profile->chunks.wave + (beg_frame * profile->channels), frame_len * profile->channels, data);
-					return MUAF_SUCCESS;
+					// Calculate exact size
+					uint32_m parts = ((uint32_m)1) << plan->partition_order;
+					len = n >> plan->partition_order;
+					uint8_m max_param = 0;
+					uint64_m bits = 6;
+					for (uint32_m p = 0; p < parts; ++p) {
+						uint8_m k = plan->params[p];
+						if (k > max_param) {
+							max_param = k;
+						}
+						uint32_m end = (p + 1) * len;
+						for (uint32_m s = (p == 0) ? order : p * len; s < end; ++s) {
+							bits += (u[s] >> k) + 1 + k;
+						}
+					}
+					bits += ((uint64_m)parts) * ((max_param > 14) ? 5 : 4);
+					return bits;
 				}
 
-				// MUAF_FORMAT_PCM_S16
-				muafResult muafWAVE_ReadPCMS16(muafInner_File* file, muWAVEProfile* profile, uint32_m beg_frame, uint32_m frame_len, int16_m* data) {
-					// Read data from file
-					muafInner_LoadFromFile(file, profile->chunks.wave + (beg_frame * 2 * profile->channels), frame_len * 2 * profile->channels, (muByte*)data);
-					// Correct byte orders
-					uint32_m sample_count = frame_len * profile->channels;
-					for (uint32_m s = 0; s < sample_count; ++s) {
-						int16_m sample = MU_RLES16(((muByte*)data)+(s*2));
-						data[s] = sample;
+				// Picks the smallest way to encode a subframe
+				void muafFLAC_PlanSubframe(muafFLAC_Encoder* e, int64_m* x, uint32_m n, uint8_m bps, muafFLAC_SubframePlan* plan) {
+					// Constant
+					uint32_m s = 1;
+					while (s < n && x[s] == x[0]) {
+						++s;
+					}
+					if (s == n) {
+						plan->type = 0;
+						plan->bits = 8 + bps;
+						return;
+					}
+
+					// Verbatim
+					plan->type = 1;
+					plan->bits = 8 + (((uint64_m)n) * bps);
+
+					// Fixed prediction
+					muafFLAC_SubframePlan trial;
+					for (uint8_m order = 0; order <= 4 && order < n; ++order) {
+						if (!muafFLAC_FixedResidual(x, n, order, e->residual)) {
+							continue;
+						}
+						trial.type = 2;
+						trial.order = order;
+						trial.bits = 8 + (((uint64_m)order) * bps) + muafFLAC_PlanRice(e, e->residual, n, order, &trial);
+						if (trial.bits < plan->bits) {
+							*plan = trial;
+						}
 					}
-					return MUAF_SUCCESS;
 				}
 
-				// MUAF_FORMAT_PCM_S24
-				muafResult muafWAVE_ReadPCMS24(muafInner_File* file, muWAVEProfile* profile, uint32_m beg_frame, uint32_m frame_len, int32_m* data) {
-					// Allocate and read data from file
-					muByte* b_data = (muByte*)mu_malloc(frame_len * 3);
-					if (!b_data) {
-						return MUAF_FAILED_MALLOC;
+				// Writes a subframe based on its plan
+				void muafFLAC_WriteSubframe(muafFLAC_Encoder* e, int64_m* x, uint32_m n, uint8_m bps, muafFLAC_SubframePlan* plan) {
+					muafFLAC_BitWriter* w = &e->w;
+
+					// Zero bit padding, type, and no wasted bits
+					uint8_m type = (plan->type == 2) ? (8 + plan->order) : plan->type;
+					muafFLAC_WriteBits(w, type << 1, 8);
+
+					// Constant
+					if (plan->type == 0) {
+						muafFLAC_WriteSigned(w, x[0], bps);
+						return;
+					}
+					// Verbatim
+					if (plan->type == 1) {
+						for (uint32_m s = 0; s < n; ++s) {
+							muafFLAC_WriteSigned(w, x[s], bps);
+						}
+						return;
 					}
-					muafInner_LoadFromFile(file, profile->chunks.wave + (beg_frame * 3 * profile->channels), frame_len * 3 * profile->channels, b_data);
 
-					// Copy over data
-					uint32_m sample_count = frame_len * profile->channels;
-					for (uint32_m s = 0; s < sample_count; ++s) {
-						data[s] = MU_RLES24(b_data+(s*3));
+					// Fixed prediction warm-up samples
+					for (uint8_m s = 0; s < plan->order; ++s) {
+						muafFLAC_WriteSigned(w, x[s], bps);
 					}
 
-					// Free data and return
-					mu_free(b_data);
-					return MUAF_SUCCESS;
+					// Residual
+					muafFLAC_FixedResidual(x, n, plan->order, e->residual);
+					uint32_m parts = ((uint32_m)1) << plan->partition_order;
+					uint8_m param_bits = 4;
+					for (uint32_m p = 0; p < parts; ++p) {
+						if (plan->params[p] > 14) {
+							param_bits = 5;
+						}
+					}
+					muafFLAC_WriteBits(w, (param_bits == 4) ? 0 : 1, 2);
+					muafFLAC_WriteBits(w, plan->partition_order, 4);
+
+					uint32_m len = n >> plan->partition_order;
+					for (uint32_m p = 0; p < parts; ++p) {
+						muafFLAC_WriteBits(w, plan->params[p], param_bits);
+						uint32_m end = (p + 1) * len;
+						for (uint32_m s = (p == 0) ? plan->order : p * len; s < end; ++s) {
+							muafFLAC_WriteRice(w, e->residual[s], plan->params[p]);
+						}
+					}
 				}
 
-				// MUAF_FORMAT_PCM_S32
-				muafResult muafWAVE_ReadPCMS32(muafInner_File* file, muWAVEProfile* profile, uint32_m beg_frame, uint32_m frame_len, int32_m* data) {
-					// Read data from file
-					muafInner_LoadFromFile(file, profile->chunks.wave + (beg_frame * 4 * profile->channels), frame_len * 4 * profile->channels, (muByte*)data);
-					// Correct byte orders
-					uint32_m sample_count = frame_len * profile->channels;
-					for (uint32_m s = 0; s < sample_count; ++s) {
-						int16_m sample = MU_RLES32(((muByte*)data)+(s*4));
-						data[s] = sample;
+				// Encodes a frame of the encoder's samples into its bit writer
+				void muafFLAC_EncodeFrame(muafFLAC_Encoder* e, uint32_m frame_index, uint32_m n) {
+					muafFLAC_BitWriter* w = &e->w;
+					w->len = 0;
+					w->acc = 0;
+					w->acc_bits = 0;
+
+					// Plan subframes, picking stereo decorrelation if it's smaller
+					uint8_m channel_bits = (uint8_m)(e->channels - 1);
+					if (e->channels == 2 && e->bps < 32) {
+						int64_m* l = e->samples;
+						int64_m* r = e->samples + e->block_size;
+						for (uint32_m s = 0; s < n; ++s) {
+							e->side[s] = l[s] - r[s];
+							e->mid[s] = (l[s] + r[s]) >> 1;
+						}
+						muafFLAC_PlanSubframe(e, l, n, e->bps, &e->plans[0]);
+						muafFLAC_PlanSubframe(e, r, n, e->bps, &e->plans[1]);
+						muafFLAC_PlanSubframe(e, e->mid, n, e->bps, &e->plans[2]);
+						muafFLAC_PlanSubframe(e, e->side, n, e->bps + 1, &e->plans[3]);
+
+						uint64_m lr = e->plans[0].bits + e->plans[1].bits;
+						uint64_m ls = e->plans[0].bits + e->plans[3].bits;
+						uint64_m rs = e->plans[3].bits + e->plans[1].bits;
+						uint64_m ms = e->plans[2].bits + e->plans[3].bits;
+						if (ls < lr && ls <= rs && ls <= ms) {
+							channel_bits = 8;
+						} else if (rs < lr && rs <= ms) {
+							channel_bits = 9;
+						} else if (ms < lr) {
+							channel_bits = 10;
+						}
+					} else {
+						for (uint16_m ch = 0; ch < e->channels; ++ch) {
+							muafFLAC_PlanSubframe(e, e->samples + (((size_m)ch) * e->block_size), n, e->bps, &e->plans[ch]);
+						}
 					}
-					return MUAF_SUCCESS;
-				}
 
-				// MUAF_FORMAT_PCM_S64
-				muafResult muafWAVE_ReadPCMS64(muafInner_File* file, muWAVEProfile* profile, uint32_m beg_frame, uint32_m frame_len, int64_m* data) {
-					// Read data from file
-					muafInner_LoadFromFile(file, profile->chunks.wave + (beg_frame * 8 * profile->channels), frame_len * 8 * profile->channels, (muByte*)data);
-					// Correct byte orders
-					uint32_m sample_count = frame_len * profile->channels;
-					for (uint32_m s = 0; s < sample_count; ++s) {
-						int16_m sample = MU_RLES64(((muByte*)data)+(s*8));
-						data[s] = sample;
+					// Block size
+					uint8_m block_size_bits;
+					switch (n) {
+						default: block_size_bits = (n <= 256) ? 6 : 7; break;
+						case 192: block_size_bits = 1; break;
+						case 576: block_size_bits = 2; break;
+						case 1152: block_size_bits = 3; break;
+						case 2304: block_size_bits = 4; break;
+						case 4608: block_size_bits = 5; break;
+						case 256: block_size_bits = 8; break;
+						case 512: block_size_bits = 9; break;
+						case 1024: block_size_bits = 10; break;
+						case 2048: block_size_bits = 11; break;
+						case 4096: block_size_bits = 12; break;
+						case 8192: block_size_bits = 13; break;
+						case 16384: block_size_bits = 14; break;
+						case 32768: block_size_bits = 15; break;
 					}
-					return MUAF_SUCCESS;
-				}
 
-				// Reads PCM data from WAVE file given inner file
-				muafResult muafWAVE_ReadPCM(muafInner_File* file, muWAVEProfile* profile, muafAudioFormat format, uint32_m beg_frame, uint32_m frame_len, muByte* data) {
-					// Perform based on format
-					switch (format) {
-						// Unknown
-						default: return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT; break;
-						// PCM
-						case MUAF_FORMAT_PCM_U8:  return muafWAVE_ReadPCMU8 (file, profile, beg_frame, frame_len, (uint8_m*)data); break;
-						case MUAF_FORMAT_PCM_S16: return muafWAVE_ReadPCMS16(file, profile, beg_frame, frame_len, (int16_m*)data); break;
-						case MUAF_FORMAT_PCM_S24: return muafWAVE_ReadPCMS24(file, profile, beg_frame, frame_len, (int32_m*)data); break;
-						case MUAF_FORMAT_PCM_S32: return muafWAVE_ReadPCMS32(file, profile, beg_frame, frame_len, (int32_m*)data); break;
-						case MUAF_FORMAT_PCM_S64: return muafWAVE_ReadPCMS64(file, profile, beg_frame, frame_len, (int64_m*)data); break;
+					// Sync code, reserved bit, and fixed block size
+					muafFLAC_WriteBits(w, 0xFFF8, 16);
+					// Block size, sample rate (from streaminfo), channels, bit depth (from streaminfo), and reserved bit
+					muafFLAC_WriteBits(w, ((uint32_m)block_size_bits << 4), 8);
+					muafFLAC_WriteBits(w, ((uint32_m)channel_bits << 4), 8);
+
+					// Coded frame number
+					if (frame_index < 0x80) {
+						muafFLAC_WriteBits(w, frame_index, 8);
+					} else {
+						uint8_m extra = 1;
+						while (extra < 5 && (frame_index >> (6 * (extra + 1) - extra)) != 0) {
+							++extra;
+						}
+						muafFLAC_WriteBits(w, ((0xFF00 >> (extra + 1)) & 0xFF) | (frame_index >> (6 * extra)), 8);
+						for (uint8_m i = extra; i-- > 0;) {
+							muafFLAC_WriteBits(w, 0x80 | ((frame_index >> (6 * i)) & 0x3F), 8);
+						}
 					}
-				}
 
-				// Reads PCM data from a WAVE file
-				MUDEF muafResult mu_read_WAVE_PCM(const char* filename, muWAVEProfile* profile, uint32_m beg_frame, uint32_m frame_len, void* data) {
-					// Open file
-					muafInner_File file;
-					if (muafInner_LoadFile(filename, &file) != 0) {
-						return MUAF_FAILED_OPEN_FILE;
+					// Uncommon block size
+					if (block_size_bits == 6) {
+						muafFLAC_WriteBits(w, n - 1, 8);
+					} else if (block_size_bits == 7) {
+						muafFLAC_WriteBits(w, n - 1, 16);
 					}
 
-					// Perform reading
-					muafResult res = muafWAVE_ReadPCM(
-						&file, profile,
-						mu_get_WAVE_audio_format(profile),
-						beg_frame, frame_len, (muByte*)data
-					);
+					// Header CRC
+					muafFLAC_FlushBits(w);
+					muafFLAC_WriteBits(w, muafFLAC_CRC8(w->buf, w->len), 8);
+
+					// Subframes
+					int64_m* l = e->samples;
+					int64_m* r = e->samples + e->block_size;
+					switch (channel_bits) {
+						default: {
+							for (uint16_m ch = 0; ch < e->channels; ++ch) {
+								muafFLAC_WriteSubframe(e, e->samples + (((size_m)ch) * e->block_size), n, e->bps, &e->plans[ch]);
+							}
+						} break;
+						case 8: {
+							muafFLAC_WriteSubframe(e, l, n, e->bps, &e->plans[0]);
+							muafFLAC_WriteSubframe(e, e->side, n, e->bps + 1, &e->plans[3]);
+						} break;
+						case 9: {
+							muafFLAC_WriteSubframe(e, e->side, n, e->bps + 1, &e->plans[3]);
+							muafFLAC_WriteSubframe(e, r, n, e->bps, &e->plans[1]);
+						} break;
+						case 10: {
+							muafFLAC_WriteSubframe(e, e->mid, n, e->bps, &e->plans[2]);
+							muafFLAC_WriteSubframe(e, e->side, n, e->bps + 1, &e->plans[3]);
+						} break;
+					}
 
-					// Close file and return
-					muafInner_DeloadFile(&file);
-					return res;
+					// Footer CRC
+					muafFLAC_FlushBits(w);
+					muafFLAC_WriteBits(w, muafFLAC_CRC16(e->crc16, w->buf, w->len), 16);
+					muafFLAC_FlushBits(w);
 				}
 
-			/* General reading */
+		/* Readers */
+
+			// Gets audio format FLAC audio data is decoded into
+			MUDEF muafAudioFormat mu_get_FLAC_audio_format(muFLACProfile* profile) {
+				// Pick format big enough for samples
+				switch ((profile->bits_per_sample + 7) / 8) {
+					default: return MUAF_FORMAT_UNKNOWN; break;
+					case 1: return MUAF_FORMAT_PCM_S8;  break;
+					case 2: return MUAF_FORMAT_PCM_S16; break;
+					case 3: return MUAF_FORMAT_PCM_S24; break;
+					case 4: return MUAF_FORMAT_PCM_S32; break;
+				}
+			}
 
-				// Gets audio format of WAVE file
-				MUDEF muafAudioFormat mu_get_WAVE_audio_format(muWAVEProfile* profile) {
-					// Perform based on format tag
-					switch (profile->format_tag) {
-						// Unknown
-						default: return MUAF_FORMAT_UNKNOWN; break;
+			// Struct representing a FLAC reader
+			struct muFLACReader {
+				// Source file
+				muafInner_File file;
+				// Copied profile (without its metadata blocks)
+				muFLACProfile profile;
+				// Decoder (referencing the copied profile)
+				muafFLAC_Decoder d;
+				// Format decoded into, and how much samples are shifted up
+				muafAudioFormat format;
+				size_m sample_size;
+				int64_m scale;
+				// Frames in the decoded block, and how many have been read
+				uint32_m block_len;
+				uint32_m block_pos;
+				// Frames decoded so far
+				uint64_m frames;
+			};
 
-						// PCM
-						case MU_WAVE_FORMAT_PCM: {
-							// Perform based on bits per sample
-							switch (profile->specific_fields.wave_pcm->bits_per_sample) {
-								default: return MUAF_FORMAT_UNKNOWN; break;
-								case 8:  return MUAF_FORMAT_PCM_U8;  break;
-								case 16: return MUAF_FORMAT_PCM_S16; break;
-								case 24: return MUAF_FORMAT_PCM_S24; break;
-								case 32: return MUAF_FORMAT_PCM_S32; break;
-								case 64: return MUAF_FORMAT_PCM_S64; break;
-							}
-						} break;
-					}
+			// Opens a FLAC reader
+			MUDEF muafResult mu_open_FLAC_reader(const char* filename, muFLACProfile* profile, muFLACReader** reader) {
+				// Make sure format is supported
+				muafAudioFormat format = mu_get_FLAC_audio_format(profile);
+				if (format == MUAF_FORMAT_UNKNOWN) {
+					return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
 				}
 
-		/* Writing */
+				// Allocate reader
+				muFLACReader* r = (muFLACReader*)mu_malloc(sizeof(muFLACReader));
+				if (!r) {
+					return MUAF_FAILED_MALLOC;
+				}
 
-			/* Wrapper */
+				// Copy profile
+				// (Metadata blocks are only needed to find the audio data)
+				size_m audio_index = muafFLAC_AudioIndex(profile);
+				r->profile = *profile;
+				r->profile.num_metadata_blocks = 0;
+				r->profile.metadata_blocks = 0;
 
-				/* PCM fmt writing */
+				// Open file
+				if (muafInner_LoadFile(filename, &r->file) != 0) {
+					mu_free(r);
+					return MUAF_FAILED_OPEN_FILE;
+				}
 
-					// MUAF_FORMAT_PCM_U8
-					muafResult muafWAVE_FmtPCMU8(muafInner_File* file, muWAVEWrapper* wrapper) {
-						// Fill out info
-						muByte fmt[16];
+				// Initialize decoder
+				r->d.profile = &r->profile;
+				muafResult res = muafFLAC_InitBitReader(&r->d.r, &r->file, audio_index);
+				if (muaf_result_is_fatal(res)) {
+					muafInner_DeloadFile(&r->file);
+					mu_free(r);
+					return res;
+				}
+				r->d.samples = (int64_m*)mu_malloc(sizeof(int64_m) * ((size_m)profile->max_block_size) * profile->num_channels);
+				if (!r->d.samples) {
+					muafFLAC_FreeBitReader(&r->d.r);
+					muafInner_DeloadFile(&r->file);
+					mu_free(r);
+					return MUAF_FAILED_MALLOC;
+				}
+				muafFLAC_CRC16Table(r->d.crc16);
 
-						// - wFormatTag
-						MU_WLEU16(fmt, MU_WAVE_FORMAT_PCM);
-						// - wChannels
-						MU_WLEU16(fmt+2, wrapper->num_channels);
-						// - dwSamplesPerSec
-						MU_WLEU32(fmt+4, wrapper->sample_rate);
-						// - dwAvgBytesPerSec
-						uint64_m avg_bytes = ((uint64_m)wrapper->num_channels) * ((uint64_m)wrapper->sample_rate) * 1;
-						if (avg_bytes > 0xFFFFFFFF) {
-							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
-						}
-						MU_WLEU32(fmt+8, avg_bytes);
-						// - wBlockAlign
-						MU_WLEU16(fmt+12, wrapper->num_channels);
+				// Fill in the rest
+				r->format = format;
+				r->sample_size = muaf_audio_format_sample_size(format);
+				r->scale = ((int64_m)1) << ((((profile->bits_per_sample + 7) / 8) * 8) - profile->bits_per_sample);
+				r->block_len = 0;
+				r->block_pos = 0;
+				r->frames = 0;
 
-						// - wBitsPerSample
-						MU_WLEU16(fmt+14, 8);
+				*reader = r;
+				return MUAF_SUCCESS;
+			}
 
-						// Write to file
-						muafInner_WriteToFile(file, wrapper->chunks.fmt, 16, fmt);
-						return MUAF_SUCCESS;
-					}
+			// Closes a FLAC reader
+			MUDEF void mu_close_FLAC_reader(muFLACReader* reader) {
+				mu_free(reader->d.samples);
+				muafFLAC_FreeBitReader(&reader->d.r);
+				muafInner_DeloadFile(&reader->file);
+				mu_free(reader);
+			}
 
-					// MUAF_FORMAT_PCM_S16
-					muafResult muafWAVE_FmtPCMS16(muafInner_File* file, muWAVEWrapper* wrapper) {
-						// Fill out info
-						muByte fmt[16];
+			// Interleaves frames of the decoded block in a type
+			#define MUAF_FLAC_INTERLEAVE(type) { \
+				type* out = (type*)data; \
+				for (uint8_m ch = 0; ch < channels; ++ch) { \
+					int64_m* in = samples + (((size_m)ch) * stride); \
+					for (uint32_m f = 0; f < count; ++f) { \
+						out[(((size_m)f) * channels) + ch] = (type)(in[f] * scale); \
+					} \
+				} \
+			}
 
-						// - wFormatTag
-						MU_WLEU16(fmt, MU_WAVE_FORMAT_PCM);
-						// - wChannels
-						MU_WLEU16(fmt+2, wrapper->num_channels);
-						// - dwSamplesPerSec
-						MU_WLEU32(fmt+4, wrapper->sample_rate);
-						// - dwAvgBytesPerSec
-						uint64_m avg_bytes = ((uint64_m)wrapper->num_channels) * ((uint64_m)wrapper->sample_rate) * 2;
-						if (avg_bytes > 0xFFFFFFFF) {
-							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+			// Interleaves the next frames of the decoded block into data
+			void muafFLAC_InterleaveFrames(muFLACReader* reader, uint32_m count, muByte* data) {
+				int64_m* samples = reader->d.samples + reader->block_pos;
+				size_m stride = reader->profile.max_block_size;
+				uint8_m channels = reader->profile.num_channels;
+				int64_m scale = reader->scale;
+
+				// Perform based on format
+				// (Outside of the loops, so each loop only stores one type)
+				switch (reader->format) {
+					default: break;
+					case MUAF_FORMAT_PCM_S8:  MUAF_FLAC_INTERLEAVE(int8_m) break;
+					case MUAF_FORMAT_PCM_S16: MUAF_FLAC_INTERLEAVE(int16_m) break;
+					case MUAF_FORMAT_PCM_S24: case MUAF_FORMAT_PCM_S32: MUAF_FLAC_INTERLEAVE(int32_m) break;
+				}
+			}
+
+			// Reads the next frames from a FLAC reader
+			MUDEF muafResult mu_read_FLAC_reader(muFLACReader* reader, uint32_m frame_len, void* data, uint32_m* frames_read) {
+				muafResult res = MUAF_SUCCESS;
+				size_m frame_size = reader->sample_size * reader->profile.num_channels;
+				uint32_m read = 0;
+
+				while (read < frame_len) {
+					// Decode next block once the current one has been read
+					if (reader->block_pos == reader->block_len) {
+						if (reader->frames >= reader->profile.num_samples) {
+							break;
 						}
-						MU_WLEU32(fmt+8, avg_bytes);
-						// - wBlockAlign
-						uint32_m block_align = ((uint32_m)wrapper->num_channels) * 2;
-						if (block_align > 0xFFFFFFFF) {
-							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+						uint32_m n;
+						res = muafFLAC_DecodeFrame(&reader->d, &n);
+						if (muaf_result_is_fatal(res)) {
+							break;
 						}
-						MU_WLEU16(fmt+12, block_align);
-
-						// - wBitsPerSample
-						MU_WLEU16(fmt+14, 16);
+						if (n > reader->profile.num_samples - reader->frames) {
+							res = MUAF_INVALID_FLAC_FRAME;
+							break;
+						}
+						reader->block_len = n;
+						reader->block_pos = 0;
+						reader->frames += n;
+					}
 
-						// Write to file
-						muafInner_WriteToFile(file, wrapper->chunks.fmt, 16, fmt);
-						return MUAF_SUCCESS;
+					// Read as much of the block as fits
+					uint32_m count = reader->block_len - reader->block_pos;
+					if (count > frame_len - read) {
+						count = frame_len - read;
 					}
+					muafFLAC_InterleaveFrames(reader, count, ((muByte*)data) + (((size_m)read) * frame_size));
+					reader->block_pos += count;
+					read += count;
+				}
 
-					// MUAF_FORMAT_PCM_S24
-					muafResult muafWAVE_FmtPCMS24(muafInner_File* file, muWAVEWrapper* wrapper) {
-						// Fill out info
-						muByte fmt[16];
+				*frames_read = read;
+				return res;
+			}
 
-						// - wFormatTag
-						MU_WLEU16(fmt, MU_WAVE_FORMAT_PCM);
-						// - wChannels
-						MU_WLEU16(fmt+2, wrapper->num_channels);
-						// - dwSamplesPerSec
-						MU_WLEU32(fmt+4, wrapper->sample_rate);
-						// - dwAvgBytesPerSec
-						uint64_m avg_bytes = ((uint64_m)wrapper->num_channels) * ((uint64_m)wrapper->sample_rate) * 3;
-						if (avg_bytes > 0xFFFFFFFF) {
-							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
-						}
-						MU_WLEU32(fmt+8, avg_bytes);
-						// - wBlockAlign
-						uint32_m block_align = ((uint32_m)wrapper->num_channels) * 3;
-						if (block_align > 0xFFFFFFFF) {
-							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
-						}
-						MU_WLEU16(fmt+12, block_align);
+	/* Audio file format and audio formats */
 
-						// - wBitsPerSample
-						MU_WLEU16(fmt+14, 24);
+		// Retrieves audio file format from file
+		MUDEF muafFileFormat mu_audio_file_format(const char* filename) {
+			// Open file, reading enough bytes to identify any format at once
+			muafInner_File file;
+			muByte prefix[42];
+			if (muafInner_LoadFilePrefix(filename, &file, prefix, sizeof(prefix)) != 0) {
+				return MUAF_UNKNOWN;
+			}
 
-						// Write to file
-						muafInner_WriteToFile(file, wrapper->chunks.fmt, 16, fmt);
-						return MUAF_SUCCESS;
-					}
+			// Try each format lol
+			muafFileFormat format = MUAF_UNKNOWN;
+			if (muafWAVE_IsWAVE(&file)) {
+				format = MUAF_WAVE;
+			}
+			else if (muafFLAC_IsFLAC(&file)) {
+				format = MUAF_FLAC;
+			}
 
-					// MUAF_FORMAT_PCM_S32
-					muafResult muafWAVE_FmtPCMS32(muafInner_File* file, muWAVEWrapper* wrapper) {
-						// Fill out info
-						muByte fmt[16];
+			// Close file and return format
+			muafInner_DeloadFile(&file);
+			return format;
+		}
 
-						// - wFormatTag
-						MU_WLEU16(fmt, MU_WAVE_FORMAT_PCM);
-						// - wChannels
-						MU_WLEU16(fmt+2, wrapper->num_channels);
-						// - dwSamplesPerSec
-						MU_WLEU32(fmt+4, wrapper->sample_rate);
-						// - dwAvgBytesPerSec
-						uint64_m avg_bytes = ((uint64_m)wrapper->num_channels) * ((uint64_m)wrapper->sample_rate) * 4;
-						if (avg_bytes > 0xFFFFFFFF) {
-							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
-						}
-						MU_WLEU32(fmt+8, avg_bytes);
-						// - wBlockAlign
-						uint32_m block_align = ((uint32_m)wrapper->num_channels) * 4;
-						if (block_align > 0xFFFFFFFF) {
-							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
-						}
-						MU_WLEU16(fmt+12, block_align);
+	/* Audio file profiles */
+
+		// Gets audio file profile
+		MUDEF muafResult mu_get_audio_file_profile(const char* filename, muAudioFileProfile* profile) {
+			return mu_get_audio_file_profile_with_allocator(filename, profile, 0);
+		}
+
+		// Gets audio file profile with allocator
+		MUDEF muafResult mu_get_audio_file_profile_with_allocator(const char* filename, muAudioFileProfile* profile, const muafAllocator* allocator) {
+			profile->format = MUAF_UNKNOWN;
+
+			// Open file and read header prefix
+			muafInner_File file;
+			muByte prefix[MUAF_HEADER_PREFIX_SIZE];
+			if (muafInner_LoadFilePrefix(filename, &file, prefix, sizeof(prefix)) != 0) {
+				return MUAF_FAILED_OPEN_FILE;
+			}
+
+			// Identify format and get profile on the same file
+			muafResult res = MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION;
+			if (muafWAVE_IsWAVE(&file)) {
+				profile->format = MUAF_WAVE;
+				res = muafWAVE_GetProfile(&file, &profile->specific.wave, allocator);
+			}
+			else if (muafFLAC_IsFLAC(&file)) {
+				profile->format = MUAF_FLAC;
+				res = muafFLAC_GetProfile(&file, &profile->specific.flac, allocator);
+			}
+
+			// Close file and return
+			muafInner_DeloadFile(&file);
+			return res;
+		}
+
+		// Frees audio file profile
+		MUDEF void mu_free_audio_file_profile(muAudioFileProfile* profile) {
+			mu_free_audio_file_profile_with_allocator(profile, 0);
+		}
+
+		// Frees audio file profile with allocator
+		MUDEF void mu_free_audio_file_profile_with_allocator(muAudioFileProfile* profile, const muafAllocator* allocator) {
+			switch (profile->format) {
+				default: break;
+				case MUAF_WAVE: mu_free_WAVE_profile_with_allocator(&profile->specific.wave, allocator); break;
+				case MUAF_FLAC: mu_free_FLAC_profile_with_allocator(&profile->specific.flac, allocator); break;
+			}
+		}
 
-						// - wBitsPerSample
-						MU_WLEU16(fmt+14, 32);
+		/* Profile batches */
 
-						// Write to file
-						muafInner_WriteToFile(file, wrapper->chunks.fmt, 16, fmt);
-						return MUAF_SUCCESS;
+			// Initializes profile batch
+			MUDEF void mu_init_profile_batch(muProfileBatch* batch, size_m file_count, const char** filenames) {
+				batch->file_count = file_count;
+				batch->filenames = filenames;
+				batch->next_file = 0;
+				batch->allocator = 0;
+			}
+
+			// Processes files in profile batch until every file has been claimed
+			MUDEF size_m mu_process_profile_batch(muProfileBatch* batch, muProfileBatchCallback callback, void* user) {
+				size_m processed = 0;
+				while (MU_TRUE) {
+					// Claim next file
+					size_m f = MUAF_ATOMIC_ADD(&batch->next_file, 1);
+					if (f >= batch->file_count) {
+						break;
 					}
 
-					// MUAF_FORMAT_PCM_S64
-					muafResult muafWAVE_FmtPCMS64(muafInner_File* file, muWAVEWrapper* wrapper) {
-						// Fill out info
-						muByte fmt[16];
+					// Get profile and hand it over
+					muAudioFileProfile profile;
+					muafResult res = mu_get_audio_file_profile_with_allocator(batch->filenames[f], &profile, batch->allocator);
+					callback(user, f, res, &profile);
+					++processed;
+				}
+				return processed;
+			}
 
-						// - wFormatTag
-						MU_WLEU16(fmt, MU_WAVE_FORMAT_PCM);
-						// - wChannels
-						MU_WLEU16(fmt+2, wrapper->num_channels);
-						// - dwSamplesPerSec
-						MU_WLEU32(fmt+4, wrapper->sample_rate);
-						// - dwAvgBytesPerSec
-						uint64_m avg_bytes = ((uint64_m)wrapper->num_channels) * ((uint64_m)wrapper->sample_rate) * 8;
-						if (avg_bytes > 0xFFFFFFFF) {
-							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
-						}
-						MU_WLEU32(fmt+8, avg_bytes);
-						// - wBlockAlign
-						uint32_m block_align = ((uint32_m)wrapper->num_channels) * 8;
-						if (block_align > 0xFFFFFFFF) {
-							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
-						}
-						MU_WLEU16(fmt+12, block_align);
+		/* Catalog scans */
+
+			// Gives up the rest of the thread's time slice
+			#ifndef MUAF_YIELD
+				#if defined(MU_LINUX)
+					#define MUAF_YIELD() mu_sched_yield()
+				#elif defined(MU_WIN32)
+					#include <windows.h>
+					#define MUAF_YIELD() SwitchToThread()
+				#else
+					#define MUAF_YIELD()
+				#endif
+			#endif
 
-						// - wBitsPerSample
-						MU_WLEU16(fmt+14, 64);
+			// Initial amount of items in a worker's queue
+			#define MUAF_CATALOG_QUEUE_SIZE 64
+
+			// Struct representing a directory or file waiting to be scanned
+			struct muafInner_CatalogItem {
+				// Path (allocated)
+				char* path;
+				// Directory or regular file
+				muBool directory;
+				// Size of file in bytes
+				uint64_m size;
+			};
+			typedef struct muafInner_CatalogItem muafInner_CatalogItem;
+
+			// Struct representing a worker's queue of items
+			// (The worker takes from the back, and other workers steal from the front)
+			struct muafInner_CatalogQueue {
+				// Ticket lock
+				size_m next_ticket;
+				size_m serving;
+				// Ring buffer of items
+				muafInner_CatalogItem* items;
+				size_m cap;
+				size_m beg;
+				size_m len;
+				// Arena that profiles are allocated from
+				muafArena* arena;
+				// (Keeps queues of different workers off of the same cache line)
+				muByte pad[64];
+			};
+			typedef struct muafInner_CatalogQueue muafInner_CatalogQueue;
+
+			// Struct representing a catalog scan
+			struct muCatalogScan {
+				size_m worker_count;
+				muafInner_CatalogQueue* queues;
+				// Items added and not yet finished
+				size_m pending;
+				muCatalogStats stats;
+			};
 
-						// Write to file
-						muafInner_WriteToFile(file, wrapper->chunks.fmt, 16, fmt);
-						return MUAF_SUCCESS;
+			// Locks a worker's queue
+			// (Yields while waiting, since the thread holding the lock may
+			// need this thread's core to finish if there are more threads than cores)
+			void muafInner_LockCatalogQueue(muafInner_CatalogQueue* queue) {
+				size_m ticket = MUAF_ATOMIC_ADD(&queue->next_ticket, 1);
+				while (MUAF_ATOMIC_LOAD(&queue->serving) != ticket) {
+					MUAF_YIELD();
+				}
+			}
+
+			// Unlocks a worker's queue
+			void muafInner_UnlockCatalogQueue(muafInner_CatalogQueue* queue) {
+				MUAF_ATOMIC_STORE(&queue->serving, queue->serving + 1);
+			}
+
+			// Adds an item to the back of a worker's queue
+			muafResult muafInner_PushCatalogItem(muCatalogScan* scan, size_m worker, muafInner_CatalogItem* item) {
+				muafInner_CatalogQueue* queue = &scan->queues[worker];
+				muafInner_LockCatalogQueue(queue);
+
+				// Grow queue if full
+				// (Copied in order, so the items start at the beginning)
+				if (queue->len == queue->cap) {
+					size_m cap = (queue->cap == 0) ? MUAF_CATALOG_QUEUE_SIZE : (queue->cap * 2);
+					muafInner_CatalogItem* items = (muafInner_CatalogItem*)mu_malloc(cap * sizeof(muafInner_CatalogItem));
+					if (!items) {
+						muafInner_UnlockCatalogQueue(queue);
+						return MUAF_FAILED_MALLOC;
+					}
+					for (size_m i = 0; i < queue->len; ++i) {
+						items[i] = queue->items[(queue->beg + i) % queue->cap];
 					}
+					if (queue->items) {
+						mu_free(queue->items);
+					}
+					queue->items = items;
+					queue->cap = cap;
+					queue->beg = 0;
+				}
 
-					// Writes fmt given PCM format to write it in
-					muafResult muafWAVE_FmtPCM(muafInner_File* file, muWAVEWrapper* wrapper) {
-						switch (wrapper->audio_format) {
-							default: return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT; break;
-							case MUAF_FORMAT_PCM_U8 : return muafWAVE_FmtPCMU8 (file, wrapper); break;
-							case MUAF_FORMAT_PCM_S16: return muafWAVE_FmtPCMS16(file, wrapper); break;
-							case MUAF_FORMAT_PCM_S24: return muafWAVE_FmtPCMS24(file, wrapper); break;
-							case MUAF_FORMAT_PCM_S32: return muafWAVE_FmtPCMS32(file, wrapper); break;
-							case MUAF_FORMAT_PCM_S64: return muafWAVE_FmtPCMS64(file, wrapper); break;
-						}
+				queue->items[(queue->beg + queue->len) % queue->cap] = *item;
+				MUAF_ATOMIC_ADD(&scan->pending, 1);
+				MUAF_ATOMIC_STORE(&queue->len, queue->len + 1);
+				muafInner_UnlockCatalogQueue(queue);
+				return MUAF_SUCCESS;
+			}
+
+			// Takes an item from the back of a worker's own queue, or the front of another's
+			// Returns if an item was taken
+			muBool muafInner_TakeCatalogItem(muCatalogScan* scan, size_m worker, muafInner_CatalogItem* item) {
+				// Own queue (most recently added)
+				muafInner_CatalogQueue* queue = &scan->queues[worker];
+				if (MUAF_ATOMIC_LOAD(&queue->len) != 0) {
+					muafInner_LockCatalogQueue(queue);
+					muBool taken = (queue->len != 0);
+					if (taken) {
+						*item = queue->items[(queue->beg + queue->len - 1) % queue->cap];
+						MUAF_ATOMIC_STORE(&queue->len, queue->len - 1);
+					}
+					muafInner_UnlockCatalogQueue(queue);
+					if (taken) {
+						return MU_TRUE;
 					}
+				}
 
-				/* General wrapper writing */
+				// Steal from other queues (least recently added)
+				// (Empty queues are skipped without locking them)
+				for (size_m i = 1; i < scan->worker_count; ++i) {
+					queue = &scan->queues[(worker + i) % scan->worker_count];
+					if (MUAF_ATOMIC_LOAD(&queue->len) == 0) {
+						continue;
+					}
+					muafInner_LockCatalogQueue(queue);
+					muBool taken = (queue->len != 0);
+					if (taken) {
+						*item = queue->items[queue->beg];
+						queue->beg = (queue->beg + 1) % queue->cap;
+						MUAF_ATOMIC_STORE(&queue->len, queue->len - 1);
+					}
+					muafInner_UnlockCatalogQueue(queue);
+					if (taken) {
+						MUAF_ATOMIC_ADD(&scan->stats.steals, 1);
+						return MU_TRUE;
+					}
+				}
+				return MU_FALSE;
+			}
 
-					// Fills out the information for the chunks of a WAVE wrapper
-					// Writes the ultimate file length
-					muafResult muafWAVE_FillChunks(muWAVEWrapper* wrapper, size_m* len) {
-						// Initialize all chunk data to 0
-						mu_memset(&wrapper->chunks, 0, sizeof(wrapper->chunks));
+			// Joins a directory path and an entry name
+			// Returns 0 if allocation failed
+			char* muafInner_JoinCatalogPath(const char* dir, const char* name) {
+				size_m dir_len = mu_strlen(dir);
+				size_m name_len = mu_strlen(name);
+				char* path = (char*)mu_malloc(dir_len + 1 + name_len + 1);
+				if (!path) {
+					return 0;
+				}
 
-						// Write fmt chunk after RIFF (4), ckSize (4), WAVE (4), ckID (4), and ckSize (4)
-						wrapper->chunks.fmt = 20;
-						// Set initial length to common-fields
-						wrapper->chunks.fmt_len = 14;
+				// (No separator is added if the directory already ends with one)
+				mu_memcpy(path, dir, dir_len);
+				#ifdef MU_WIN32
+					if (dir_len == 0 || (dir[dir_len-1] != '\\' && dir[dir_len-1] != '/')) {
+						path[dir_len++] = '\\';
+					}
+				#else
+					if (dir_len == 0 || dir[dir_len-1] != '/') {
+						path[dir_len++] = '/';
+					}
+				#endif
+				mu_memcpy(path + dir_len, name, name_len + 1);
+				return path;
+			}
 
-						// Add to fmt length based on format (and calculate sample size)
-						uint64_m sample_size = muaf_audio_format_sample_size(wrapper->audio_format);
-						// - PCM
-						if (MUAF_FORMAT_IS_PCM(wrapper->audio_format)) {
-							wrapper->chunks.fmt_len += 2;
+			// Reports an entry that failed before being profiled
+			void muafInner_ReportCatalogFailure(muCatalogScan* scan, size_m worker, const char* path, muafResult result, muCatalogScanCallback callback, void* user) {
+				muCatalogEntry entry;
+				mu_memset(&entry, 0, sizeof(entry));
+				entry.path = path;
+				entry.file_format = MUAF_UNKNOWN;
+				entry.audio_format = MUAF_FORMAT_UNKNOWN;
+				entry.result = result;
+				MUAF_ATOMIC_ADD(&scan->stats.failed, 1);
+				callback(user, worker, &entry);
+			}
+
+			// Adds a directory or file found in a directory to a worker's queue
+			// Returns the amount of entries reported for it (1 if it couldn't be added, 0 otherwise)
+			size_m muafInner_AddCatalogChild(muCatalogScan* scan, size_m worker, char* path, muBool directory, uint64_m size, muCatalogScanCallback callback, void* user) {
+				muafInner_CatalogItem item;
+				item.path = path;
+				item.directory = directory;
+				item.size = size;
+				muafResult res = muafInner_PushCatalogItem(scan, worker, &item);
+				if (muaf_result_is_fatal(res)) {
+					muafInner_ReportCatalogFailure(scan, worker, path, res, callback, user);
+					mu_free(path);
+					return 1;
+				}
+				return 0;
+			}
+
+			// Lists a directory, adding what's in it to a worker's queue
+			// Returns the amount of entries reported
+			size_m muafInner_ListCatalogDirectory(muCatalogScan* scan, size_m worker, muafInner_CatalogItem* item, muCatalogScanCallback callback, void* user) {
+				size_m reported = 0;
+
+				#if defined(MU_LINUX) && !defined(MUAF_NO_DIRECTORY_LISTING)
+					DIR* dir = mu_opendir(item->path);
+					if (!dir) {
+						muafInner_ReportCatalogFailure(scan, worker, item->path, MUAF_FAILED_OPEN_FILE, callback, user);
+						return 1;
+					}
+					MUAF_ATOMIC_ADD(&scan->stats.directories, 1);
+
+					struct dirent* ent;
+					while ((ent = mu_readdir(dir)) != 0) {
+						const char* name = ent->d_name;
+						if (name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0))) {
+							continue;
+						}
+						char* path = muafInner_JoinCatalogPath(item->path, name);
+						if (!path) {
+							muafInner_ReportCatalogFailure(scan, worker, name, MUAF_FAILED_MALLOC, callback, user);
+							++reported;
+							continue;
 						}
 
-						// Write WAVE chunk after fmt chunk, accounting for padding and WAVE's ckID and ckSize
-						wrapper->chunks.wave = wrapper->chunks.fmt + wrapper->chunks.fmt_len + 8;
-						if (wrapper->chunks.wave % 2 != 0) {
-							wrapper->chunks.wave += 1;
+						// Only keep directories and regular files
+						// (lstat doesn't follow symbolic links, so they're neither)
+						struct stat st;
+						if (mu_lstat(path, &st) != 0) {
+							muafInner_ReportCatalogFailure(scan, worker, path, MUAF_FAILED_OPEN_FILE, callback, user);
+							++reported;
+							mu_free(path);
+							continue;
 						}
-						// WAVE chunk length
-						wrapper->chunks.wave_len = wrapper->num_frames * sample_size * wrapper->num_channels;
+						if (!MU_S_ISDIR(st.st_mode) && !MU_S_ISREG(st.st_mode)) {
+							mu_free(path);
+							continue;
+						}
+						reported += muafInner_AddCatalogChild(scan, worker, path, MU_S_ISDIR(st.st_mode), (uint64_m)st.st_size, callback, user);
+					}
+					mu_closedir(dir);
+
+				#elif defined(MU_WIN32)
+					// Search for everything in the directory
+					char* pattern = muafInner_JoinCatalogPath(item->path, "*");
+					if (!pattern) {
+						muafInner_ReportCatalogFailure(scan, worker, item->path, MUAF_FAILED_MALLOC, callback, user);
+						return 1;
+					}
+					WIN32_FIND_DATAA data;
+					HANDLE find = FindFirstFileA(pattern, &data);
+					mu_free(pattern);
+					if (find == INVALID_HANDLE_VALUE) {
+						muafInner_ReportCatalogFailure(scan, worker, item->path, MUAF_FAILED_OPEN_FILE, callback, user);
+						return 1;
+					}
+					MUAF_ATOMIC_ADD(&scan->stats.directories, 1);
 
-						// Write length
-						*len = ((size_m)wrapper->chunks.wave) + ((size_m)wrapper->chunks.wave_len);
-						if (*len % 2 != 0) {
-							*len += 1;
+					do {
+						const char* name = data.cFileName;
+						if (name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0))) {
+							continue;
+						}
+						// (Reparse points are symbolic links and junctions)
+						if (data.dwFileAttributes & (FILE_ATTRIBUTE_REPARSE_POINT | FILE_ATTRIBUTE_DEVICE)) {
+							continue;
+						}
+						char* path = muafInner_JoinCatalogPath(item->path, name);
+						if (!path) {
+							muafInner_ReportCatalogFailure(scan, worker, name, MUAF_FAILED_MALLOC, callback, user);
+							++reported;
+							continue;
 						}
+						muBool directory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+						uint64_m size = (((uint64_m)data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+						reported += muafInner_AddCatalogChild(scan, worker, path, directory, size, callback, user);
+					} while (FindNextFileA(find, &data));
+					FindClose(find);
+
+				#else
+					// No way to list directories
+					muafInner_ReportCatalogFailure(scan, worker, item->path, MUAF_FAILED_OPEN_FILE, callback, user);
+					return 1;
+				#endif
+
+				return reported;
+			}
 
-						return MUAF_SUCCESS;
+			// Profiles a file and reports its entry
+			void muafInner_ProfileCatalogFile(muCatalogScan* scan, size_m worker, muafInner_CatalogItem* item, muCatalogScanCallback callback, void* user) {
+				muCatalogEntry entry;
+				mu_memset(&entry, 0, sizeof(entry));
+				entry.path = item->path;
+				entry.audio_format = MUAF_FORMAT_UNKNOWN;
+
+				// Get profile from the worker's arena
+				muafArena* arena = scan->queues[worker].arena;
+				muafAllocator allocator = mu_get_arena_allocator(arena);
+				muAudioFileProfile profile;
+				entry.result = mu_get_audio_file_profile_with_allocator(item->path, &profile, &allocator);
+				entry.file_format = profile.format;
+
+				// Copy what's needed out of it
+				if (!muaf_result_is_fatal(entry.result)) {
+					switch (profile.format) {
+						default: break;
+						case MUAF_WAVE: {
+							muWAVEProfile* wave = &profile.specific.wave;
+							entry.audio_format = mu_get_WAVE_audio_format(wave);
+							entry.channels = wave->channels;
+							entry.sample_rate = wave->samples_per_sec;
+							entry.frames = (wave->block_align != 0) ? (uint64_m)(wave->chunks.wave_len / wave->block_align) : 0;
+						} break;
+						case MUAF_FLAC: {
+							muFLACProfile* flac = &profile.specific.flac;
+							entry.audio_format = mu_get_FLAC_audio_format(flac);
+							entry.channels = flac->num_channels;
+							entry.sample_rate = flac->sample_rate;
+							entry.frames = flac->num_samples;
+						} break;
 					}
+				}
+				// (Frees the profile)
+				mu_reset_arena(arena);
 
-					// Writes RIFF and WAVE wrapper for file
-					muafResult muafWAVE_WriteRIFFWrapper(muafInner_File* file) {
-						// RIFF wrapper (+ WAVE)
-						muByte wrapper[12] = {
-							// RIFF
-							0x52, 0x49, 0x46, 0x46,
-							// ckSize (set in a second)
-							0x00, 0x00, 0x00, 0x00,
-							// WAVE
-							0x57, 0x41, 0x56, 0x45
-						};
+				MUAF_ATOMIC_ADD(&scan->stats.files, 1);
+				MUAF_ATOMIC_ADD64(&scan->stats.bytes, item->size);
+				if (muaf_result_is_fatal(entry.result)) {
+					MUAF_ATOMIC_ADD(&scan->stats.failed, 1);
+				}
+				else {
+					MUAF_ATOMIC_ADD(&scan->stats.audio_files, 1);
+				}
+				callback(user, worker, &entry);
+			}
 
-						// Make sure file size is within u32 range, excluding RIFF and ckSize
-						if ((file->len - 8) > 0xFFFFFFFF) {
-							return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
-						}
-						// Write ckSize
-						MU_WLEU32(wrapper+4, file->len - 8);
+			// Creates a catalog scan
+			MUDEF muafResult mu_create_catalog_scan(const char* root, size_m worker_count, muCatalogScan** scan) {
+				if (worker_count == 0) {
+					worker_count = 1;
+				}
 
-						// Write data to file
-						muafInner_WriteToFile(file, 0, sizeof(wrapper), wrapper);
+				// Allocate scan and queues
+				muCatalogScan* s = (muCatalogScan*)mu_malloc(sizeof(muCatalogScan));
+				if (!s) {
+					return MUAF_FAILED_MALLOC;
+				}
+				mu_memset(s, 0, sizeof(muCatalogScan));
+				s->queues = (muafInner_CatalogQueue*)mu_malloc(worker_count * sizeof(muafInner_CatalogQueue));
+				if (!s->queues) {
+					mu_free(s);
+					return MUAF_FAILED_MALLOC;
+				}
+				mu_memset(s->queues, 0, worker_count * sizeof(muafInner_CatalogQueue));
 
-						return MUAF_SUCCESS;
+				// Create each worker's arena
+				// (Worker count is raised as each one is created, so that
+				// destroying the scan only destroys the ones created)
+				for (size_m w = 0; w < worker_count; ++w) {
+					muafResult res = mu_create_arena(0, &s->queues[w].arena);
+					if (muaf_result_is_fatal(res)) {
+						mu_destroy_catalog_scan(s);
+						return res;
 					}
+					s->worker_count = w + 1;
+				}
 
-					// Writes a given chunk header
-					void muafWAVE_WriteChunkHeader(muafInner_File* file, uint32_m index, uint32_m ck_id, uint32_m ck_len) {
-						// Don't do anything if chunk doesn't exist
-						if (index == 0) {
-							return;
-						}
+				// Add root to the first worker's queue
+				muafInner_CatalogItem item;
+				size_m root_len = mu_strlen(root);
+				item.path = (char*)mu_malloc(root_len + 1);
+				if (!item.path) {
+					mu_destroy_catalog_scan(s);
+					return MUAF_FAILED_MALLOC;
+				}
+				mu_memcpy(item.path, root, root_len + 1);
+				item.directory = MU_TRUE;
+				item.size = 0;
+				muafResult res = muafInner_PushCatalogItem(s, 0, &item);
+				if (muaf_result_is_fatal(res)) {
+					mu_free(item.path);
+					mu_destroy_catalog_scan(s);
+					return res;
+				}
 
-						// Setup chunk header
-						muByte header[8];
-						MU_WBEU32(header, ck_id);
-						MU_WLEU32(header+4, ck_len);
+				*scan = s;
+				return MUAF_SUCCESS;
+			}
 
-						// Write chunk header to file
-						muafInner_WriteToFile(file, index-8, sizeof(header), header);
+			// Destroys a catalog scan
+			MUDEF void mu_destroy_catalog_scan(muCatalogScan* scan) {
+				for (size_m w = 0; w < scan->worker_count; ++w) {
+					muafInner_CatalogQueue* queue = &scan->queues[w];
+					// (Items are only left if the scan wasn't processed to the end)
+					for (size_m i = 0; i < queue->len; ++i) {
+						mu_free(queue->items[(queue->beg + i) % queue->cap].path);
 					}
-
-					// Writes empty, initial chunk headers
-					void muafWAVE_InitChunks(muafInner_File* file, muWAVEWrapper* wrapper) {
-						muafWAVE_WriteChunkHeader(file, wrapper->chunks.fmt,        0x666D7420, wrapper->chunks.fmt_len);
-						muafWAVE_WriteChunkHeader(file, wrapper->chunks.wave,       0x64617461, wrapper->chunks.wave_len);
-						muafWAVE_WriteChunkHeader(file, wrapper->chunks.fact,       0x66616374, wrapper->chunks.fact_len);
-						muafWAVE_WriteChunkHeader(file, wrapper->chunks.cue,        0x63756520, wrapper->chunks.cue_len);
-						muafWAVE_WriteChunkHeader(file, wrapper->chunks.playlist,   0x706C7374, wrapper->chunks.playlist_len);
-						muafWAVE_WriteChunkHeader(file, wrapper->chunks.assoc_data, 0x4C495354, wrapper->chunks.assoc_data_len);
+					if (queue->items) {
+						mu_free(queue->items);
 					}
+					mu_destroy_arena(queue->arena);
+				}
+				mu_free(scan->queues);
+				mu_free(scan);
+			}
 
-					// Writes fmt based on audio format
-					muafResult muafWAVE_FmtWrite(muafInner_File* file, muWAVEWrapper* wrapper) {
-						// PCM
-						if (MUAF_FORMAT_IS_PCM(wrapper->audio_format)) {
-							return muafWAVE_FmtPCM(file, wrapper);
-						}
-						else {
-							return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+			// Processes a catalog scan as one of its workers
+			MUDEF size_m mu_process_catalog_scan(muCatalogScan* scan, size_m worker, muCatalogScanCallback callback, void* user) {
+				size_m reported = 0;
+				while (MU_TRUE) {
+					// Take next item
+					// (If there's nothing to take, other workers may still add more,
+					// so only stop once nothing is pending anywhere)
+					muafInner_CatalogItem item;
+					if (!muafInner_TakeCatalogItem(scan, worker, &item)) {
+						if (MUAF_ATOMIC_LOAD(&scan->pending) == 0) {
+							break;
 						}
+						MUAF_YIELD();
+						continue;
 					}
 
-					// Creates WAVE file wrapper
-					MUDEF muafResult mu_create_WAVE_wrapper(const char* filename, muWAVEWrapper* wrapper) {
-						// Initialize chunk info
-						size_m len;
-						muafResult res = muafWAVE_FillChunks(wrapper, &len);
-						if (muaf_result_is_fatal(res)) {
-							return res;
-						}
+					// List it or profile it
+					if (item.directory) {
+						reported += muafInner_ListCatalogDirectory(scan, worker, &item, callback, user);
+					}
+					else {
+						muafInner_ProfileCatalogFile(scan, worker, &item, callback, user);
+						++reported;
+					}
+					mu_free(item.path);
 
-						// Create the file
-						muafInner_File file;
-						if (muafInner_CreateFile(filename, &file, len) != 0) {
-							return MUAF_FAILED_CREATE_FILE;
-						}
+					// (Only finished once everything it added has been added)
+					MUAF_ATOMIC_ADD(&scan->pending, (size_m)-1);
+				}
+				return reported;
+			}
+
+			// Gets catalog scan statistics
+			MUDEF void mu_get_catalog_scan_stats(muCatalogScan* scan, muCatalogStats* stats) {
+				stats->directories = MUAF_ATOMIC_LOAD(&scan->stats.directories);
+				stats->files = MUAF_ATOMIC_LOAD(&scan->stats.files);
+				stats->audio_files = MUAF_ATOMIC_LOAD(&scan->stats.audio_files);
+				stats->failed = MUAF_ATOMIC_LOAD(&scan->stats.failed);
+				stats->bytes = MUAF_ATOMIC_LOAD64(&scan->stats.bytes);
+				stats->steals = MUAF_ATOMIC_LOAD(&scan->stats.steals);
+			}
+
+		// Returns audio format supported for a given audio file format
+		MUDEF muBool muaf_audio_format_supported(muafFileFormat file_format, muafAudioFormat audio_format) {
+			// Perform based on file format
+			switch (file_format) {
+				default: return MU_FALSE; break;
+				case MUAF_WAVE: return muafWAVE_FormatSupport(audio_format); break;
+				case MUAF_FLAC: return muafFLAC_FormatSupport(audio_format);
+			}
+		}
+
+		// Returns audio format sample size
+		MUDEF size_m muaf_audio_format_sample_size(muafAudioFormat format) {
+			// Perform based on format
+			switch (format) {
+				// Unknown
+				default: return 0; break;
+
+				// PCM
+				case MUAF_FORMAT_PCM_U8:  case MUAF_FORMAT_PCM_S8:  return 1; break;
+				case MUAF_FORMAT_PCM_S16: return 2; break;
+				case MUAF_FORMAT_PCM_S24: case MUAF_FORMAT_PCM_S32: return 4; break;
+				case MUAF_FORMAT_PCM_S64: return 8; break;
+			}
+		}
+
+	/* Transcoding */
+
+		/* WAVE to FLAC */
+
+			// Transcodes WAVE to FLAC
+			MUDEF muafResult mu_transcode_WAVE_to_FLAC(const char* src_filename, muWAVEProfile* profile, const char* dst_filename, uint16_m block_size, muTranscodeStats* stats) {
+				// Make sure format is supported
+				muafAudioFormat format = mu_get_WAVE_audio_format(profile);
+				if ((format != MUAF_FORMAT_PCM_U8 && format != MUAF_FORMAT_PCM_S16 && format != MUAF_FORMAT_PCM_S24 && format != MUAF_FORMAT_PCM_S32)
+					|| profile->channels > 8 || profile->samples_per_sec > 0xFFFFF
+				) {
+					return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+				}
+
+				// Make sure block size is valid
+				if (block_size == 0) {
+					block_size = MUAF_FLAC_DEFAULT_BLOCK_SIZE;
+				}
+				if (block_size < 16) {
+					return MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_RANGE;
+				}
+
+				uint16_m channels = profile->channels;
+				uint8_m bps = muafWAVE_PCMBits(format);
+				uint32_m num_frames = profile->chunks.wave_len / profile->block_align;
+				size_m block_align = profile->block_align;
+
+				// Open source
+				muafInner_File src;
+				if (muafInner_LoadFile(src_filename, &src) != 0) {
+					return MUAF_FAILED_OPEN_FILE;
+				}
+
+				// Allocate encoder, and raw and decoded WAVE data for a block
+				muafFLAC_Encoder e;
+				muafResult res = muafFLAC_InitEncoder(&e, channels, bps, block_size);
+				if (muaf_result_is_fatal(res)) {
+					muafInner_DeloadFile(&src);
+					return res;
+				}
+				size_m raw_len = ((size_m)block_size) * block_align;
+				muByte* raw = (muByte*)mu_malloc(raw_len + (((size_m)block_size) * channels * muaf_audio_format_sample_size(format)));
+				if (!raw) {
+					muafFLAC_FreeEncoder(&e);
+					muafInner_DeloadFile(&src);
+					return MUAF_FAILED_MALLOC;
+				}
+				muByte* decoded = raw + raw_len;
+
+				// Create destination
+				FILE_M* dst = muafInner_FOpen(dst_filename, "wb");
+				if (!dst) {
+					mu_free(raw);
+					muafFLAC_FreeEncoder(&e);
+					muafInner_DeloadFile(&src);
+					return MUAF_FAILED_CREATE_FILE;
+				}
 
-						// Write RIFF and WAVE wrapper
-						res = muafWAVE_WriteRIFFWrapper(&file);
-						if (muaf_result_is_fatal(res)) {
-							muafInner_DeloadFile(&file);
-							return res;
-						}
+				// Write fLaC and streaminfo's header
+				// (Streaminfo itself is written once everything's been encoded)
+				muByte head[42];
+				mu_memset(head, 0, sizeof(head));
+				MU_WBEU32(head, 0x664C6143);
+				head[4] = 0x80;
+				MU_WBEU24(head+5, 34);
+				if (muafInner_FWrite(head, 1, sizeof(head), dst) != sizeof(head)) {
+					res = MUAF_FAILED_WRITE_FILE;
+				}
 
-						// Write empty chunks
-						muafWAVE_InitChunks(&file, wrapper);
+				// Encode each block
+				muafInner_MD5 md5;
+				muafInner_MD5Init(&md5);
+				uint32_m min_frame_size = 0xFFFFFF, max_frame_size = 0;
+				size_m written = 0;
+				uint32_m frame_index = 0;
+				for (uint32_m beg = 0; beg < num_frames && !muaf_result_is_fatal(res); beg += block_size, ++frame_index) {
+					uint32_m n = num_frames - beg;
+					if (n > block_size) {
+						n = block_size;
+					}
 
-						// Write fmt chunk
-						res = muafWAVE_FmtWrite(&file, wrapper);
-						if (muaf_result_is_fatal(res)) {
-							muafInner_DeloadFile(&file);
-							return res;
+					// Read and decode block
+					muafInner_LoadFromFile(&src, profile->chunks.wave + (((size_m)beg) * block_align), ((size_m)n) * block_align, raw);
+					muafWAVE_DecodePCM(format, raw, ((size_m)n) * channels, decoded);
+
+					// Add to MD5, which is of signed little-endian samples
+					// (Raw data already is this, besides 8-bit being unsigned)
+					if (format == MUAF_FORMAT_PCM_U8) {
+						for (size_m i = 0; i < ((size_m)n) * block_align; ++i) {
+							raw[i] ^= 0x80;
 						}
+					}
+					muafInner_MD5Update(&md5, raw, ((size_m)n) * block_align);
 
-						// Close file
-						muafInner_DeloadFile(&file);
-						return res;
+					// Deinterleave into encoder
+					for (uint16_m ch = 0; ch < channels; ++ch) {
+						int64_m* x = e.samples + (((size_m)ch) * block_size);
+						for (uint32_m f = 0; f < n; ++f) {
+							x[f] = muafWAVE_GetSample(format, decoded, (((size_m)f) * channels) + ch);
+						}
 					}
 
-					// Destroys WAVE file wrapper
-					MUDEF void mu_free_WAVE_wrapper(muWAVEWrapper* wrapper) {
-						// Does nothing currently (sorry lol :P)
-						return; if (wrapper) {}
+					// Encode and write frame
+					muafFLAC_EncodeFrame(&e, frame_index, n);
+					if (muafInner_FWrite(e.w.buf, 1, e.w.len, dst) != e.w.len) {
+						res = MUAF_FAILED_WRITE_FILE;
+					}
+					written += e.w.len;
+					if (e.w.len < min_frame_size) {
+						min_frame_size = (uint32_m)e.w.len;
 					}
+					if (e.w.len > max_frame_size) {
+						max_frame_size = (uint32_m)e.w.len;
+					}
+				}
 
-				/* Retrieving WAVE wrapper */
+				// Write streaminfo
+				if (!muaf_result_is_fatal(res)) {
+					muByte info[34];
+					MU_WBEU16(info, block_size);
+					MU_WBEU16(info+2, block_size);
+					MU_WBEU24(info+4, (max_frame_size == 0) ? 0 : min_frame_size);
+					MU_WBEU24(info+7, max_frame_size);
+					// (Sample rate of 0 indicates no audio)
+					uint64_m sample_rate = (num_frames == 0) ? 0 : profile->samples_per_sec;
+					MU_WBEU64(info+10,
+						(sample_rate << 44) | (((uint64_m)(channels - 1)) << 41) | (((uint64_m)(bps - 1)) << 36) | ((uint64_m)num_frames)
+					);
+					muafInner_MD5Final(&md5, info+18);
 
-					// Creates WAVE wrapper based on other WAVE file
-					MUDEF muafResult mu_get_WAVE_wrapper_from_WAVE(muWAVEProfile* profile, muWAVEWrapper* wrapper) {
-						// Get audio format
-						wrapper->audio_format = mu_get_WAVE_audio_format(profile);
-						// Calculate frame count
-						wrapper->num_frames = profile->chunks.wave_len / profile->block_align;
-						// Number of channels
-						wrapper->num_channels = profile->channels;
-						// Sample rate
-						wrapper->sample_rate = profile->samples_per_sec;
-						return MUAF_SUCCESS;
+					muafInner_FSeek(dst, 8, MU_SEEK_SET);
+					if (muafInner_FWrite(info, 1, sizeof(info), dst) != sizeof(info)) {
+						res = MUAF_FAILED_WRITE_FILE;
 					}
+				}
 
-			/* Writing audio data */
+				// Fill in stats
+				if (stats) {
+					stats->frames = num_frames;
+					stats->blocks = frame_index;
+					stats->read_bytes = ((size_m)num_frames) * block_align;
+					stats->written_bytes = written;
+				}
 
-				/* PCM audio writing */
+				mu_fclose(dst);
+				mu_free(raw);
+				muafFLAC_FreeEncoder(&e);
+				muafInner_DeloadFile(&src);
+				return res;
+			}
 
-					// MUAF_FORMAT_PCM_U8
-					void muafWAVE_WritePCMU8(muafInner_File* file, muWAVEWrapper* wrapper, uint32_m beg_frame, uint32_m frame_len, uint8_m* data) {
-						// Write data over
-						muafInner_WriteToFile(file, wrapper->chunks.wave + (beg_frame * wrapper->num_channels), frame_len * wrapper->num_channels, data);
-					}
+		/* FLAC to WAVE */
 
-					// MUAF_FORMAT_PCM_S16
-					void muafWAVE_WritePCMS16(muafInner_File* file, muWAVEWrapper* wrapper, uint32_m beg_frame, uint32_m frame_len, int16_m* data) {
-						// Convert each sample
-						uint32_m sample_count = frame_len * wrapper->num_channels;
-						for (uint32_m s = 0; s < sample_count; ++s) {
-							muByte sample_data[2];
-							MU_WLES16(sample_data, data[s]);
-							mu_memcpy(&data[s], sample_data, 2);
-						}
+			// Transcodes FLAC to WAVE
+			MUDEF muafResult mu_transcode_FLAC_to_WAVE(const char* src_filename, muFLACProfile* profile, const char* dst_filename, muTranscodeStats* stats) {
+				// Make sure WAVE can hold it
+				if (profile->num_samples > 0xFFFFFFFF) {
+					return MUAF_INVALID_WAVE_FILE_WRITE_SIZE;
+				}
 
-						// Write data over
-						muafInner_WriteToFile(file, wrapper->chunks.wave + (beg_frame * 2 * wrapper->num_channels), frame_len * 2 * wrapper->num_channels, (muByte*)data);
-					}
+				// Pick WAVE format big enough for samples
+				uint8_m bps = profile->bits_per_sample;
+				uint8_m sample_size = (bps + 7) / 8;
+				muWAVEWrapper wrapper;
+				switch (sample_size) {
+					default: return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT; break;
+					case 1: wrapper.audio_format = MUAF_FORMAT_PCM_U8; break;
+					case 2: wrapper.audio_format = MUAF_FORMAT_PCM_S16; break;
+					case 3: wrapper.audio_format = MUAF_FORMAT_PCM_S24; break;
+					case 4: wrapper.audio_format = MUAF_FORMAT_PCM_S32; break;
+				}
+				// (Samples are shifted up to fill WAVE samples)
+				int64_m scale = ((int64_m)1) << ((sample_size * 8) - bps);
+				wrapper.num_frames = (uint32_m)profile->num_samples;
+				wrapper.num_channels = profile->num_channels;
+				wrapper.sample_rate = profile->sample_rate;
+
+				// Create destination
+				muafResult res = mu_create_WAVE_wrapper(dst_filename, &wrapper);
+				if (muaf_result_is_fatal(res)) {
+					return res;
+				}
+				muafAudioFormat format = wrapper.audio_format;
+				size_m wave = wrapper.chunks.wave;
+				mu_free_WAVE_wrapper(&wrapper);
+				muafInner_File dst;
+				if (muafInner_CreateFile(dst_filename, &dst, 0) != 0) {
+					return MUAF_FAILED_OPEN_FILE;
+				}
 
-					// MUAF_FORMAT_PCM_S24
-					void muafWAVE_WritePCMS24(muafInner_File* file, muWAVEWrapper* wrapper, uint32_m beg_frame, uint32_m frame_len, int32_m* data) {
-						// Convert each sample
-						uint32_m sample_count = frame_len * wrapper->num_channels;
-						for (uint32_m s = 0; s < sample_count; ++s) {
-							muByte sample_data[3];
-							MU_WLES24(sample_data, data[s]);
-							mu_memcpy(((muByte*)data) + (s*3), sample_data, 3);
-						}
+				// Open source
+				muafInner_File src;
+				if (muafInner_LoadFile(src_filename, &src) != 0) {
+					muafInner_DeloadFile(&dst);
+					return MUAF_FAILED_OPEN_FILE;
+				}
 
-						// Write data over
-						muafInner_WriteToFile(file, wrapper->chunks.wave + (beg_frame * 3 * wrapper->num_channels), frame_len * 3 * wrapper->num_channels, (muByte*)data);
+				// Allocate decoder, and WAVE and MD5 data for a block
+				muafFLAC_Decoder d;
+				d.profile = profile;
+				size_m audio_index = muafFLAC_AudioIndex(profile);
+				res = muafFLAC_InitBitReader(&d.r, &src, audio_index);
+				if (muaf_result_is_fatal(res)) {
+					muafInner_DeloadFile(&src);
+					muafInner_DeloadFile(&dst);
+					return res;
+				}
+				size_m block_samples = ((size_m)profile->max_block_size) * profile->num_channels;
+				d.samples = (int64_m*)mu_malloc((sizeof(int64_m) * block_samples) + (block_samples * sample_size * 2));
+				if (!d.samples) {
+					muafFLAC_FreeBitReader(&d.r);
+					muafInner_DeloadFile(&src);
+					muafInner_DeloadFile(&dst);
+					return MUAF_FAILED_MALLOC;
+				}
+				muByte* out = (muByte*)(d.samples + block_samples);
+				muByte* md5_data = out + (block_samples * sample_size);
+				muafFLAC_CRC16Table(d.crc16);
+
+				// Decode each frame
+				muafInner_MD5 md5;
+				muafInner_MD5Init(&md5);
+				size_m block_align = ((size_m)profile->num_channels) * sample_size;
+				uint64_m frames = 0;
+				size_m blocks = 0;
+				while (frames < profile->num_samples) {
+					uint32_m n;
+					res = muafFLAC_DecodeFrame(&d, &n);
+					if (muaf_result_is_fatal(res)) {
+						break;
+					}
+					if (n > profile->num_samples - frames) {
+						res = MUAF_INVALID_FLAC_FRAME;
+						break;
 					}
 
-					// MUAF_FORMAT_PCM_S32
-					void muafWAVE_WritePCMS32(muafInner_File* file, muWAVEWrapper* wrapper, uint32_m beg_frame, uint32_m frame_len, int32_m* data) {
-						// Convert each sample
-						uint32_m sample_count = frame_len * wrapper->num_channels;
-						for (uint32_m s = 0; s < sample_count; ++s) {
-							muByte sample_data[4];
-							MU_WLES16(sample_data, data[s]);
-							mu_memcpy(&data[s], sample_data, 4);
+					// Interleave into WAVE data, and signed little-endian data for MD5
+					for (uint32_m f = 0; f < n; ++f) {
+						for (uint8_m ch = 0; ch < profile->num_channels; ++ch) {
+							int64_m sample = d.samples[(((size_m)ch) * profile->max_block_size) + f];
+							size_m i = ((((size_m)f) * profile->num_channels) + ch) * sample_size;
+							muafWAVE_EncodeSample(format, out + i, sample * scale);
+							for (uint8_m b = 0; b < sample_size; ++b) {
+								md5_data[i + b] = (muByte)(((uint64_m)sample) >> (b * 8));
+							}
 						}
-
-						// Write data over
-						muafInner_WriteToFile(file, wrapper->chunks.wave + (beg_frame * 4 * wrapper->num_channels), frame_len * 4 * wrapper->num_channels, (muByte*)data);
+					}
+					muafInner_MD5Update(&md5, md5_data, ((size_m)n) * block_align);
+					res = muafInner_WriteToFile(&dst, wave + (((size_m)frames) * block_align), ((size_m)n) * block_align, out);
+					if (muaf_result_is_fatal(res)) {
+						break;
 					}
 
-					// MUAF_FORMAT_PCM_S64
-					void muafWAVE_WritePCMS64(muafInner_File* file, muWAVEWrapper* wrapper, uint32_m beg_frame, uint32_m frame_len, int64_m* data) {
-						// Convert each sample
-						uint32_m sample_count = frame_len * wrapper->num_channels;
-						for (uint32_m s = 0; s < sample_count; ++s) {
-							muByte sample_data[8];
-							MU_WLES16(sample_data, data[s]);
-							mu_memcpy(&data[s], sample_data, 8);
-						}
+					frames += n;
+					++blocks;
+				}
 
-						// Write data over
-						muafInner_WriteToFile(file, wrapper->chunks.wave + (beg_frame * 8 * wrapper->num_channels), frame_len * 8 * wrapper->num_channels, (muByte*)data);
+				// Check MD5 (if it was calculated)
+				if (!muaf_result_is_fatal(res) && (profile->high_checksum != 0 || profile->low_checksum != 0)) {
+					muByte digest[16];
+					muafInner_MD5Final(&md5, digest);
+					if (MU_RBEU64(digest) != profile->high_checksum || MU_RBEU64(digest+8) != profile->low_checksum) {
+						res = MUAF_INVALID_FLAC_CHECKSUM;
 					}
+				}
 
-					// Writes WAVE PCM audio data
-					MUDEF muafResult mu_write_WAVE_PCM(const char* filename, muWAVEWrapper* wrapper, uint32_m beg_frame, uint32_m frame_len, void* data) {
-						// Open file
-						muafInner_File file;
-						if (muafInner_CreateFile(filename, &file, 0) != 0) {
-							return MUAF_FAILED_OPEN_FILE;
-						}
+				// Fill in stats
+				if (stats) {
+					stats->frames = frames;
+					stats->blocks = blocks;
+					stats->read_bytes = (d.r.file_index - d.r.len + (d.r.bit / 8)) - audio_index;
+					stats->written_bytes = ((size_m)frames) * block_align;
+				}
 
-						// Perform writing based on format
-						muafResult res = MUAF_SUCCESS;
-						switch (wrapper->audio_format) {
-							default: res = MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT; break;
-							case MUAF_FORMAT_PCM_U8:  muafWAVE_WritePCMU8 (&file, wrapper, beg_frame, frame_len, (uint8_m*)data); break;
-							case MUAF_FORMAT_PCM_S16: muafWAVE_WritePCMS16(&file, wrapper, beg_frame, frame_len, (int16_m*)data); break;
-							case MUAF_FORMAT_PCM_S24: muafWAVE_WritePCMS24(&file, wrapper, beg_frame, frame_len, (int32_m*)data); break;
-							case MUAF_FORMAT_PCM_S32: muafWAVE_WritePCMS32(&file, wrapper, beg_frame, frame_len, (int32_m*)data); break;
-							case MUAF_FORMAT_PCM_S64: muafWAVE_WritePCMS64(&file, wrapper, beg_frame, frame_len, (int64_m*)data); break;
-						}
+				mu_free(d.samples);
+				muafFLAC_FreeBitReader(&d.r);
+				muafInner_DeloadFile(&src);
+				muafInner_DeloadFile(&dst);
+				return res;
+			}
 
-						// Close file and return
-						muafInner_DeloadFile(&file);
-						return res;
-					}
+	/* Peak overviews */
 
-	/* FLAC */
+		// Header size of a sidecar file
+		#define MUAF_PEAKS_HEADER_SIZE 20
+		// Size of one channel's peaks within a bin
+		#define MUAF_PEAKS_PEAK_SIZE 6
 
-		/* Enum/Misc. functions */
+		// Peaks of one channel for a bin being accumulated
+		struct muafInner_PeakAcc {
+			double min;
+			double max;
+			double sum_sq;
+		};
+		typedef struct muafInner_PeakAcc muafInner_PeakAcc;
 
-			// Returns whether or not given file is FLAC
-			muBool muafFLAC_IsFLAC(muafInner_File* file) {
-				// Minimum length check
-				// Includes fLaC (4) and entire streaminfo metadata block (4 byte header + 34 descriptive bytes)
-				if (file->len < 42) {
-					return MU_FALSE;
+		// Resets peak accumulator
+		void muafInner_ResetPeakAcc(muafInner_PeakAcc* acc) {
+			acc->min = 1.0;
+			acc->max = -1.0;
+			acc->sum_sq = 0.0;
+		}
+
+		// Accumulates a run of samples of one channel
+		// (Kept to a plain loop over contiguous samples so that it can be vectorized)
+		void muafInner_AccumulatePeaks(muafInner_PeakAcc* acc, const float* samples, size_m len) {
+			float mn = (float)acc->min;
+			float mx = (float)acc->max;
+			double sum_sq = 0.0;
+			for (size_m s = 0; s < len; ++s) {
+				float v = samples[s];
+				mn = (v < mn) ? v : mn;
+				mx = (v > mx) ? v : mx;
+				sum_sq += (double)(v * v);
+			}
+			acc->min = mn;
+			acc->max = mx;
+			acc->sum_sq += sum_sq;
+		}
+
+		// Encodes a value from -1 to 1 as a signed 16-bit peak
+		int16_m muafInner_EncodePeak(double v) {
+			double s = v * 32768.0;
+			if (s >= 32767.0) {
+				return 32767;
+			}
+			if (s <= -32768.0) {
+				return -32768;
+			}
+			return (int16_m)((s < 0.0) ? (s - 0.5) : (s + 0.5));
+		}
+
+		// Writes the peaks of a finished bin
+		void muafInner_WritePeakBin(muByte* bin, muafInner_PeakAcc* accs, uint16_m channels, uint32_m frames) {
+			for (uint16_m ch = 0; ch < channels; ++ch) {
+				double rms = mu_sqrt(accs[ch].sum_sq / (double)frames) * 65535.0;
+				MU_WLES16(bin, muafInner_EncodePeak(accs[ch].min));
+				MU_WLES16(bin+2, muafInner_EncodePeak(accs[ch].max));
+				MU_WLEU16(bin+4, (rms >= 65535.0) ? 65535 : (uint16_m)(rms + 0.5));
+				bin += MUAF_PEAKS_PEAK_SIZE;
+			}
+		}
+
+		// Buffers used while generating a peak overview
+		struct muafInner_PeaksGen {
+			// Accumulators (channels for each level)
+			muafInner_PeakAcc* accs;
+			// Frames accumulated in the current bin of each level
+			uint32_m* filled;
+			// Where the next bin of each level is written
+			muByte** bins;
+			// Decoded block
+			muByte* block;
+			size_m block_frames;
+			// Block as floats for each channel
+			float* samples;
+		};
+		typedef struct muafInner_PeaksGen muafInner_PeaksGen;
+
+		// Fills the bins of every level of a sidecar from a WAVE reader
+		muafResult muafWAVE_GeneratePeaks(muWAVEReader* reader, uint16_m level_count, const uint32_m* bin_sizes, muafInner_PeaksGen* g) {
+			uint16_m channels = reader->channels;
+			size_m bin_len = ((size_m)channels) * MUAF_PEAKS_PEAK_SIZE;
+			double scale = 1.0 / (double)(((uint64_m)1) << (muafWAVE_PCMBits(reader->format) - 1));
+
+			// Go through each block
+			for (uint32_m beg = 0; beg < reader->num_frames; ) {
+				uint32_m frames = ((reader->num_frames - beg) < g->block_frames) ? (reader->num_frames - beg) : (uint32_m)g->block_frames;
+				muafResult res = mu_read_WAVE_reader(reader, beg, frames, g->block);
+				if (muaf_result_is_fatal(res)) {
+					return res;
 				}
 
-				// Load first 5 bytes
-				muByte data[5];
-				muafInner_LoadFromFile(file, 0, 5, data);
+				// Split into floats for each channel
+				for (uint16_m ch = 0; ch < channels; ++ch) {
+					float* ch_samples = g->samples + (((size_m)ch) * frames);
+					for (uint32_m f = 0; f < frames; ++f) {
+						ch_samples[f] = (float)(((double)muafWAVE_GetSample(reader->format, g->block, (((size_m)f) * channels) + ch)) * scale);
+					}
+				}
 
-				// Check for fLaC
-				if (MU_RBEU32(data) != 0x664C6143) {
-					return MU_FALSE;
+				// Accumulate into bins of the first level
+				for (uint32_m f = 0; f < frames; ) {
+					uint32_m run = bin_sizes[0] - g->filled[0];
+					if (run > frames - f) {
+						run = frames - f;
+					}
+					for (uint16_m ch = 0; ch < channels; ++ch) {
+						muafInner_AccumulatePeaks(&g->accs[ch], g->samples + (((size_m)ch) * frames) + f, run);
+					}
+					g->filled[0] += run;
+					f += run;
+
+					// Finish bins, carrying each finished bin up to the next level
+					muBool end = (beg + f) == reader->num_frames;
+					for (uint16_m l = 0; l < level_count; ++l) {
+						if (g->filled[l] != bin_sizes[l] && !end) {
+							break;
+						}
+						muafInner_PeakAcc* l_accs = g->accs + (((size_m)l) * channels);
+						muafInner_WritePeakBin(g->bins[l], l_accs, channels, g->filled[l]);
+						g->bins[l] += bin_len;
+						if (l+1 < level_count) {
+							muafInner_PeakAcc* n_accs = l_accs + channels;
+							for (uint16_m ch = 0; ch < channels; ++ch) {
+								n_accs[ch].min = (l_accs[ch].min < n_accs[ch].min) ? l_accs[ch].min : n_accs[ch].min;
+								n_accs[ch].max = (l_accs[ch].max > n_accs[ch].max) ? l_accs[ch].max : n_accs[ch].max;
+								n_accs[ch].sum_sq += l_accs[ch].sum_sq;
+							}
+							g->filled[l+1] += g->filled[l];
+						}
+						for (uint16_m ch = 0; ch < channels; ++ch) {
+							muafInner_ResetPeakAcc(&l_accs[ch]);
+						}
+						g->filled[l] = 0;
+					}
 				}
-				// Check for first metadata block being streaminfo
-				if ((data[4] & 0x7F) != 0) {
-					return MU_FALSE;
+
+				beg += frames;
+			}
+			return MUAF_SUCCESS;
+		}
+
+		// Creates a peak overview of a WAVE file
+		MUDEF muafResult mu_create_WAVE_peaks(const char* filename, muWAVEProfile* profile, uint16_m level_count, const uint32_m* bin_sizes, const char* peaks_filename) {
+			// Check bin sizes
+			uint32_m default_bin_sizes[3] = { 256, 4096, 65536 };
+			if (!bin_sizes) {
+				bin_sizes = default_bin_sizes;
+				level_count = 3;
+			}
+			if (level_count == 0 || bin_sizes[0] == 0) {
+				return MUAF_INVALID_PEAKS_BIN_SIZE;
+			}
+			for (uint16_m l = 1; l < level_count; ++l) {
+				if (bin_sizes[l] <= bin_sizes[l-1] || (bin_sizes[l] % bin_sizes[l-1]) != 0) {
+					return MUAF_INVALID_PEAKS_BIN_SIZE;
 				}
+			}
 
-				// Has fLaC and streaminfo metadata block, so likely FLAC.
-				return MU_TRUE;
+			// Open reader
+			muWAVEReader* reader;
+			muafResult res = mu_open_WAVE_reader(filename, profile, &reader);
+			if (muaf_result_is_fatal(res)) {
+				return res;
+			}
+			uint16_m channels = reader->channels;
+			uint32_m num_frames = reader->num_frames;
+
+			// Calculate sidecar layout
+			size_m bin_len = ((size_m)channels) * MUAF_PEAKS_PEAK_SIZE;
+			size_m len = MUAF_PEAKS_HEADER_SIZE + (((size_m)level_count) * 8);
+			for (uint16_m l = 0; l < level_count; ++l) {
+				len += ((size_m)((((uint64_m)num_frames) + bin_sizes[l] - 1) / bin_sizes[l])) * bin_len;
 			}
 
-			// Returns FLAC support for given audio formats
-			muBool muafFLAC_FormatSupport(muafAudioFormat format) {
-				// Perform based on audio format
-				switch (format) {
-					// Unknown
-					default: return MU_FALSE; break;
+			// Allocate sidecar and buffers
+			muafInner_PeaksGen g;
+			g.block_frames = MUAF_WAVE_READ_BLOCK_SIZE / reader->block_align;
+			if (g.block_frames == 0) {
+				g.block_frames = 1;
+			}
+			size_m acc_count = ((size_m)level_count) * channels;
+			muByte* sidecar = (muByte*)mu_malloc(len);
+			g.accs = (muafInner_PeakAcc*)mu_malloc(sizeof(muafInner_PeakAcc) * acc_count);
+			g.filled = (uint32_m*)mu_malloc(sizeof(uint32_m) * level_count);
+			g.bins = (muByte**)mu_malloc(sizeof(muByte*) * level_count);
+			g.block = (muByte*)mu_malloc(g.block_frames * channels * reader->sample_size);
+			g.samples = (float*)mu_malloc(sizeof(float) * g.block_frames * channels);
+
+			if (!sidecar || !g.accs || !g.filled || !g.bins || !g.block || !g.samples) {
+				res = MUAF_FAILED_MALLOC;
+			}
+			else {
+				// Write header
+				MU_WBEU32(sidecar, 0x6D75504B);
+				MU_WLEU16(sidecar+4, 1);
+				MU_WLEU16(sidecar+6, channels);
+				MU_WLEU32(sidecar+8, reader->sample_rate);
+				MU_WLEU32(sidecar+12, num_frames);
+				MU_WLEU16(sidecar+16, level_count);
+				MU_WLEU16(sidecar+18, 0);
+				muByte* level_bins = sidecar + MUAF_PEAKS_HEADER_SIZE + (((size_m)level_count) * 8);
+				for (uint16_m l = 0; l < level_count; ++l) {
+					uint32_m bin_count = (uint32_m)((((uint64_m)num_frames) + bin_sizes[l] - 1) / bin_sizes[l]);
+					MU_WLEU32(sidecar + MUAF_PEAKS_HEADER_SIZE + (l * 8), bin_sizes[l]);
+					MU_WLEU32(sidecar + MUAF_PEAKS_HEADER_SIZE + (l * 8) + 4, bin_count);
+					g.bins[l] = level_bins;
+					level_bins += ((size_m)bin_count) * bin_len;
+					g.filled[l] = 0;
+				}
+				for (size_m a = 0; a < acc_count; ++a) {
+					muafInner_ResetPeakAcc(&g.accs[a]);
+				}
 
-					// Supported PCM
-					case MUAF_FORMAT_PCM_S8:  case MUAF_FORMAT_PCM_S16:
-					case MUAF_FORMAT_PCM_S24: case MUAF_FORMAT_PCM_S32:
-						return MU_TRUE;
-					break;
+				// Fill bins
+				res = muafWAVE_GeneratePeaks(reader, level_count, bin_sizes, &g);
+
+				// Write sidecar
+				if (!muaf_result_is_fatal(res)) {
+					FILE_M* f = muafInner_FOpen(peaks_filename, "wb");
+					if (!f) {
+						res = MUAF_FAILED_CREATE_FILE;
+					}
+					else {
+						if (muafInner_FWrite(sidecar, 1, len, f) != len) {
+							res = MUAF_FAILED_WRITE_FILE;
+						}
+						mu_fclose(f);
+					}
 				}
 			}
 
-		/* Profiling */
+			if (sidecar) mu_free(sidecar);
+			if (g.accs) mu_free(g.accs);
+			if (g.filled) mu_free(g.filled);
+			if (g.bins) mu_free(g.bins);
+			if (g.block) mu_free(g.block);
+			if (g.samples) mu_free(g.samples);
+			mu_close_WAVE_reader(reader);
+			return res;
+		}
 
-			// Reads information from the streaminfo metadata block
-			// Streaminfo's existence and its min. length should already be confirmed (muafFLAC_IsFLAC)
-			muafResult muafFLAC_ProcessStreaminfo(muafInner_File* file, muFLACProfile* profile, muBool* more) {
-				// Read streaminfo block (including header)
-				muByte data[38];
-				muafInner_LoadFromFile(file, 4, 38, data);
+		// Loads a peak overview
+		MUDEF muafResult mu_load_peaks(const char* filename, muPeaks* peaks) {
+			// Read whole file
+			muafInner_File file;
+			if (muafInner_LoadFile(filename, &file) != 0) {
+				return MUAF_FAILED_OPEN_FILE;
+			}
+			if (file.len < MUAF_PEAKS_HEADER_SIZE) {
+				muafInner_DeloadFile(&file);
+				return MUAF_INVALID_PEAKS_FILE;
+			}
+			muByte* data = (muByte*)mu_malloc(file.len);
+			if (!data) {
+				muafInner_DeloadFile(&file);
+				return MUAF_FAILED_MALLOC;
+			}
+			muafInner_FSeek(file.fptr, 0L, MU_SEEK_SET);
+			size_m read_len = muafInner_FRead(data, 1, file.len, file.fptr);
+			size_m len = file.len;
+			muafInner_DeloadFile(&file);
+			if (read_len != len) {
+				mu_free(data);
+				return MUAF_FAILED_READ_FILE;
+			}
 
-				// Read if there's more metadata blocks after this
-				*more = (data[0] & 0x80) == 0;
+			// Read header
+			peaks->channels = MU_RLEU16(data+6);
+			peaks->sample_rate = MU_RLEU32(data+8);
+			peaks->num_frames = MU_RLEU32(data+12);
+			peaks->level_count = MU_RLEU16(data+16);
+			if (MU_RBEU32(data) != 0x6D75504B || MU_RLEU16(data+4) != 1 || peaks->channels == 0 || peaks->level_count == 0
+				|| len < MUAF_PEAKS_HEADER_SIZE + (((size_m)peaks->level_count) * 8)
+			) {
+				mu_free(data);
+				return MUAF_INVALID_PEAKS_FILE;
+			}
 
-				// Read and confirm streaminfo's listed length
-				if (MU_RBEU24(data+1) != 34) {
-					return MUAF_INVALID_FLAC_STREAMINFO_LENGTH;
+			// Read levels
+			peaks->levels = (muPeaksLevel*)mu_malloc(sizeof(muPeaksLevel) * peaks->level_count);
+			if (!peaks->levels) {
+				mu_free(data);
+				return MUAF_FAILED_MALLOC;
+			}
+			size_m bin_len = ((size_m)peaks->channels) * MUAF_PEAKS_PEAK_SIZE;
+			size_m index = MUAF_PEAKS_HEADER_SIZE + (((size_m)peaks->level_count) * 8);
+			for (uint16_m l = 0; l < peaks->level_count; ++l) {
+				muPeaksLevel* level = &peaks->levels[l];
+				level->bin_size = MU_RLEU32(data + MUAF_PEAKS_HEADER_SIZE + (l * 8));
+				level->bin_count = MU_RLEU32(data + MUAF_PEAKS_HEADER_SIZE + (l * 8) + 4);
+				level->bins = data + index;
+				// (Bin count must match the amount of frames, and bins must fit in the file)
+				if (level->bin_size == 0 || (l > 0 && level->bin_size <= peaks->levels[l-1].bin_size)
+					|| level->bin_count != (uint32_m)((((uint64_m)peaks->num_frames) + level->bin_size - 1) / level->bin_size)
+					|| ((size_m)level->bin_count) * bin_len > len - index
+				) {
+					mu_free(peaks->levels);
+					mu_free(data);
+					return MUAF_INVALID_PEAKS_FILE;
 				}
+				index += ((size_m)level->bin_count) * bin_len;
+			}
 
-				// Read and confirm min. block size
-				profile->min_block_size = MU_RBEU16(data+4);
-				if (profile->min_block_size < 16) {
-					return MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_RANGE;
-				}
-				// Read and confirm max. block size
-				profile->max_block_size = MU_RBEU16(data+6);
-				if (profile->max_block_size < 16) {
-					return MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_RANGE;
+			peaks->data = data;
+			return MUAF_SUCCESS;
+		}
+
+		// Frees a peak overview
+		MUDEF void mu_free_peaks(muPeaks* peaks) {
+			mu_free(peaks->levels);
+			mu_free(peaks->data);
+		}
+
+		// Queries a peak overview
+		MUDEF void mu_query_peaks(muPeaks* peaks, uint32_m beg_frame, uint32_m frame_len, uint32_m bin_count, muPeak* data) {
+			// Pick the level with the largest bin size that fits within a requested bin
+			uint32_m frames_per_bin = frame_len / bin_count;
+			muPeaksLevel* level = &peaks->levels[0];
+			for (uint16_m l = 1; l < peaks->level_count; ++l) {
+				if (peaks->levels[l].bin_size <= frames_per_bin) {
+					level = &peaks->levels[l];
 				}
-				if (profile->max_block_size < profile->min_block_size) {
-					return MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_MIN_MAX;
+			}
+			size_m bin_len = ((size_m)peaks->channels) * MUAF_PEAKS_PEAK_SIZE;
+
+			// Calculate each requested bin
+			for (uint32_m i = 0; i < bin_count; ++i) {
+				uint32_m beg = beg_frame + (uint32_m)((((uint64_m)i) * frame_len) / bin_count);
+				uint32_m end = beg_frame + (uint32_m)((((uint64_m)i+1) * frame_len) / bin_count);
+				if (end == beg) {
+					end = beg + 1;
 				}
+				uint32_m first = beg / level->bin_size;
+				uint32_m last = (end - 1) / level->bin_size;
+
+				muPeak* out = data + (((size_m)i) * peaks->channels);
+				for (uint16_m ch = 0; ch < peaks->channels; ++ch) {
+					int16_m mn = 32767;
+					int16_m mx = -32768;
+					double sum_sq = 0.0;
+					uint64_m frames = 0;
+
+					for (uint32_m b = first; b <= last; ++b) {
+						muByte* peak = level->bins + (((size_m)b) * bin_len) + (((size_m)ch) * MUAF_PEAKS_PEAK_SIZE);
+						int16_m b_min = MU_RLES16(peak);
+						int16_m b_max = MU_RLES16(peak+2);
+						double b_rms = ((double)MU_RLEU16(peak+4)) / 65535.0;
+						// (Last bin can be partial)
+						uint64_m b_frames = level->bin_size;
+						if (((uint64_m)b + 1) * level->bin_size > peaks->num_frames) {
+							b_frames = peaks->num_frames - (((uint64_m)b) * level->bin_size);
+						}
 
-				// Read min. frame size
-				profile->min_frame_size = MU_RBEU24(data+8);
-				// Read and confirm max. frame size
-				profile->max_frame_size = MU_RBEU24(data+11);
-				if (profile->min_frame_size != 0 && profile->max_frame_size != 0) {
-					if (profile->max_frame_size < profile->min_frame_size) {
-						return MUAF_INVALID_FLAC_STREAMINFO_FRAME_SIZE_MIN_MAX;
+						mn = (b_min < mn) ? b_min : mn;
+						mx = (b_max > mx) ? b_max : mx;
+						sum_sq += b_rms * b_rms * (double)b_frames;
+						frames += b_frames;
 					}
+
+					out[ch].min = ((float)mn) / 32768.f;
+					out[ch].max = ((float)mx) / 32768.f;
+					out[ch].rms = (float)mu_sqrt(sum_sq / (double)frames);
 				}
+			}
+		}
 
-				// Read sample rate (b=14, l=20)
-				profile->sample_rate = (MU_RBEU24(data+14) & 0xFFFFF0) >> 4;
-				// Interpret sample rate
-				profile->contains_audio = profile->sample_rate != 0;
+	/* Loudness analysis */
+
+		// Amount of 100 ms sub-blocks in a momentary (400 ms) and short-term (3 s) block
+		#define MUAF_LOUDNESS_MOMENTARY 4
+		#define MUAF_LOUDNESS_SHORT_TERM 30
+
+		// Struct representing a loudness meter
+		struct muLoudnessMeter {
+			uint16_m channels;
+			// Weight of each channel
+			double* weights;
+			// K-weighting filter coefficients (shelf, then high-pass)
+			double shelf_b[3];
+			double shelf_a[2];
+			double hp_b[3];
+			double hp_a[2];
+			// K-weighting filter state of each channel (transposed direct form II)
+			double* shelf_z1;
+			double* shelf_z2;
+			double* hp_z1;
+			double* hp_z2;
+			// Current 100 ms sub-block
+			uint32_m sub_len;
+			uint32_m sub_filled;
+			double* sub_sum;
+			// Energies of the last sub-blocks (ring)
+			double ring[MUAF_LOUDNESS_SHORT_TERM];
+			size_m sub_count;
+			// Energies of each momentary and short-term block
+			double* momentary;
+			size_m momentary_len;
+			double* short_term;
+			size_m short_term_len;
+			size_m block_cap;
+			// True peak oversampling; each channel's history holds the last
+			// taps-1 frames, followed by room for a block of frames
+			muResampleFilter* oversample;
+			double* history;
+			size_m history_len;
+			double true_peak;
+			double sample_peak;
+		};
+
+		// Gets a sample of any PCM format scaled to -1 to 1
+		double muafInner_ScaledSample(muafAudioFormat format, void* data, size_m s) {
+			switch (format) {
+				default: return 0.0; break;
+				case MUAF_FORMAT_PCM_U8:  return (((double)((uint8_m*)data)[s]) - 128.0) / 128.0; break;
+				case MUAF_FORMAT_PCM_S8:  return ((double)((int8_m*)data)[s]) / 128.0; break;
+				case MUAF_FORMAT_PCM_S16: return ((double)((int16_m*)data)[s]) / 32768.0; break;
+				case MUAF_FORMAT_PCM_S24: return ((double)((int32_m*)data)[s]) / 8388608.0; break;
+				case MUAF_FORMAT_PCM_S32: return ((double)((int32_m*)data)[s]) / 2147483648.0; break;
+				case MUAF_FORMAT_PCM_S64: return ((double)((int64_m*)data)[s]) / 9223372036854775808.0; break;
+			}
+		}
+
+		// Creates a loudness meter
+		MUDEF muafResult mu_create_loudness_meter(uint32_m sample_rate, uint16_m channels, muLoudnessMeter** meter) {
+			if (sample_rate < 10 || sample_rate > 0x3FFFFFFF || channels == 0) {
+				return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+			}
+
+			// Allocate meter
+			muLoudnessMeter* m = (muLoudnessMeter*)mu_malloc(sizeof(muLoudnessMeter));
+			if (!m) {
+				return MUAF_FAILED_MALLOC;
+			}
+			mu_memset(m, 0, sizeof(muLoudnessMeter));
+			m->channels = channels;
+
+			// Create oversampling filter
+			muafResult res = mu_create_resample_filter(sample_rate, sample_rate * 4, MUAF_RESAMPLE_QUALITY_HIGH, &m->oversample);
+			if (muaf_result_is_fatal(res)) {
+				mu_free(m);
+				return res;
+			}
+
+			// Allocate per-channel data
+			// (Weights, filter state, and sub-block sums are 6 arrays of channels)
+			m->weights = (double*)mu_malloc(sizeof(double) * channels * 6);
+			m->history_len = ((size_m)m->oversample->taps) - 1 + MUAF_LOUDNESS_BLOCK_SIZE;
+			m->history = (double*)mu_malloc(sizeof(double) * channels * m->history_len);
+			if (!m->weights || !m->history) {
+				mu_destroy_loudness_meter(m);
+				return MUAF_FAILED_MALLOC;
+			}
+			mu_memset(m->weights, 0, sizeof(double) * channels * 6);
+			mu_memset(m->history, 0, sizeof(double) * channels * m->history_len);
+			m->shelf_z1 = m->weights + channels;
+			m->shelf_z2 = m->shelf_z1 + channels;
+			m->hp_z1 = m->shelf_z2 + channels;
+			m->hp_z2 = m->hp_z1 + channels;
+			m->sub_sum = m->hp_z2 + channels;
+
+			// Channel weights
+			for (uint16_m ch = 0; ch < channels; ++ch) {
+				m->weights[ch] = 1.0;
+			}
+			if (channels == 5) {
+				m->weights[3] = 1.41;
+				m->weights[4] = 1.41;
+			}
+			else if (channels == 6) {
+				m->weights[3] = 0.0;
+				m->weights[4] = 1.41;
+				m->weights[5] = 1.41;
+			}
+
+			// K-weighting coefficients for this sample rate
+			// (BS.1770-4 only gives them for 48000 Hz; these are derived from the
+			// analog prototype so that they match at 48000 Hz)
+			double pi = 3.14159265358979323846;
+			double rate = (double)sample_rate;
+			// - High shelf
+			double k = mu_tan(pi * 1681.974450955533 / rate);
+			double q = 0.7071752369554196;
+			double vh = mu_pow(10.0, 3.999843853973347 / 20.0);
+			double vb = mu_pow(vh, 0.4996667741545416);
+			double a0 = 1.0 + (k / q) + (k * k);
+			m->shelf_b[0] = (vh + (vb * k / q) + (k * k)) / a0;
+			m->shelf_b[1] = 2.0 * ((k * k) - vh) / a0;
+			m->shelf_b[2] = (vh - (vb * k / q) + (k * k)) / a0;
+			m->shelf_a[0] = 2.0 * ((k * k) - 1.0) / a0;
+			m->shelf_a[1] = (1.0 - (k / q) + (k * k)) / a0;
+			// - High-pass
+			k = mu_tan(pi * 38.13547087602444 / rate);
+			q = 0.5003270373238773;
+			a0 = 1.0 + (k / q) + (k * k);
+			m->hp_b[0] = 1.0;
+			m->hp_b[1] = -2.0;
+			m->hp_b[2] = 1.0;
+			m->hp_a[0] = 2.0 * ((k * k) - 1.0) / a0;
+			m->hp_a[1] = (1.0 - (k / q) + (k * k)) / a0;
+
+			m->sub_len = sample_rate / 10;
+			*meter = m;
+			return MUAF_SUCCESS;
+		}
+
+		// Destroys a loudness meter
+		MUDEF void mu_destroy_loudness_meter(muLoudnessMeter* meter) {
+			if (meter->weights) mu_free(meter->weights);
+			if (meter->history) mu_free(meter->history);
+			if (meter->momentary) mu_free(meter->momentary);
+			if (meter->short_term) mu_free(meter->short_term);
+			mu_destroy_resample_filter(meter->oversample);
+			mu_free(meter);
+		}
 
-				// Read number of channels (b=16, o=4, l=3)
-				profile->num_channels = ((*(data+16) & 0xE) >> 0x1) + 1;
+		// Finishes a 100 ms sub-block, storing the blocks that end with it
+		muafResult muafInner_FinishLoudnessSubBlock(muLoudnessMeter* m) {
+			// Weighted energy of sub-block
+			double energy = 0.0;
+			for (uint16_m ch = 0; ch < m->channels; ++ch) {
+				energy += m->weights[ch] * m->sub_sum[ch];
+				m->sub_sum[ch] = 0.0;
+			}
+			m->ring[m->sub_count % MUAF_LOUDNESS_SHORT_TERM] = energy / (double)m->sub_len;
+			m->sub_count += 1;
+			m->sub_filled = 0;
+
+			// Make room for blocks
+			if (m->momentary_len == m->block_cap) {
+				size_m cap = (m->block_cap == 0) ? 1024 : (m->block_cap * 2);
+				double* momentary = (double*)mu_realloc(m->momentary, sizeof(double) * cap);
+				if (!momentary) {
+					return MUAF_FAILED_REALLOC;
+				}
+				m->momentary = momentary;
+				double* short_term = (double*)mu_realloc(m->short_term, sizeof(double) * cap);
+				if (!short_term) {
+					return MUAF_FAILED_REALLOC;
+				}
+				m->short_term = short_term;
+				m->block_cap = cap;
+			}
 
-				// Read and confirm bits per sample (b=16, o=7, l=5)
-				profile->bits_per_sample = ((MU_RBEU16(data+16) & 0x1F0) >> 4) + 1;
-				if (profile->bits_per_sample < 4) {
-					return MUAF_INVALID_FLAC_STREAMINFO_BITS_PER_SAMPLE;
+			// Store blocks that are complete
+			if (m->sub_count >= MUAF_LOUDNESS_MOMENTARY) {
+				double sum = 0.0;
+				for (size_m s = m->sub_count - MUAF_LOUDNESS_MOMENTARY; s < m->sub_count; ++s) {
+					sum += m->ring[s % MUAF_LOUDNESS_SHORT_TERM];
+				}
+				m->momentary[m->momentary_len++] = sum / MUAF_LOUDNESS_MOMENTARY;
+			}
+			if (m->sub_count >= MUAF_LOUDNESS_SHORT_TERM) {
+				double sum = 0.0;
+				for (size_m s = 0; s < MUAF_LOUDNESS_SHORT_TERM; ++s) {
+					sum += m->ring[s];
 				}
+				m->short_term[m->short_term_len++] = sum / MUAF_LOUDNESS_SHORT_TERM;
+			}
+			return MUAF_SUCCESS;
+		}
 
-				// Read and confirm interchannel sample count (b=17, o=4, l=36)
-				profile->num_samples = (MU_RBEU64(data+17) & 0xFFFFFFFFF000000) >> 24;
-				if (
-					( profile->contains_audio && profile->num_samples == 0) || 
-					(!profile->contains_audio && profile->num_samples != 0)) {
-					return MUAF_INVALID_FLAC_STREAMINFO_SAMPLE_COUNT;
+		// Updates true peak with frames in the history of each channel
+		// The history holds taps-1 frames before the new frames; every new frame
+		// completes the window of the frame 'taps-1-left' frames before it
+		double muafInner_OversamplePeak(muResampleFilter* filter, const double* history, size_m new_len) {
+			double peak = 0.0;
+			for (size_m f = 0; f < new_len; ++f) {
+				for (uint32_m p = 0; p < filter->phases; ++p) {
+					double v = muafInner_ResampleDot(history + f, filter->bank + (((size_m)p) * filter->taps), filter->taps);
+					v = (v < 0.0) ? -v : v;
+					peak = (v > peak) ? v : peak;
 				}
+			}
+			return peak;
+		}
 
-				// Read low and high bytes of checksum (b=22, l=128)
-				profile->high_checksum = MU_RBEU64(data+22);
-				profile->low_checksum = MU_RBEU64(data+30);
-				return MUAF_SUCCESS;
+		// Feeds frames into a loudness meter
+		MUDEF muafResult mu_feed_loudness_meter(muLoudnessMeter* meter, muafAudioFormat format, uint32_m frame_len, void* data) {
+			if (!MUAF_FORMAT_IS_PCM(format)) {
+				return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
 			}
 
-			// Returns if the given metadata block type has occurred before
-			muBool muafFLAC_HasMetadataBlockTypeOccurred(muFLACProfile* profile, uint8_m block_type) {
-				// Loop through each metadata block
-				for (size_m i = 0; i < profile->num_metadata_blocks; ++i) {
-					// If they match, return true
-					if (profile->metadata_blocks[i].block_type == block_type) {
-						return MU_TRUE;
+			uint16_m channels = meter->channels;
+			size_m carry = ((size_m)meter->oversample->taps) - 1;
+			for (uint32_m beg = 0; beg < frame_len; beg += MUAF_LOUDNESS_BLOCK_SIZE) {
+				uint32_m len = ((frame_len - beg) < MUAF_LOUDNESS_BLOCK_SIZE) ? (frame_len - beg) : MUAF_LOUDNESS_BLOCK_SIZE;
+
+				// Go through each frame
+				for (uint32_m f = 0; f < len; ++f) {
+					size_m s = (((size_m)beg) + f) * channels;
+					// (Channels are processed side by side so that this can be vectorized)
+					for (uint16_m ch = 0; ch < channels; ++ch) {
+						double x = muafInner_ScaledSample(format, data, s + ch);
+						meter->history[(ch * meter->history_len) + carry + f] = x;
+						double ax = (x < 0.0) ? -x : x;
+						meter->sample_peak = (ax > meter->sample_peak) ? ax : meter->sample_peak;
+
+						// K-weighting
+						double y = (meter->shelf_b[0] * x) + meter->shelf_z1[ch];
+						meter->shelf_z1[ch] = (meter->shelf_b[1] * x) - (meter->shelf_a[0] * y) + meter->shelf_z2[ch];
+						meter->shelf_z2[ch] = (meter->shelf_b[2] * x) - (meter->shelf_a[1] * y);
+						double z = (meter->hp_b[0] * y) + meter->hp_z1[ch];
+						meter->hp_z1[ch] = (meter->hp_b[1] * y) - (meter->hp_a[0] * z) + meter->hp_z2[ch];
+						meter->hp_z2[ch] = (meter->hp_b[2] * y) - (meter->hp_a[1] * z);
+
+						meter->sub_sum[ch] += z * z;
 					}
-				}
-				// No matches, return false
-				return MU_FALSE;
-			}
 
-			// Processes an individual metadata block
-			// Before calling, confirm:
-			// * there should be a metadata block at the given index.
-			// Fills in given metadata block
-			muafResult muafFLAC_ProcessMetadataBlock(muafInner_File* file, muFLACProfile* profile, muFLACMetadataBlock* block, size_m i, muBool* more) {
-				// Ensure length for header
-				if (file->len < i+4) {
-					return MUAF_INVALID_FLAC_METADATA_BLOCK_LENGTH;
+					meter->sub_filled += 1;
+					if (meter->sub_filled == meter->sub_len) {
+						muafResult res = muafInner_FinishLoudnessSubBlock(meter);
+						if (muaf_result_is_fatal(res)) {
+							return res;
+						}
+					}
 				}
-				// Read header
-				muByte header[4];
-				muafInner_LoadFromFile(file, i, 4, header);
 
-				// Indicate if there's more based on first bit
-				*more = (header[0] & 0x80) == 0;
+				// True peak, then keep the last frames as history
+				for (uint16_m ch = 0; ch < channels; ++ch) {
+					double* history = meter->history + (ch * meter->history_len);
+					double peak = muafInner_OversamplePeak(meter->oversample, history, len);
+					meter->true_peak = (peak > meter->true_peak) ? peak : meter->true_peak;
+					// (Can overlap, so copied forward by hand)
+					for (size_m h = 0; h < carry; ++h) {
+						history[h] = history[h + len];
+					}
+				}
+			}
 
-				// Identify and verify metadata block type
-				block->block_type = header[0] & 0x7F;
-				switch (block->block_type) {
-					default: break;
+			return MUAF_SUCCESS;
+		}
 
-					// Forbidden value
-					case 127: return MUAF_INVALID_FLAC_METADATA_BLOCK_TYPE; break;
+		// Compares doubles for sorting
+		int muafInner_CompareDoubles(const void* a, const void* b) {
+			double da = *(const double*)a;
+			double db = *(const double*)b;
+			return (da > db) - (da < db);
+		}
 
-					// Duplicate streaminfo
-					case 0: return MUAF_INVALID_FLAC_DUPLICATE_STREAMINFO; break;
+		// Converts energy to LUFS
+		double muafInner_EnergyToLUFS(double energy) {
+			return -0.691 + (10.0 * mu_log10(energy));
+		}
 
-					// Seek table
-					case MU_FLAC_METADATA_SEEK_TABLE: {
-						// Verify no duplicates
-						if (muafFLAC_HasMetadataBlockTypeOccurred(profile, block->block_type)) {
-							return MUAF_INVALID_FLAC_DUPLICATE_SEEK_TABLE;
-						}
-					} break;
+		// Converts linear peak to dB
+		double muafInner_PeakToDB(double peak) {
+			return (peak > 0.0) ? (20.0 * mu_log10(peak)) : -200.0;
+		}
 
-					// Vorbis comment
-					case MU_FLAC_METADATA_VORBIS_COMMENT: {
-						// Verify no duplicates
-						if (muafFLAC_HasMetadataBlockTypeOccurred(profile, block->block_type)) {
-							return MUAF_INVALID_FLAC_DUPLICATE_VORBIS_COMMENT;
-						}
-					} break;
+		// Gets the loudness of a loudness meter
+		MUDEF void mu_get_loudness(muLoudnessMeter* meter, muLoudness* loudness) {
+			// Integrated loudness
+			// - Absolute gate (-70 LUFS)
+			double abs_gate = mu_pow(10.0, (-70.0 + 0.691) / 10.0);
+			double sum = 0.0;
+			size_m count = 0;
+			for (size_m b = 0; b < meter->momentary_len; ++b) {
+				if (meter->momentary[b] > abs_gate) {
+					sum += meter->momentary[b];
+					count += 1;
 				}
-
-				// Read and verify block length
-				block->length = MU_RBEU24(header+1);
-				if (file->len < i+4 + ((size_m)block->length)) {
-					return MUAF_INVALID_FLAC_METADATA_BLOCK_LENGTH;
+			}
+			// - Relative gate (-10 LU)
+			loudness->integrated = -70.0;
+			if (count != 0) {
+				double rel_gate = (sum / (double)count) * 0.1;
+				double gated_sum = 0.0;
+				size_m gated_count = 0;
+				for (size_m b = 0; b < meter->momentary_len; ++b) {
+					if (meter->momentary[b] > abs_gate && meter->momentary[b] > rel_gate) {
+						gated_sum += meter->momentary[b];
+						gated_count += 1;
+					}
+				}
+				if (gated_count != 0) {
+					loudness->integrated = muafInner_EnergyToLUFS(gated_sum / (double)gated_count);
 				}
-				// Set block index
-				block->index = i + 4;
-
-				return MUAF_SUCCESS;
 			}
 
-			// Processes all metadata blocks
-			// Before calling, confirm:
-			// * there should be at least one metadata block after the initial streaminfo.
-			muafResult muafFLAC_ProcessMetadata(muafInner_File* file, muFLACProfile* profile) {
-				// Initialize allocated metadata block array
-				size_m alloc_len = 4;
-				profile->metadata_blocks = (muFLACMetadataBlock*)mu_malloc(sizeof(muFLACMetadataBlock) * alloc_len);
-				if (!profile->metadata_blocks) {
-					return MUAF_FAILED_MALLOC;
+			// Loudness range
+			// (Short-term blocks are gated in place, and the 10th and 95th
+			// percentiles are taken from the sorted gated blocks)
+			loudness->range = 0.0;
+			sum = 0.0;
+			count = 0;
+			for (size_m b = 0; b < meter->short_term_len; ++b) {
+				if (meter->short_term[b] > abs_gate) {
+					sum += meter->short_term[b];
+					count += 1;
 				}
-
-				// Initialize file index at 42, right after streaminfo
-				size_m i = 42;
-				// Holder for if there's more metadata:
-				muBool more = MU_TRUE;
-				// Holder for result:
-				muafResult res = MUAF_SUCCESS;
-
-				// Loop through each metadata block
-				while (more) {
-					// If we've exceeded the allocated length, attempt to reallocate
-					// with double the amount from before
-					if (profile->num_metadata_blocks+1 > alloc_len) {
-						alloc_len *= 2;
-						muFLACMetadataBlock* new_blocks = (muFLACMetadataBlock*)mu_realloc(
-							profile->metadata_blocks,
-							sizeof(muFLACMetadataBlock) * alloc_len
-						);
-						if (new_blocks == 0) {
-							// (Gets freed, don't worry)
-							return MUAF_FAILED_REALLOC;
+			}
+			if (count != 0) {
+				// - Relative gate (-20 LU); gated blocks are moved to the front
+				double rel_gate = (sum / (double)count) * 0.01;
+				double* gated = (double*)mu_malloc(sizeof(double) * count);
+				if (gated) {
+					size_m gated_count = 0;
+					for (size_m b = 0; b < meter->short_term_len; ++b) {
+						if (meter->short_term[b] > abs_gate && meter->short_term[b] > rel_gate) {
+							gated[gated_count++] = meter->short_term[b];
 						}
-						profile->metadata_blocks = new_blocks;
 					}
-
-					// Process this metadata block
-					res = muafFLAC_ProcessMetadataBlock(
-						file, profile,
-						&profile->metadata_blocks[profile->num_metadata_blocks],
-						i, &more
-					);
-					if (muaf_result_is_fatal(res)) {
-						return res;
+					if (gated_count != 0) {
+						mu_qsort(gated, gated_count, sizeof(double), muafInner_CompareDoubles);
+						double low = gated[(size_m)(((double)(gated_count - 1) * 0.10) + 0.5)];
+						double high = gated[(size_m)(((double)(gated_count - 1) * 0.95) + 0.5)];
+						loudness->range = muafInner_EnergyToLUFS(high) - muafInner_EnergyToLUFS(low);
 					}
+					mu_free(gated);
+				}
+			}
 
-					// Increment index based on metadata block length (including header)
-					i += 4 + profile->metadata_blocks[profile->num_metadata_blocks].length;
-					// Increment metadata block length
-					++profile->num_metadata_blocks;
+			// True peak, including the frames that are still waiting on the
+			// frames after them (treated as silence)
+			double true_peak = meter->true_peak;
+			size_m carry = ((size_m)meter->oversample->taps) - 1;
+			size_m tail = carry - meter->oversample->left;
+			double* scratch = (double*)mu_malloc(sizeof(double) * (carry + tail));
+			if (scratch) {
+				for (uint16_m ch = 0; ch < meter->channels; ++ch) {
+					mu_memcpy(scratch, meter->history + (ch * meter->history_len), sizeof(double) * carry);
+					mu_memset(scratch + carry, 0, sizeof(double) * tail);
+					double peak = muafInner_OversamplePeak(meter->oversample, scratch, tail);
+					true_peak = (peak > true_peak) ? peak : true_peak;
 				}
+				mu_free(scratch);
+			}
+			// (True peak can't be below the sample peak)
+			true_peak = (meter->sample_peak > true_peak) ? meter->sample_peak : true_peak;
 
+			loudness->true_peak = muafInner_PeakToDB(true_peak);
+			loudness->sample_peak = muafInner_PeakToDB(meter->sample_peak);
+			loudness->replay_gain = -18.0 - loudness->integrated;
+		}
+
+		// Analyzes the loudness of a WAVE file
+		MUDEF muafResult mu_analyze_WAVE_loudness(const char* filename, muWAVEProfile* profile, muLoudness* loudness) {
+			// Open reader and meter
+			muWAVEReader* reader;
+			muafResult res = mu_open_WAVE_reader(filename, profile, &reader);
+			if (muaf_result_is_fatal(res)) {
+				return res;
+			}
+			muLoudnessMeter* meter;
+			res = mu_create_loudness_meter(reader->sample_rate, reader->channels, &meter);
+			if (muaf_result_is_fatal(res)) {
+				mu_close_WAVE_reader(reader);
 				return res;
 			}
 
-			// Gets FLAC profile
-			MUDEF muafResult mu_get_FLAC_profile(const char* filename, muFLACProfile* profile) {
-				// Open file
-				muafInner_File file;
-				if (muafInner_LoadFile(filename, &file) != 0) {
-					return MUAF_FAILED_OPEN_FILE;
-				}
+			// Allocate block
+			size_m block_frames = MUAF_WAVE_READ_BLOCK_SIZE / reader->block_align;
+			if (block_frames == 0) {
+				block_frames = 1;
+			}
+			muByte* block = (muByte*)mu_malloc(block_frames * reader->channels * reader->sample_size);
+			if (!block) {
+				mu_destroy_loudness_meter(meter);
+				mu_close_WAVE_reader(reader);
+				return MUAF_FAILED_MALLOC;
+			}
 
-				// Make sure it's FLAC
-				if (!muafFLAC_IsFLAC(&file)) {
-					muafInner_DeloadFile(&file);
-					return MUAF_FAILED_AUDIO_FILE_FORMAT_IDENTIFICATION;
+			// Feed each block
+			for (uint32_m beg = 0; beg < reader->num_frames; ) {
+				uint32_m frames = ((reader->num_frames - beg) < block_frames) ? (reader->num_frames - beg) : (uint32_m)block_frames;
+				res = mu_read_WAVE_reader(reader, beg, frames, block);
+				if (muaf_result_is_fatal(res)) {
+					break;
 				}
-				// Zero-out profile memory
-				mu_memset(profile, 0, sizeof(muFLACProfile));
-
-				// Get streaminfo
-				muBool more;
-				muafResult res = muafFLAC_ProcessStreaminfo(&file, profile, &more);
+				res = mu_feed_loudness_meter(meter, reader->format, frames, block);
 				if (muaf_result_is_fatal(res)) {
-					muafInner_DeloadFile(&file);
-					mu_free_FLAC_profile(profile);
-					return res;
+					break;
 				}
+				beg += frames;
+			}
 
-				// If there's more metadata blocks after streaminfo, process them
-				if (more) {
-					res = muafFLAC_ProcessMetadata(&file, profile);
-					if (muaf_result_is_fatal(res)) {
-						muafInner_DeloadFile(&file);
-						mu_free_FLAC_profile(profile);
-						return res;
-					}
-				}
+			if (!muaf_result_is_fatal(res)) {
+				mu_get_loudness(meter, loudness);
+			}
+			mu_free(block);
+			mu_destroy_loudness_meter(meter);
+			mu_close_WAVE_reader(reader);
+			return res;
+		}
 
-				// Close file and return
-				muafInner_DeloadFile(&file);
-				return res;
+	/* Content hashing */
+
+		// Hash of audio data in progress, split into segments
+		struct muafInner_AudioHash {
+			muafInner_XXH64 whole;
+			muafInner_XXH64 segment;
+			size_m frame_size;
+			uint32_m segment_len;
+			uint32_m segment_filled;
+			uint64_m* segment_hashes;
+		};
+		typedef struct muafInner_AudioHash muafInner_AudioHash;
+
+		// Starts hashing audio data
+		void muafInner_AudioHashInit(muafInner_AudioHash* h, size_m frame_size, uint32_m segment_len, uint64_m* segment_hashes) {
+			muafInner_XXH64Init(&h->whole);
+			muafInner_XXH64Init(&h->segment);
+			h->frame_size = frame_size;
+			h->segment_len = (segment_hashes) ? segment_len : 0;
+			h->segment_filled = 0;
+			h->segment_hashes = segment_hashes;
+		}
+
+		// Hashes frames in canonical form
+		void muafInner_AudioHashUpdate(muafInner_AudioHash* h, muByte* data, size_m frame_count) {
+			muafInner_XXH64Update(&h->whole, data, frame_count * h->frame_size);
+			if (h->segment_len == 0) {
+				return;
 			}
 
-			// Frees FLAC profile
-			MUDEF void mu_free_FLAC_profile(muFLACProfile* profile) {
-				// Free metadata blocks if they exist
-				if (profile->metadata_blocks != 0) {
-					mu_free(profile->metadata_blocks);
+			// Split between segments
+			while (frame_count != 0) {
+				size_m run = h->segment_len - h->segment_filled;
+				if (run > frame_count) {
+					run = frame_count;
+				}
+				muafInner_XXH64Update(&h->segment, data, run * h->frame_size);
+				data += run * h->frame_size;
+				frame_count -= run;
+				h->segment_filled += (uint32_m)run;
+
+				if (h->segment_filled == h->segment_len) {
+					*h->segment_hashes++ = muafInner_XXH64Final(&h->segment);
+					muafInner_XXH64Init(&h->segment);
+					h->segment_filled = 0;
 				}
 			}
+		}
 
-	/* Audio file format and audio formats */
+		// Finishes hashing audio data
+		void muafInner_AudioHashFinal(muafInner_AudioHash* h, uint64_m* hash) {
+			if (h->segment_filled != 0) {
+				*h->segment_hashes = muafInner_XXH64Final(&h->segment);
+			}
+			if (hash) {
+				*hash = muafInner_XXH64Final(&h->whole);
+			}
+		}
 
-		// Retrieves audio file format from file
-		MUDEF muafFileFormat mu_audio_file_format(const char* filename) {
-			// Open file
-			muafInner_File file;
-			if (muafInner_LoadFile(filename, &file) != 0) {
-				return MUAF_UNKNOWN;
+		// Hashes WAVE audio data
+		MUDEF muafResult mu_hash_WAVE_audio(const char* filename, muWAVEProfile* profile, uint32_m segment_len, uint64_m* hash, uint64_m* segment_hashes) {
+			// Open reader
+			muWAVEReader* reader;
+			muafResult res = mu_open_WAVE_reader(filename, profile, &reader);
+			if (muaf_result_is_fatal(res)) {
+				return res;
 			}
 
-			// Try each format lol
-			muafFileFormat format = MUAF_UNKNOWN;
-			if (muafWAVE_IsWAVE(&file)) {
-				format = MUAF_WAVE;
+			// Allocate block of raw data
+			size_m block_frames = MUAF_WAVE_READ_BLOCK_SIZE / reader->block_align;
+			if (block_frames == 0) {
+				block_frames = 1;
 			}
-			else if (muafFLAC_IsFLAC(&file)) {
-				format = MUAF_FLAC;
+			muByte* block = (muByte*)mu_malloc(block_frames * reader->block_align);
+			if (!block) {
+				mu_close_WAVE_reader(reader);
+				return MUAF_FAILED_MALLOC;
 			}
 
-			// Close file and return format
-			muafInner_DeloadFile(&file);
-			return format;
-		}
+			// Hash each block as it's read
+			muafInner_AudioHash h;
+			muafInner_AudioHashInit(&h, reader->block_align, segment_len, segment_hashes);
+			for (uint32_m beg = 0; beg < reader->num_frames; ) {
+				uint32_m frames = ((reader->num_frames - beg) < block_frames) ? (reader->num_frames - beg) : (uint32_m)block_frames;
+				size_m len = ((size_m)frames) * reader->block_align;
+				res = muafInner_ReadPFile(&reader->file, reader->wave + (((size_m)beg) * reader->block_align), len, block);
+				if (muaf_result_is_fatal(res)) {
+					break;
+				}
+				// (Unsigned 8-bit samples are the only ones not already canonical)
+				if (reader->format == MUAF_FORMAT_PCM_U8) {
+					for (size_m b = 0; b < len; ++b) {
+						block[b] ^= 0x80;
+					}
+				}
+				muafInner_AudioHashUpdate(&h, block, frames);
+				beg += frames;
+			}
 
-		// Returns audio format supported for a given audio file format
-		MUDEF muBool muaf_audio_format_supported(muafFileFormat file_format, muafAudioFormat audio_format) {
-			// Perform based on file format
-			switch (file_format) {
-				default: return MU_FALSE; break;
-				case MUAF_WAVE: return muafWAVE_FormatSupport(audio_format); break;
-				case MUAF_FLAC: return muafFLAC_FormatSupport(audio_format);
+			if (!muaf_result_is_fatal(res)) {
+				muafInner_AudioHashFinal(&h, hash);
 			}
+			mu_free(block);
+			mu_close_WAVE_reader(reader);
+			return res;
 		}
 
-		// Returns audio format sample size
-		MUDEF size_m muaf_audio_format_sample_size(muafAudioFormat format) {
-			// Perform based on format
-			switch (format) {
-				// Unknown
-				default: return 0; break;
+		// Hashes FLAC audio data
+		MUDEF muafResult mu_hash_FLAC_audio(const char* filename, muFLACProfile* profile, uint32_m segment_len, uint64_m* hash, uint64_m* segment_hashes) {
+			// Canonical sample size
+			uint8_m bps = profile->bits_per_sample;
+			uint8_m sample_size = (bps + 7) / 8;
+			if (sample_size == 0 || sample_size > 4) {
+				return MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT;
+			}
+			int64_m scale = ((int64_m)1) << ((sample_size * 8) - bps);
 
-				// PCM
-				case MUAF_FORMAT_PCM_U8:  case MUAF_FORMAT_PCM_S8:  return 1; break;
-				case MUAF_FORMAT_PCM_S16: return 2; break;
-				case MUAF_FORMAT_PCM_S24: case MUAF_FORMAT_PCM_S32: return 4; break;
-				case MUAF_FORMAT_PCM_S64: return 8; break;
+			// Open file
+			muafInner_File src;
+			if (muafInner_LoadFile(filename, &src) != 0) {
+				return MUAF_FAILED_OPEN_FILE;
+			}
+
+			// Allocate decoder and canonical data for a block
+			muafFLAC_Decoder d;
+			d.profile = profile;
+			muafResult res = muafFLAC_InitBitReader(&d.r, &src, muafFLAC_AudioIndex(profile));
+			if (muaf_result_is_fatal(res)) {
+				muafInner_DeloadFile(&src);
+				return res;
+			}
+			size_m block_samples = ((size_m)profile->max_block_size) * profile->num_channels;
+			d.samples = (int64_m*)mu_malloc((sizeof(int64_m) * block_samples) + (block_samples * sample_size));
+			if (!d.samples) {
+				muafFLAC_FreeBitReader(&d.r);
+				muafInner_DeloadFile(&src);
+				return MUAF_FAILED_MALLOC;
 			}
+			muByte* out = (muByte*)(d.samples + block_samples);
+			muafFLAC_CRC16Table(d.crc16);
+
+			// Decode and hash each frame
+			muafInner_AudioHash h;
+			muafInner_AudioHashInit(&h, ((size_m)profile->num_channels) * sample_size, segment_len, segment_hashes);
+			uint64_m frames = 0;
+			while (frames < profile->num_samples) {
+				uint32_m n;
+				res = muafFLAC_DecodeFrame(&d, &n);
+				if (muaf_result_is_fatal(res)) {
+					break;
+				}
+				if (n > profile->num_samples - frames) {
+					res = MUAF_INVALID_FLAC_FRAME;
+					break;
+				}
+
+				// Interleave into canonical form
+				for (uint32_m f = 0; f < n; ++f) {
+					for (uint8_m ch = 0; ch < profile->num_channels; ++ch) {
+						uint64_m sample = (uint64_m)(d.samples[(((size_m)ch) * profile->max_block_size) + f] * scale);
+						muByte* b = out + (((((size_m)f) * profile->num_channels) + ch) * sample_size);
+						for (uint8_m i = 0; i < sample_size; ++i) {
+							b[i] = (muByte)(sample >> (i * 8));
+						}
+					}
+				}
+				muafInner_AudioHashUpdate(&h, out, n);
+				frames += n;
+			}
+
+			if (!muaf_result_is_fatal(res)) {
+				muafInner_AudioHashFinal(&h, hash);
+			}
+			mu_free(d.samples);
+			muafFLAC_FreeBitReader(&d.r);
+			muafInner_DeloadFile(&src);
+			return res;
 		}
 
 	/* Names */
@@ -2715,6 +10491,23 @@ Overall, muaf is okay with files not strictly complying with the specification w
 			}
 		}
 
+		#ifdef MUAF_INSTRUMENTATION
+		MUDEF const char* muaf_phase_get_name(muafPhase phase) {
+			switch (phase) {
+				default: return "MUAF_PHASE_UNKNOWN"; break;
+				case MUAF_PHASE_OPEN: return "MUAF_PHASE_OPEN"; break;
+				case MUAF_PHASE_READ: return "MUAF_PHASE_READ"; break;
+				case MUAF_PHASE_WRITE: return "MUAF_PHASE_WRITE"; break;
+				case MUAF_PHASE_WAVE_CHUNKS: return "MUAF_PHASE_WAVE_CHUNKS"; break;
+				case MUAF_PHASE_WAVE_FMT: return "MUAF_PHASE_WAVE_FMT"; break;
+				case MUAF_PHASE_WAVE_READ_PCM: return "MUAF_PHASE_WAVE_READ_PCM"; break;
+				case MUAF_PHASE_WAVE_WRITE_PCM: return "MUAF_PHASE_WAVE_WRITE_PCM"; break;
+				case MUAF_PHASE_FLAC_STREAMINFO: return "MUAF_PHASE_FLAC_STREAMINFO"; break;
+				case MUAF_PHASE_FLAC_METADATA: return "MUAF_PHASE_FLAC_METADATA"; break;
+			}
+		}
+		#endif
+
 		MUDEF const char* muaf_audio_format_get_name(muafAudioFormat format) {
 			switch (format) {
 				default: return "MUAF_FORMAT_UNKNOWN"; break;
@@ -2749,6 +10542,11 @@ Overall, muaf is okay with files not strictly complying with the specification w
 				case MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT: return "MUAF_FAILED_UNSUPPORTED_AUDIO_FORMAT"; break;
 				case MUAF_FAILED_CREATE_FILE: return "MUAF_FAILED_CREATE_FILE"; break;
 				case MUAF_FAILED_REALLOC: return "MUAF_FAILED_REALLOC"; break;
+				case MUAF_FAILED_READ_FILE: return "MUAF_FAILED_READ_FILE"; break;
+				case MUAF_FAILED_WRITE_FILE: return "MUAF_FAILED_WRITE_FILE"; break;
+				case MUAF_INVALID_RESAMPLE_RATE: return "MUAF_INVALID_RESAMPLE_RATE"; break;
+				case MUAF_INVALID_PEAKS_BIN_SIZE: return "MUAF_INVALID_PEAKS_BIN_SIZE"; break;
+				case MUAF_INVALID_PEAKS_FILE: return "MUAF_INVALID_PEAKS_FILE"; break;
 				case MUAF_INVALID_WAVE_CHUNK_LENGTH_FOR_FILE: return "MUAF_INVALID_WAVE_CHUNK_LENGTH_FOR_FILE"; break;
 				case MUAF_INVALID_WAVE_MISSING_FMT: return "MUAF_INVALID_WAVE_MISSING_FMT"; break;
 				case MUAF_INVALID_WAVE_MISSING_WAVE_DATA: return "MUAF_INVALID_WAVE_MISSING_WAVE_DATA"; break;
@@ -2757,6 +10555,9 @@ Overall, muaf is okay with files not strictly complying with the specification w
 				case MUAF_INVALID_WAVE_FMT_CHANNELS: return "MUAF_INVALID_WAVE_FMT_CHANNELS"; break;
 				case MUAF_INVALID_WAVE_FMT_SAMPLES_PER_SEC: return "MUAF_INVALID_WAVE_FMT_SAMPLES_PER_SEC"; break;
 				case MUAF_INVALID_WAVE_FILE_WRITE_SIZE: return "MUAF_INVALID_WAVE_FILE_WRITE_SIZE"; break;
+				case MUAF_INVALID_WAVE_CONVERSION_CHANNEL: return "MUAF_INVALID_WAVE_CONVERSION_CHANNEL"; break;
+				case MUAF_INVALID_WAVE_SPLICE_FORMAT: return "MUAF_INVALID_WAVE_SPLICE_FORMAT"; break;
+				case MUAF_INVALID_WAVE_STREAM_DEPTH: return "MUAF_INVALID_WAVE_STREAM_DEPTH"; break;
 				case MUAF_INVALID_FLAC_STREAMINFO_LENGTH: return "MUAF_INVALID_FLAC_STREAMINFO_LENGTH"; break;
 				case MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_RANGE: return "MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_RANGE"; break;
 				case MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_MIN_MAX: return "MUAF_INVALID_FLAC_STREAMINFO_BLOCK_SIZE_MIN_MAX"; break;
@@ -2768,6 +10569,8 @@ Overall, muaf is okay with files not strictly complying with the specification w
 				case MUAF_INVALID_FLAC_DUPLICATE_STREAMINFO: return "MUAF_INVALID_FLAC_DUPLICATE_STREAMINFO"; break;
 				case MUAF_INVALID_FLAC_DUPLICATE_SEEK_TABLE: return "MUAF_INVALID_FLAC_DUPLICATE_SEEK_TABLE"; break;
 				case MUAF_INVALID_FLAC_DUPLICATE_VORBIS_COMMENT: return "MUAF_INVALID_FLAC_DUPLICATE_VORBIS_COMMENT"; break;
+				case MUAF_INVALID_FLAC_FRAME: return "MUAF_INVALID_FLAC_FRAME"; break;
+				case MUAF_INVALID_FLAC_CHECKSUM: return "MUAF_INVALID_FLAC_CHECKSUM"; break;
 			}
 		}
 